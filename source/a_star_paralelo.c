@@ -0,0 +1,327 @@
+/*
+ * a_star_paralelo.c - A* distribuído entre threads (HDA*)
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/a_star_paralelo.h"
+#include "include/busca.h"
+#include "include/cronologia.h"
+#include "include/fila.h"
+#include "include/heap.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define TAMANHO_LOTE 64
+#define EXPANSOES_POR_RODADA 32
+#define ESPERAS_ATIVAS 64
+
+// Células do mesmo bloco têm o mesmo dono, o que corta boa parte das mensagens
+#define LADO_BLOCO 8
+
+typedef struct {
+  int indice;
+  int peso;
+  int pai;
+} Mensagem;
+
+typedef struct {
+  NoFila no;
+  int quantidade;
+  Mensagem mensagens[TAMANHO_LOTE];
+} Lote;
+
+typedef struct BuscaParalela BuscaParalela;
+
+typedef struct {
+  BuscaParalela *busca;
+  pthread_t thread;
+  int id;
+  Heap abertos;
+  FilaMPSC fila;
+  Lote **saida;
+} Trabalhador;
+
+struct BuscaParalela {
+  const Labirinto *labirinto;
+  int penalidade;
+  int alvo;
+  int threads;
+  int *pesos;
+  int *pais;
+  Trabalhador *trabalhadores;
+  atomic_int incumbente;
+  atomic_long trabalho;
+};
+
+static int dono(const BuscaParalela *busca, int indice) {
+  const int colunas = busca->labirinto->tamanho[1];
+  uint32_t bloco    = (indice / colunas / LADO_BLOCO) * ((colunas + LADO_BLOCO - 1) / LADO_BLOCO) + indice % colunas / LADO_BLOCO;
+
+  bloco ^= bloco >> 16;
+  bloco *= 0x7feb352dU;
+  bloco ^= bloco >> 15;
+  bloco *= 0x846ca68bU;
+  bloco ^= bloco >> 16;
+
+  return bloco % busca->threads;
+}
+
+static int heuristica(const BuscaParalela *busca, int indice) {
+  return estimar_ate_alvo(busca->labirinto, indice, busca->alvo);
+}
+
+/**
+ * Só o dono de uma célula chama essa função, então `pesos` e `pais` nunca são
+ * escritos por duas threads ao mesmo tempo.
+ */
+static void receber(Trabalhador *trabalhador, Mensagem mensagem) {
+  BuscaParalela *busca = trabalhador->busca;
+
+  if (mensagem.peso >= busca->pesos[mensagem.indice]) {
+    return;
+  }
+
+  busca->pesos[mensagem.indice] = mensagem.peso;
+  busca->pais[mensagem.indice]  = mensagem.pai;
+
+  if (chegou_ao_alvo(busca->labirinto, mensagem.indice, busca->alvo)) {
+    int atual = atomic_load_explicit(&busca->incumbente, memory_order_relaxed);
+    while (mensagem.peso < atual && !atomic_compare_exchange_weak(&busca->incumbente, &atual, mensagem.peso)) {
+    }
+    return;
+  }
+
+  ItemHeap item = { .custo = mensagem.peso + heuristica(busca, mensagem.indice), .peso = mensagem.peso, .indice = mensagem.indice };
+  inserir_heap(&trabalhador->abertos, item);
+}
+
+static void enviar_lote(Trabalhador *trabalhador, int destino) {
+  Lote *lote = trabalhador->saida[destino];
+
+  if (lote == NULL || lote->quantidade == 0) {
+    return;
+  }
+
+  // O lote conta como trabalho pendente até o destinatário processá-lo
+  atomic_fetch_add(&trabalhador->busca->trabalho, 1);
+  inserir_fila(&trabalhador->busca->trabalhadores[destino].fila, &lote->no);
+  trabalhador->saida[destino] = NULL;
+}
+
+static void enviar(Trabalhador *trabalhador, int destino, Mensagem mensagem) {
+  if (destino == trabalhador->id) {
+    receber(trabalhador, mensagem);
+    return;
+  }
+
+  if (trabalhador->saida[destino] == NULL) {
+    trabalhador->saida[destino] = malloc(sizeof(Lote));
+    if (trabalhador->saida[destino] == NULL) {
+      erro(L"Falha ao alocar memória para as mensagens.");
+    }
+    trabalhador->saida[destino]->quantidade = 0;
+  }
+
+  Lote *lote                          = trabalhador->saida[destino];
+  lote->mensagens[lote->quantidade++] = mensagem;
+
+  if (lote->quantidade == TAMANHO_LOTE) {
+    enviar_lote(trabalhador, destino);
+  }
+}
+
+static void expandir(Trabalhador *trabalhador, ItemHeap topo) {
+  BuscaParalela *busca = trabalhador->busca;
+  const int colunas    = busca->labirinto->tamanho[1];
+  const int linha      = topo.indice / colunas;
+  const int coluna     = topo.indice % colunas;
+  const int incumbente = atomic_load_explicit(&busca->incumbente, memory_order_relaxed);
+
+  for (int i = 0; i < direcoes_do_labirinto(busca->labirinto); ++i) {
+    int adjacente[2];
+
+    if (!vizinha_na_direcao(busca->labirinto, linha, coluna, i, adjacente)) {
+      continue;
+    }
+
+    const int passo  = custo_passo(busca->labirinto->matriz_inicial[adjacente[0]][adjacente[1]], busca->penalidade);
+    const int indice = adjacente[0] * colunas + adjacente[1];
+
+    if (passo < 0 || topo.peso + passo + heuristica(busca, indice) >= incumbente) {
+      continue;
+    }
+
+    enviar(trabalhador, dono(busca, indice), (Mensagem){ .indice = indice, .peso = topo.peso + passo, .pai = topo.indice });
+  }
+}
+
+/**
+ * O contador `trabalho` soma as threads ativas e os lotes em trânsito. Ele só
+ * sobe por uma thread ativa ou por quem está segurando um lote, então quando
+ * chega a zero não há mais nada a fazer em lugar nenhum e a busca termina.
+ */
+static void *trabalhar(void *argumento) {
+  TRECHO("busca_paralela");
+  Trabalhador *trabalhador = argumento;
+  BuscaParalela *busca     = trabalhador->busca;
+  int ativo                = 1;
+  int ociosas              = 0;
+
+  while (1) {
+    NoFila *no;
+    while ((no = remover_fila(&trabalhador->fila)) != NULL) {
+      if (!ativo) {
+        atomic_fetch_add(&busca->trabalho, 1);
+        ativo = 1;
+      }
+
+      Lote *lote = (Lote *)no;
+      for (int i = 0; i < lote->quantidade; ++i) {
+        receber(trabalhador, lote->mensagens[i]);
+      }
+      free(lote);
+      atomic_fetch_sub(&busca->trabalho, 1);
+    }
+
+    for (int expansoes = 0; expansoes < EXPANSOES_POR_RODADA && trabalhador->abertos.tamanho > 0; ++expansoes) {
+      ItemHeap topo = remover_heap(&trabalhador->abertos);
+
+      // Nada nessa lista pode melhorar a solução que já temos
+      if (topo.custo >= atomic_load_explicit(&busca->incumbente, memory_order_relaxed)) {
+        trabalhador->abertos.tamanho = 0;
+        break;
+      }
+
+      if (topo.peso <= busca->pesos[topo.indice]) {
+        expandir(trabalhador, topo);
+      }
+    }
+
+    for (int i = 0; i < busca->threads; ++i) {
+      enviar_lote(trabalhador, i);
+    }
+
+    if (trabalhador->abertos.tamanho > 0) {
+      ociosas = 0;
+      continue;
+    }
+
+    if (ativo) {
+      ativo = 0;
+      atomic_fetch_sub(&busca->trabalho, 1);
+    }
+
+    if (atomic_load(&busca->trabalho) == 0) {
+      break;
+    }
+
+    // Ociosa há muito tempo, dorme um pouco para não roubar o processador de quem tem trabalho
+    if (++ociosas < ESPERAS_ATIVAS) {
+      sched_yield();
+    } else {
+      pausar(0.0001);
+    }
+  }
+
+  return NULL;
+}
+
+int buscar_a_star_paralelo(const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, int threads, Caminho *caminho) {
+  const int colunas = labirinto->tamanho[1];
+  const int total   = labirinto->tamanho[0] * colunas;
+  const int inicio  = origem[0] * colunas + origem[1];
+
+  BuscaParalela busca = { .labirinto     = labirinto,
+                          .penalidade    = penalidade,
+                          .alvo          = alvo_da_busca(labirinto, destino),
+                          .threads       = max(1, threads),
+                          .pesos         = malloc(total * sizeof(int)),
+                          .pais          = malloc(total * sizeof(int)),
+                          .trabalhadores = calloc(max(1, threads), sizeof(Trabalhador)) };
+
+  if (busca.pesos == NULL || busca.pais == NULL || busca.trabalhadores == NULL) {
+    erro(L"Falha ao alocar memória para o A* paralelo.");
+  }
+
+  for (int i = 0; i < total; ++i) {
+    busca.pesos[i] = INT_MAX;
+  }
+
+  atomic_init(&busca.incumbente, INT_MAX);
+  atomic_init(&busca.trabalho, busca.threads);
+
+  for (int i = 0; i < busca.threads; ++i) {
+    Trabalhador *trabalhador = &busca.trabalhadores[i];
+    trabalhador->busca       = &busca;
+    trabalhador->id          = i;
+    trabalhador->saida       = calloc(busca.threads, sizeof(Lote *));
+
+    if (trabalhador->saida == NULL) {
+      erro(L"Falha ao alocar memória para o A* paralelo.");
+    }
+
+    criar_heap(&trabalhador->abertos, total / busca.threads / 8);
+    criar_fila(&trabalhador->fila);
+  }
+
+  busca.pesos[inicio] = 0;
+  busca.pais[inicio]  = inicio;
+  if (chegou_ao_alvo(labirinto, inicio, busca.alvo)) {
+    atomic_store(&busca.incumbente, 0);
+  } else {
+    ItemHeap item = { .custo = heuristica(&busca, inicio), .peso = 0, .indice = inicio };
+    inserir_heap(&busca.trabalhadores[dono(&busca, inicio)].abertos, item);
+  }
+
+  for (int i = 0; i < busca.threads; ++i) {
+    if (pthread_create(&busca.trabalhadores[i].thread, NULL, trabalhar, &busca.trabalhadores[i]) != 0) {
+      erro(L"Falha ao criar as threads do A* paralelo.");
+    }
+  }
+
+  for (int i = 0; i < busca.threads; ++i) {
+    pthread_join(busca.trabalhadores[i].thread, NULL);
+    liberar_heap(&busca.trabalhadores[i].abertos);
+    free(busca.trabalhadores[i].saida);
+  }
+
+  int custo = atomic_load(&busca.incumbente);
+  custo     = custo == INT_MAX ? -1 : custo;
+
+  // Com várias saídas, o caminho termina na que tem o custo da solução
+  int chegada = busca.alvo;
+  for (int i = 0; custo >= 0 && chegada < 0 && i < labirinto->quantidade_saidas; ++i) {
+    const int saida = labirinto->saidas[i][0] * colunas + labirinto->saidas[i][1];
+    chegada         = busca.pesos[saida] == custo ? saida : -1;
+  }
+
+  if (custo >= 0 && caminho) {
+    reconstruir_por_pais(labirinto, busca.pais, inicio, chegada, penalidade, caminho);
+  }
+
+  free(busca.trabalhadores);
+  free(busca.pesos);
+  free(busca.pais);
+  return custo;
+}
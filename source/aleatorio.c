@@ -0,0 +1,67 @@
+/*
+ * aleatorio.c - Gerador de números aleatórios xoshiro256**
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/aleatorio.h"
+
+// splitmix64, usado só para espalhar a semente pelos 256 bits do estado
+static uint64_t espalhar(uint64_t *x) {
+  uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+  z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+void semear_gerador(Gerador *gerador, uint64_t semente, uint64_t fluxo) {
+  uint64_t x = semente ^ espalhar(&fluxo);
+
+  for (int i = 0; i < 4; ++i) {
+    gerador->estado[i] = espalhar(&x);
+  }
+}
+
+uint64_t proximo_aleatorio(Gerador *gerador) {
+  uint64_t *s          = gerador->estado;
+  const uint64_t saida = rotacionar(s[1] * 5, 7) * 9;
+  const uint64_t t     = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotacionar(s[3], 45);
+
+  return saida;
+}
+
+uint32_t sortear(Gerador *gerador, uint32_t limite) {
+  // Multiplicação de Lemire: rejeita só a fatia que causaria viés
+  uint64_t produto = (proximo_aleatorio(gerador) >> 32) * limite;
+
+  if ((uint32_t)produto < limite) {
+    const uint32_t minimo = -limite % limite;
+    while ((uint32_t)produto < minimo) {
+      produto = (proximo_aleatorio(gerador) >> 32) * limite;
+    }
+  }
+
+  return produto >> 32;
+}
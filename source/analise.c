@@ -0,0 +1,163 @@
+/*
+ * analise.c - Análise estrutural do labirinto com union-find
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/analise.h"
+#include "include/gargalos.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int encontrar(int *pais, int celula) {
+  // Cada célula visitada passa a apontar para o avô, o que achata a árvore
+  while (pais[celula] != celula) {
+    pais[celula] = pais[pais[celula]];
+    celula       = pais[celula];
+  }
+  return celula;
+}
+
+/**
+ * Une os conjuntos de duas células, pendurando o menor no maior.
+ *
+ * @return Boolean, falso se elas já estavam no mesmo conjunto (a aresta fecha um ciclo).
+ */
+static int unir(int *pais, int *tamanhos, int a, int b) {
+  a = encontrar(pais, a);
+  b = encontrar(pais, b);
+  if (a == b) {
+    return 0;
+  }
+
+  if (tamanhos[a] < tamanhos[b]) {
+    const int troca = a;
+    a               = b;
+    b               = troca;
+  }
+  pais[b] = a;
+  tamanhos[a] += tamanhos[b];
+  return 1;
+}
+
+void analisar_labirinto(AnaliseLabirinto *analise, const Labirinto *labirinto) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+  char **matriz     = labirinto->matriz_inicial;
+
+  int *pais     = malloc((size_t)linhas * colunas * sizeof(int));
+  int *tamanhos = malloc((size_t)linhas * colunas * sizeof(int));
+  if (pais == NULL || tamanhos == NULL) {
+    erro(L"Falha ao alocar memória para a análise.");
+  }
+
+  memset(analise, 0, sizeof(AnaliseLabirinto));
+
+  for (int classe = 0; classe < QUANTIDADE_CLASSES; ++classe) {
+    int arestas = 0;
+
+    for (int i = 0; i < linhas; ++i) {
+      for (int j = 0; j < colunas; ++j) {
+        const int celula = i * colunas + j;
+        pais[celula]     = celula;
+        tamanhos[celula] = 1;
+
+        if (!passavel(matriz[i][j], classe)) {
+          continue;
+        }
+
+        analise->celulas[classe]++;
+        analise->componentes[classe]++;
+
+        int vizinhos = 0;
+        for (int d = 0; d < direcoes_do_labirinto(labirinto); ++d) {
+          int vizinha[2];
+          vizinhos += vizinha_na_direcao(labirinto, i, j, d, vizinha) && passavel(matriz[vizinha[0]][vizinha[1]], classe);
+        }
+        analise->becos[classe] += vizinhos == 1;
+        analise->juncoes[classe] += vizinhos >= 3;
+
+        // Só as vizinhas de cima, da esquerda e do andar anterior já foram
+        // inicializadas
+        if (i > 0 && passavel(matriz[i - 1][j], classe)) {
+          arestas++;
+          analise->componentes[classe] -= unir(pais, tamanhos, celula, celula - colunas);
+        }
+        if (j > 0 && passavel(matriz[i][j - 1], classe)) {
+          arestas++;
+          analise->componentes[classe] -= unir(pais, tamanhos, celula, celula - 1);
+        }
+
+        int abaixo[2];
+        if (labirinto->andares > 1 && vizinha_na_direcao(labirinto, i, j, DESCER, abaixo) && passavel(matriz[abaixo[0]][abaixo[1]], classe)) {
+          arestas++;
+          analise->componentes[classe] -= unir(pais, tamanhos, celula, abaixo[0] * colunas + abaixo[1]);
+        }
+      }
+    }
+
+    const int *inicio = labirinto->jogador.posicao_inicial;
+    const int jogador = encontrar(pais, inicio[0] * colunas + inicio[1]);
+
+    // Basta uma saída na componente do jogador
+    analise->ciclos[classe] = arestas - analise->celulas[classe] + analise->componentes[classe];
+    for (int i = 0; passavel(matriz[inicio[0]][inicio[1]], classe) && i < labirinto->quantidade_saidas; ++i) {
+      const int *saida = labirinto->saidas[i];
+      analise->saida_alcancavel[classe] |= encontrar(pais, saida[0] * colunas + saida[1]) == jogador;
+    }
+  }
+
+  free(pais);
+  free(tamanhos);
+}
+
+void analisar_gargalos(AnaliseLabirinto *analise, const Labirinto *labirinto) {
+  const int *inicio = labirinto->jogador.posicao_inicial;
+
+  for (int classe = 0; classe < QUANTIDADE_CLASSES; ++classe) {
+    if (!passavel(labirinto->matriz_inicial[inicio[0]][inicio[1]], classe)) {
+      continue;
+    }
+
+    Gargalos gargalos;
+    encontrar_gargalos(&gargalos, labirinto, classe, (int *)inicio);
+    analise->articulacoes[classe] = gargalos.quantidade_articulacoes;
+    analise->pontes[classe]       = gargalos.quantidade_pontes;
+    analise->obrigatorias[classe] = gargalos.quantidade_obrigatorias;
+    liberar_gargalos(&gargalos);
+  }
+}
+
+void imprimir_analise(const AnaliseLabirinto *analise) {
+  const struct {
+    const wchar_t *nome;
+    const int *valores;
+  } linhas[] = { { L"Células passáveis", analise->celulas }, { L"Componentes", analise->componentes }, { L"Becos", analise->becos },
+                 { L"Junções", analise->juncoes },           { L"Ciclos", analise->ciclos },
+                 { L"Articulações", analise->articulacoes }, { L"Pontes", analise->pontes },
+                 { L"Células obrigatórias", analise->obrigatorias } };
+
+  wprintf(L"%-20ls %14ls %14ls\n", L"Análise", L"sem inimigos", L"com inimigos");
+  for (int i = 0; i < (int)(sizeof linhas / sizeof linhas[0]); ++i) {
+    wprintf(L"%-20ls %14d %14d\n", linhas[i].nome, linhas[i].valores[CLASSE_SEM_INIMIGOS], linhas[i].valores[CLASSE_COM_INIMIGOS]);
+  }
+  wprintf(L"%-20ls %14ls %14ls\n", L"Saída alcançável", analise->saida_alcancavel[CLASSE_SEM_INIMIGOS] ? L"sim" : L"não",
+          analise->saida_alcancavel[CLASSE_COM_INIMIGOS] ? L"sim" : L"não");
+}
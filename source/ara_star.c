@@ -0,0 +1,253 @@
+/*
+ * ara_star.c - A* com prazo que melhora o caminho aos poucos (ARA*)
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/ara_star.h"
+#include "include/busca.h"
+#include "include/heap.h"
+#include "include/os.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+// As chaves da heap são inteiras, então o epsilon vira um número de milésimos
+#define ESCALA 1000
+#define EXPANSOES_ENTRE_RELOGIOS 1024
+
+typedef struct {
+  const Labirinto *labirinto;
+  int penalidade;
+  int alvo;
+  int chegada;
+  long long epsilon;
+  int iteracao;
+  int *pesos;
+  int *pais;
+  int *fechado;
+  int *inconsistente;
+  int *marcado;
+  int *inconsistentes;
+  int quantidade_inconsistentes;
+  Heap abertos;
+} EstadoARA;
+
+static int heuristica(const EstadoARA *estado, int indice) {
+  return estimar_ate_alvo(estado->labirinto, indice, estado->alvo);
+}
+
+static void abrir(EstadoARA *estado, Heap *heap, int indice) {
+  const int peso = estado->pesos[indice];
+  ItemHeap item  = { .custo = (long long)peso * ESCALA + estado->epsilon * heuristica(estado, indice), .peso = peso, .indice = indice };
+  inserir_heap(heap, item);
+}
+
+// Entradas antigas ficam na heap; só vale a que tem o peso atual da célula
+static int atual(const EstadoARA *estado, ItemHeap item) {
+  return item.peso == estado->pesos[item.indice] && estado->fechado[item.indice] != estado->iteracao;
+}
+
+/**
+ * Expande os nós com chave menor que a do destino. Células que melhoram
+ * depois de fechadas vão para a lista de inconsistentes, e só voltam para a
+ * lista aberta na próxima iteração, com um epsilon menor.
+ *
+ * @return 0 se o prazo acabou no meio, 1 caso contrário.
+ */
+static int melhorar_caminho(EstadoARA *estado, double limite_tempo, int tem_solucao) {
+  const Labirinto *labirinto = estado->labirinto;
+  const int colunas          = labirinto->tamanho[1];
+  const int direcoes         = direcoes_do_labirinto(labirinto);
+  int expansoes              = 0;
+
+  while (estado->abertos.tamanho > 0) {
+    ItemHeap topo = estado->abertos.itens[0];
+
+    if (!atual(estado, topo)) {
+      remover_heap(&estado->abertos);
+      continue;
+    }
+
+    if (estado->chegada >= 0 && topo.custo >= (long long)estado->pesos[estado->chegada] * ESCALA) {
+      break;
+    }
+
+    if (tem_solucao && ++expansoes % EXPANSOES_ENTRE_RELOGIOS == 0 && tempo_monotonico() > limite_tempo) {
+      return 0;
+    }
+
+    remover_heap(&estado->abertos);
+    estado->fechado[topo.indice] = estado->iteracao;
+
+    const int linha = topo.indice / colunas, coluna = topo.indice % colunas;
+
+    for (int i = 0; i < direcoes; ++i) {
+      int adjacente[2];
+
+      if (!vizinha_na_direcao(labirinto, linha, coluna, i, adjacente)) {
+        continue;
+      }
+
+      const int passo  = custo_passo(labirinto->matriz_inicial[adjacente[0]][adjacente[1]], estado->penalidade);
+      const int indice = adjacente[0] * colunas + adjacente[1];
+
+      if (passo < 0 || topo.peso + passo >= estado->pesos[indice]) {
+        continue;
+      }
+
+      estado->pesos[indice] = topo.peso + passo;
+      estado->pais[indice]  = topo.indice;
+
+      // Com várias saídas, a solução é a saída mais barata encontrada até aqui
+      if (chegou_ao_alvo(labirinto, indice, estado->alvo) &&
+          (estado->chegada < 0 || estado->pesos[indice] < estado->pesos[estado->chegada])) {
+        estado->chegada = indice;
+      }
+
+      if (estado->fechado[indice] != estado->iteracao) {
+        abrir(estado, &estado->abertos, indice);
+      } else if (estado->inconsistente[indice] != estado->iteracao) {
+        estado->inconsistente[indice]                               = estado->iteracao;
+        estado->inconsistentes[estado->quantidade_inconsistentes++] = indice;
+      }
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * O custo ótimo é pelo menos o menor g + h entre os nós abertos e
+ * inconsistentes, o que limita o quão longe do ótimo o caminho atual está.
+ */
+static double calcular_limite(const EstadoARA *estado) {
+  long long minimo = LLONG_MAX;
+
+  for (int i = 0; i < estado->abertos.tamanho; ++i) {
+    ItemHeap item = estado->abertos.itens[i];
+    if (atual(estado, item)) {
+      minimo = min(minimo, (long long)item.peso + heuristica(estado, item.indice));
+    }
+  }
+
+  for (int i = 0; i < estado->quantidade_inconsistentes; ++i) {
+    const int indice = estado->inconsistentes[i];
+    minimo           = min(minimo, (long long)estado->pesos[indice] + heuristica(estado, indice));
+  }
+
+  const double limite = minimo == LLONG_MAX ? 1.0 : (double)estado->pesos[estado->chegada] / minimo;
+  return max(1.0, min((double)estado->epsilon / ESCALA, limite));
+}
+
+/**
+ * Começa uma nova iteração: junta os abertos e os inconsistentes numa heap
+ * nova, com as chaves recalculadas para o epsilon atual.
+ */
+static void reabrir(EstadoARA *estado) {
+  Heap abertos;
+  criar_heap(&abertos, estado->abertos.tamanho + estado->quantidade_inconsistentes);
+
+  for (int i = 0; i < estado->abertos.tamanho; ++i) {
+    ItemHeap item = estado->abertos.itens[i];
+    if (atual(estado, item) && estado->marcado[item.indice] != estado->iteracao + 1) {
+      estado->marcado[item.indice] = estado->iteracao + 1;
+      abrir(estado, &abertos, item.indice);
+    }
+  }
+
+  for (int i = 0; i < estado->quantidade_inconsistentes; ++i) {
+    const int indice = estado->inconsistentes[i];
+    if (estado->marcado[indice] != estado->iteracao + 1) {
+      estado->marcado[indice] = estado->iteracao + 1;
+      abrir(estado, &abertos, indice);
+    }
+  }
+
+  liberar_heap(&estado->abertos);
+  estado->abertos                   = abertos;
+  estado->quantidade_inconsistentes = 0;
+  estado->iteracao++;
+}
+
+int buscar_ara_star(const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, double epsilon, double prazo,
+                    RelatorARA relatar, void *contexto, Caminho *caminho) {
+  const double inicio = tempo_monotonico();
+  const int total     = labirinto->tamanho[0] * labirinto->tamanho[1];
+  const int colunas   = labirinto->tamanho[1];
+
+  EstadoARA estado = { .labirinto      = labirinto,
+                       .penalidade     = penalidade,
+                       .alvo           = alvo_da_busca(labirinto, destino),
+                       .chegada        = -1,
+                       .epsilon        = (long long)(max(1.0, epsilon) * ESCALA),
+                       .iteracao       = 1,
+                       .pesos          = malloc(total * sizeof(int)),
+                       .pais           = malloc(total * sizeof(int)),
+                       .fechado        = calloc(total, sizeof(int)),
+                       .inconsistente  = calloc(total, sizeof(int)),
+                       .marcado        = calloc(total, sizeof(int)),
+                       .inconsistentes = malloc(total * sizeof(int)) };
+
+  if (!estado.pesos || !estado.pais || !estado.fechado || !estado.inconsistente || !estado.marcado || !estado.inconsistentes) {
+    erro(L"Falha ao alocar memória para o ARA*.");
+  }
+
+  for (int i = 0; i < total; ++i) {
+    estado.pesos[i] = INT_MAX;
+  }
+
+  const int partida     = origem[0] * colunas + origem[1];
+  estado.pesos[partida] = 0;
+  estado.pais[partida]  = partida;
+  estado.chegada        = chegou_ao_alvo(labirinto, partida, estado.alvo) ? partida : -1;
+
+  criar_heap(&estado.abertos, labirinto->tamanho[0] + colunas);
+  abrir(&estado, &estado.abertos, partida);
+
+  int custo = -1;
+
+  while (melhorar_caminho(&estado, inicio + prazo, custo >= 0) && estado.chegada >= 0) {
+    const double limite = calcular_limite(&estado);
+
+    custo = estado.pesos[estado.chegada];
+    liberar_caminho(caminho);
+    reconstruir_por_pais(labirinto, estado.pais, partida, estado.chegada, penalidade, caminho);
+
+    if (relatar) {
+      relatar(caminho, limite, tempo_monotonico() - inicio, contexto);
+    }
+
+    if (limite <= 1.0 || tempo_monotonico() - inicio > prazo) {
+      break;
+    }
+
+    estado.epsilon = max(ESCALA, estado.epsilon - (long long)(PASSO_EPSILON * ESCALA));
+    reabrir(&estado);
+  }
+
+  liberar_heap(&estado.abertos);
+  free(estado.pesos);
+  free(estado.pais);
+  free(estado.fechado);
+  free(estado.inconsistente);
+  free(estado.marcado);
+  free(estado.inconsistentes);
+  return custo;
+}
@@ -0,0 +1,463 @@
+/*
+ * benchmark.c - Medições de desempenho dos resolvedores sem interface
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/a_star_paralelo.h"
+#include "include/ara_star.h"
+#include "include/benchmark.h"
+#include "include/bitmapa.h"
+#include "include/busca.h"
+#include "include/desempenho.h"
+#include "include/dstar_lite.h"
+#include "include/campo.h"
+#include "include/grafo.h"
+#include "include/hierarquia.h"
+#include "include/os.h"
+#include "include/poda.h"
+#include "include/util.h"
+
+#define TEMPO_MINIMO 0.25
+
+typedef int (*Rodada)(Labirinto *labirinto, void *contexto);
+
+// Com --perf, `medir` também guarda a média dos contadores do processador
+// por execução, que `imprimir_resultado` mostra embaixo do tempo
+static Medidor medidor;
+static LeituraHw media_hw;
+static int celulas_labirinto;
+
+/**
+ * Executa a rodada repetidamente até somar TEMPO_MINIMO segundos e retorna o
+ * tempo médio de uma execução. `celulas` recebe o retorno da última rodada.
+ */
+static double medir(Rodada rodada, Labirinto *labirinto, void *contexto, int *celulas) {
+  int execucoes = 0;
+  double inicio = tempo_monotonico(), decorrido;
+  LeituraHw antes, depois;
+
+  ler_medidor(&medidor, &antes);
+
+  do {
+    *celulas = rodada(labirinto, contexto);
+    execucoes++;
+    decorrido = tempo_monotonico() - inicio;
+  } while (decorrido < TEMPO_MINIMO);
+
+  ler_medidor(&medidor, &depois);
+  media_hw = (LeituraHw){ 0 };
+  acumular_leitura(&media_hw, &depois, &antes);
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    media_hw.valores[i] = media_hw.valores[i] < 0 ? -1 : media_hw.valores[i] / execucoes;
+  }
+
+  return decorrido / execucoes;
+}
+
+/**
+ * Mostra a média dos contadores do processador da última medição, divididos
+ * pelos nós visitados quando a rodada os conta, ou pelas células do
+ * labirinto nos resolvedores medidos pelo custo.
+ */
+static void imprimir_hardware(int nos) {
+  const double divisor = nos >= 0 ? max(nos, 1) : celulas_labirinto;
+  const long long *v   = media_hw.valores;
+
+  wprintf(L"  %24ls por %ls:", L"", nos >= 0 ? L"nó" : L"célula");
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    if (v[i] < 0) {
+      wprintf(L"%ls - %ls", i ? L"," : L"", nomes_eventos_hw[i]);
+    } else {
+      wprintf(L"%ls %.2f %ls", i ? L"," : L"", v[i] / divisor, nomes_eventos_hw[i]);
+    }
+  }
+
+  if (v[HW_CICLOS] > 0 && v[HW_INSTRUCOES] >= 0) {
+    wprintf(L", %.2f IPC", (double)v[HW_INSTRUCOES] / v[HW_CICLOS]);
+  }
+  wprintf(L"\n");
+}
+
+/**
+ * Busca em largura célula a célula, do jeito que os resolvedores andam pelo
+ * labirinto hoje: um `encontrar_direcoes` por célula visitada.
+ */
+static int inundar_celula_a_celula(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  const int colunas = labirinto->tamanho[1];
+  const int total   = labirinto->tamanho[0] * colunas;
+
+  int *fila       = malloc(total * 2 * sizeof(int));
+  char *visitados = calloc(total, sizeof(char));
+  int direcoes[6];
+
+  if (fila == NULL || visitados == NULL) {
+    erro(L"Falha ao alocar memória para o benchmark.");
+  }
+
+  int inicio = 0, fim = 0;
+  int *origem = labirinto->jogador.posicao_inicial;
+
+  copiar_matriz(origem, fila, sizeof(int[2]));
+  visitados[origem[0] * colunas + origem[1]] = 1;
+  fim++;
+
+  while (inicio < fim) {
+    int *posicao           = fila + 2 * inicio++;
+    int direcoes_possiveis = encontrar_direcoes(labirinto, ".$", direcoes, posicao);
+
+    for (int i = 0; i < direcoes_possiveis; ++i) {
+      int adjacente[2] = { posicao[0], posicao[1] };
+      avancar_posicao(labirinto, adjacente, direcoes[i]);
+
+      if (!visitados[adjacente[0] * colunas + adjacente[1]]) {
+        visitados[adjacente[0] * colunas + adjacente[1]] = 1;
+        copiar_matriz(adjacente, fila + 2 * fim++, sizeof(int[2]));
+      }
+    }
+  }
+
+  free(fila);
+  free(visitados);
+  return fim;
+}
+
+static int inundar_bitparalelo(Labirinto *labirinto, void *contexto) {
+  return contar_alcancaveis_bitparalelo(contexto, labirinto->jogador.posicao_inicial);
+}
+
+static int a_star_sequencial(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  return buscar_a_star(labirinto, labirinto->jogador.posicao_inicial, labirinto->posicao_saida, PENALIDADE_INIMIGO, NULL);
+}
+
+static int a_star_sem_inimigos(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  return buscar_a_star(labirinto, labirinto->jogador.posicao_inicial, labirinto->posicao_saida, SEM_INIMIGOS, NULL);
+}
+
+static int a_star_paralelo(Labirinto *labirinto, void *contexto) {
+  const Opcoes *opcoes = contexto;
+  return buscar_a_star_paralelo(labirinto, labirinto->jogador.posicao_inicial, labirinto->posicao_saida, PENALIDADE_INIMIGO,
+                                opcoes->threads, NULL);
+}
+
+static int construir_campo(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  CampoDistancia campo;
+  calcular_campo(&campo, labirinto, PENALIDADE_INIMIGO);
+  liberar_campo(&campo);
+  return -1;
+}
+
+static int consultar_campo_saida(Labirinto *labirinto, void *contexto) {
+  Caminho caminho = { 0 };
+  consultar_campo(contexto, labirinto->jogador.posicao_inicial, &caminho);
+  liberar_caminho(&caminho);
+  return caminho.custo;
+}
+
+static int construir_grafo_juncoes(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  GrafoJuncoes grafo;
+  construir_grafo(&grafo, labirinto, PENALIDADE_INIMIGO);
+  liberar_grafo(&grafo);
+  return -1;
+}
+
+static int a_star_juncoes(Labirinto *labirinto, void *contexto) {
+  return buscar_no_grafo(contexto, labirinto, labirinto->jogador.posicao_inicial, NULL);
+}
+
+/**
+ * Busca em profundidade na mesma ordem de direções de `resolver_diretamente`,
+ * contando quantas vezes ela precisa retroceder até achar a saída. Células
+ * fora da máscara são tratadas como paredes.
+ */
+static int construir_hierarquia_hpa(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  Hierarquia hierarquia;
+  construir_hierarquia(&hierarquia, labirinto, PENALIDADE_INIMIGO);
+  liberar_hierarquia(&hierarquia);
+  return -1;
+}
+
+static int atualizar_hierarquia(Labirinto *labirinto, void *contexto) {
+  atualizar_agrupamento(contexto, labirinto, labirinto->posicao_saida);
+  return -1;
+}
+
+static int busca_hierarquica(Labirinto *labirinto, void *contexto) {
+  return buscar_hierarquico(contexto, labirinto, labirinto->jogador.posicao_inicial, NULL);
+}
+
+typedef struct {
+  DStarLite planejador;
+  int posicao[2];
+  int bloqueada;
+  int rodadas;
+} AlternanciaDStar;
+
+static int planejar_dstar_lite(Labirinto *labirinto, void *contexto) {
+  (void)contexto;
+  DStarLite planejador;
+  iniciar_dstar_lite(&planejador, labirinto, labirinto->jogador.posicao_inicial, PENALIDADE_INIMIGO);
+  const int custo = replanejar(&planejador, NULL);
+  liberar_dstar_lite(&planejador);
+  return custo;
+}
+
+/**
+ * Coloca ou tira uma parede numa célula do caminho e replaneja, alternando a
+ * cada rodada. Num corredor sem alternativa é o pior caso do D* Lite: tudo o
+ * que estava atrás da parede precisa ser refeito.
+ */
+static int replanejar_dstar_lite(Labirinto *labirinto, void *contexto) {
+  AlternanciaDStar *alternancia = contexto;
+  const int *posicao            = alternancia->posicao;
+  const char celula             = alternancia->bloqueada ? labirinto->matriz_inicial[posicao[0]][posicao[1]] : PAREDE;
+
+  alternancia->bloqueada = !alternancia->bloqueada;
+  alternancia->rodadas++;
+  marcar_celula_alterada(&alternancia->planejador, alternancia->posicao, celula);
+  return replanejar(&alternancia->planejador, NULL);
+}
+
+static int contar_retrocessos(const Labirinto *labirinto, const uint8_t *mascara) {
+  const int colunas = labirinto->tamanho[1];
+  const int total   = labirinto->tamanho[0] * colunas;
+  const int saida   = labirinto->posicao_saida[0] * colunas + labirinto->posicao_saida[1];
+
+  int *pilha      = malloc(total * sizeof(int));
+  char *visitados = calloc(total, sizeof(char));
+
+  if (pilha == NULL || visitados == NULL) {
+    erro(L"Falha ao alocar memória para o benchmark.");
+  }
+
+  int tamanho = 0, retrocessos = 0;
+
+  pilha[tamanho++]    = labirinto->jogador.posicao_inicial[0] * colunas + labirinto->jogador.posicao_inicial[1];
+  visitados[pilha[0]] = 1;
+
+  while (tamanho > 0 && pilha[tamanho - 1] != saida) {
+    const int atual = pilha[tamanho - 1];
+    int proxima     = -1;
+
+    for (int i = 0; i < direcoes_do_labirinto(labirinto) && proxima < 0; ++i) {
+      int adjacente[2];
+
+      if (vizinha_na_direcao(labirinto, atual / colunas, atual % colunas, i, adjacente) && !visitados[adjacente[0] * colunas + adjacente[1]] &&
+          mascara[adjacente[0] * colunas + adjacente[1]]) {
+        proxima = adjacente[0] * colunas + adjacente[1];
+      }
+    }
+
+    if (proxima < 0) {
+      tamanho--;
+      retrocessos++;
+    } else {
+      visitados[proxima] = 1;
+      pilha[tamanho++]   = proxima;
+    }
+  }
+
+  free(pilha);
+  free(visitados);
+  return retrocessos;
+}
+
+static int podar_becos(Labirinto *labirinto, void *contexto) {
+  return preencher_becos(labirinto, 0, contexto);
+}
+
+static void relatar_ara_star(const Caminho *caminho, double limite, double segundos, void *contexto) {
+  (void)contexto;
+  wprintf(L"  ARA* %10.3f ms: custo %d, no máximo %.2fx o ótimo\n", segundos * 1e3, caminho->custo, limite);
+}
+
+/**
+ * Imprime uma linha da tabela. Com `celulas` negativo a coluna de células
+ * por segundo fica em branco, para os resolvedores medidos pelo custo.
+ */
+static void imprimir_resultado(const wchar_t *nome, double segundos, int celulas, double referencia) {
+  wprintf(L"  %-24ls %12.3f ms", nome, segundos * 1e3);
+  if (celulas >= 0) {
+    wprintf(L" %10.2f Mcélulas/s", celulas / segundos / 1e6);
+  } else {
+    wprintf(L" %21ls", L"");
+  }
+  if (referencia > 0) {
+    wprintf(L" %8.1fx", referencia / segundos);
+  }
+  wprintf(L"\n");
+
+  if (medidor.disponiveis) {
+    imprimir_hardware(celulas);
+  }
+}
+
+void executar_benchmark(Labirinto *labirinto, const Opcoes *opcoes) {
+  Bitmapa bitmapa;
+  construir_bitmapa(&bitmapa, labirinto, 0);
+
+  wprintf(L"Labirinto: %s (%dx%d)\n", labirinto->nome, labirinto->tamanho[0], labirinto->tamanho[1]);
+
+  celulas_labirinto = labirinto->tamanho[0] * labirinto->tamanho[1];
+  if (opcoes->contadores_hw && !abrir_medidor(&medidor)) {
+    fflush(stdout);
+    explicar_medidor_indisponivel(stderr);
+  }
+
+  int celulas_referencia, celulas;
+  double referencia = medir(inundar_celula_a_celula, labirinto, NULL, &celulas_referencia);
+  imprimir_resultado(L"encontrar_direcoes", referencia, celulas_referencia, 0);
+
+  double tempo = medir(inundar_bitparalelo, labirinto, &bitmapa, &celulas);
+  imprimir_resultado(L"bit-paralelo", tempo, celulas, referencia);
+
+  if (celulas != celulas_referencia) {
+    erro(L"Os resolvedores discordam sobre as células alcançáveis.");
+  }
+
+  Caminho caminho = { 0 };
+  int distancia   = buscar_bitparalelo(&bitmapa, labirinto, labirinto->jogador.posicao_inicial, labirinto->posicao_saida, PENALIDADE_INIMIGO,
+                                       &caminho);
+  wprintf(L"  Células alcançáveis: %d, distância até a saída: %d\n", celulas, distancia);
+
+  uint8_t *mascara = malloc(labirinto->tamanho[0] * labirinto->tamanho[1] * sizeof(uint8_t));
+  if (mascara == NULL) {
+    erro(L"Falha ao alocar memória para o benchmark.");
+  }
+
+  int preenchidas;
+  tempo = medir(podar_becos, labirinto, mascara, &preenchidas);
+  imprimir_resultado(L"preencher becos", tempo, labirinto->tamanho[0] * labirinto->tamanho[1], 0);
+
+  const int retrocessos = contar_retrocessos(labirinto, mascara);
+  for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+    for (int j = 0; j < labirinto->tamanho[1]; ++j) {
+      mascara[i * labirinto->tamanho[1] + j] = passavel(labirinto->matriz_inicial[i][j], 0);
+    }
+  }
+  wprintf(L"  Becos preenchidos: %d células; retrocessos da busca em profundidade: %d sem poda, %d com poda\n", preenchidas,
+          contar_retrocessos(labirinto, mascara), retrocessos);
+  free(mascara);
+
+  int custo_referencia, custo;
+  referencia = medir(a_star_sequencial, labirinto, NULL, &custo_referencia);
+  imprimir_resultado(L"A* (heap)", referencia, -1, 0);
+
+  // Sem inimigos todo passo custa 1, e o A* usa os baldes no lugar da heap
+  tempo = medir(a_star_sem_inimigos, labirinto, NULL, &custo);
+  imprimir_resultado(L"A* (sem inimigos)", tempo, -1, referencia);
+
+  tempo = medir(a_star_paralelo, labirinto, (void *)opcoes, &custo);
+  wchar_t nome[32];
+  swprintf(nome, 32, L"A* paralelo (%d threads)", opcoes->threads);
+  imprimir_resultado(nome, tempo, -1, referencia);
+
+  if (custo != custo_referencia) {
+    erro(L"O A* paralelo não encontrou o caminho ótimo.");
+  }
+  wprintf(L"  Custo com inimigos: %d\n", custo);
+
+  int custo_campo;
+  tempo = medir(construir_campo, labirinto, NULL, &custo_campo);
+  imprimir_resultado(L"campo da saída (uma vez)", tempo, -1, 0);
+
+  tempo = medir(consultar_campo_saida, labirinto, (void *)obter_campo(labirinto, PENALIDADE_INIMIGO), &custo_campo);
+  imprimir_resultado(L"consulta no campo", tempo, -1, referencia);
+
+  if (custo_campo != custo_referencia) {
+    erro(L"O campo de distâncias discorda do A*.");
+  }
+
+  GrafoJuncoes grafo;
+  construir_grafo(&grafo, labirinto, PENALIDADE_INIMIGO);
+
+  int custo_grafo;
+  tempo = medir(construir_grafo_juncoes, labirinto, NULL, &custo_grafo);
+  imprimir_resultado(L"junções (uma vez)", tempo, -1, 0);
+
+  tempo = medir(a_star_juncoes, labirinto, &grafo, &custo_grafo);
+  imprimir_resultado(L"A* nas junções", tempo, -1, referencia);
+
+  if (custo_grafo != custo_referencia) {
+    erro(L"O A* no grafo de junções discorda do A*.");
+  }
+  wprintf(L"  Junções: %d vértices, %d arestas\n", grafo.quantidade_vertices, grafo.quantidade_arestas);
+  liberar_grafo(&grafo);
+
+  Hierarquia hierarquia;
+  construir_hierarquia(&hierarquia, labirinto, PENALIDADE_INIMIGO);
+
+  int custo_hierarquico;
+  tempo = medir(construir_hierarquia_hpa, labirinto, NULL, &custo_hierarquico);
+  imprimir_resultado(L"HPA* (uma vez)", tempo, -1, 0);
+
+  tempo = medir(atualizar_hierarquia, labirinto, &hierarquia, &custo_hierarquico);
+  imprimir_resultado(L"HPA* (um agrupamento)", tempo, -1, 0);
+
+  tempo = medir(busca_hierarquica, labirinto, &hierarquia, &custo_hierarquico);
+  imprimir_resultado(L"HPA*", tempo, -1, referencia);
+
+  wprintf(L"  Agrupamentos: %d, nós: %d, custo: %d (%.2f%% acima do ótimo)\n", hierarquia.agrupamentos_linhas * hierarquia.agrupamentos_colunas,
+          contar_nos(&hierarquia), custo_hierarquico, custo_referencia > 0 ? 100.0 * (custo_hierarquico - custo_referencia) / custo_referencia : 0);
+  liberar_hierarquia(&hierarquia);
+
+  int custo_dstar;
+  tempo = medir(planejar_dstar_lite, labirinto, NULL, &custo_dstar);
+  imprimir_resultado(L"D* Lite (primeiro plano)", tempo, -1, referencia);
+
+  if (custo_dstar != custo_referencia) {
+    erro(L"O D* Lite discorda do A*.");
+  }
+
+  // A parede alterna no meio do caminho atual, onde a mudança mais pesa
+  if (custo_dstar > 0) {
+    AlternanciaDStar alternancia = { .posicao = { labirinto->jogador.posicao_inicial[0], labirinto->jogador.posicao_inicial[1] } };
+    Caminho caminho_dstar        = { 0 };
+
+    iniciar_dstar_lite(&alternancia.planejador, labirinto, labirinto->jogador.posicao_inicial, PENALIDADE_INIMIGO);
+    replanejar(&alternancia.planejador, &caminho_dstar);
+
+    for (int i = 0; i < caminho_dstar.tamanho / 2; ++i) {
+      avancar_posicao(labirinto, alternancia.posicao, caminho_dstar.direcoes[i]);
+    }
+
+    const long long expansoes = alternancia.planejador.expansoes;
+    tempo                     = medir(replanejar_dstar_lite, labirinto, &alternancia, &custo_dstar);
+    imprimir_resultado(L"D* Lite (replanejar)", tempo, -1, referencia);
+    wprintf(L"  Expansões: %lld no primeiro plano, %lld por replanejamento\n", expansoes,
+            (alternancia.planejador.expansoes - expansoes) / max(1, alternancia.rodadas));
+
+    liberar_caminho(&caminho_dstar);
+    liberar_dstar_lite(&alternancia.planejador);
+  }
+
+  Caminho caminho_ara = { 0 };
+  buscar_ara_star(labirinto, labirinto->jogador.posicao_inicial, labirinto->posicao_saida, PENALIDADE_INIMIGO, EPSILON_INICIAL,
+                  opcoes->prazo, relatar_ara_star, NULL, &caminho_ara);
+  liberar_caminho(&caminho_ara);
+
+  liberar_caminho(&caminho);
+  liberar_bitmapa(&bitmapa);
+  fechar_medidor(&medidor);
+}
@@ -0,0 +1,290 @@
+/*
+ * bitmapa.c - Busca em largura bit-paralela sobre o labirinto compactado
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/bitmapa.h"
+#include "include/estatisticas.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define bit_ligado(bits, b, linha, coluna) (((bits)[(linha) * (b)->palavras + (coluna) / BITS_PALAVRA] >> ((coluna) % BITS_PALAVRA)) & 1)
+#define ligar_bit(bits, b, linha, coluna) ((bits)[(linha) * (b)->palavras + (coluna) / BITS_PALAVRA] |= (Palavra)1 << ((coluna) % BITS_PALAVRA))
+
+// O bit j da palavra w de uma linha representa a coluna w * 64 + j
+void construir_bitmapa(Bitmapa *bitmapa, const Labirinto *labirinto, int com_inimigos) {
+  bitmapa->linhas      = labirinto->tamanho[0];
+  bitmapa->colunas     = labirinto->tamanho[1];
+  bitmapa->palavras    = (bitmapa->colunas + BITS_PALAVRA - 1) / BITS_PALAVRA;
+  bitmapa->passo_andar = labirinto->linhas_andar + 1;
+  bitmapa->livres      = calloc((size_t)bitmapa->linhas * bitmapa->palavras, sizeof(Palavra));
+  bitmapa->escadas     = labirinto->andares > 1 ? calloc((size_t)bitmapa->linhas * bitmapa->palavras, sizeof(Palavra)) : NULL;
+  bitmapa->saidas      = calloc((size_t)bitmapa->linhas * bitmapa->palavras, sizeof(Palavra));
+  somar(alocacoes, labirinto->andares > 1 ? 3 : 2);
+
+  if (bitmapa->livres == NULL || bitmapa->saidas == NULL || (labirinto->andares > 1 && bitmapa->escadas == NULL)) {
+    erro(L"Falha ao alocar memória para o bitmapa.");
+  }
+
+  for (int i = 0; i < bitmapa->linhas; ++i) {
+    for (int j = 0; j < bitmapa->colunas; ++j) {
+      if (passavel(labirinto->matriz_inicial[i][j], com_inimigos)) {
+        ligar_bit(bitmapa->livres, bitmapa, i, j);
+      }
+      if (bitmapa->escadas && escada(labirinto->matriz_inicial[i][j])) {
+        ligar_bit(bitmapa->escadas, bitmapa, i, j);
+      }
+      if (labirinto->matriz_inicial[i][j] == SAIDA) {
+        ligar_bit(bitmapa->saidas, bitmapa, i, j);
+      }
+    }
+  }
+}
+
+void aplicar_mascara(Bitmapa *bitmapa, const uint8_t *mascara) {
+  for (int i = 0; i < bitmapa->linhas; ++i) {
+    for (int j = 0; j < bitmapa->colunas; ++j) {
+      if (!mascara[i * bitmapa->colunas + j]) {
+        bitmapa->livres[i * bitmapa->palavras + j / BITS_PALAVRA] &= ~((Palavra)1 << (j % BITS_PALAVRA));
+      }
+    }
+  }
+}
+
+void liberar_bitmapa(Bitmapa *bitmapa) {
+  free(bitmapa->livres);
+  free(bitmapa->escadas);
+  free(bitmapa->saidas);
+  bitmapa->livres  = NULL;
+  bitmapa->escadas = NULL;
+  bitmapa->saidas  = NULL;
+}
+
+/**
+ * Entrega as células `chegando` à palavra `indice` da próxima fronteira,
+ * descartando paredes e células já visitadas. A palavra entra na lista
+ * `novas` na primeira vez em que recebe alguma célula neste nível.
+ */
+static inline void entregar(const Bitmapa *bitmapa, Palavra *proxima, Palavra *visitados, int indice, Palavra chegando, int *novas,
+                            int *quantidade_novas) {
+  const Palavra novos = chegando & bitmapa->livres[indice] & ~visitados[indice];
+
+  if (!novos) {
+    return;
+  }
+
+  if (!proxima[indice]) {
+    novas[(*quantidade_novas)++] = indice;
+  }
+
+  proxima[indice] |= novos;
+  visitados[indice] |= novos;
+}
+
+/**
+ * Avança a fronteira um nível inteiro. Cada palavra ocupada da fronteira
+ * (`ativas`) espalha as suas 64 células de uma vez: deslocada para os lados
+ * na própria palavra (com o "vai um" para as palavras vizinhas) e copiada
+ * para as linhas de cima e de baixo; as escadas ocupadas chegam às escadas
+ * da mesma coluna, `passo_andar` linhas acima ou abaixo. Assim cada nível
+ * custa proporcional à fronteira e não ao labirinto, e cada palavra ativa é
+ * lida uma vez só.
+ *
+ * @return A quantidade de palavras ocupadas da nova fronteira, guardadas em `novas`.
+ */
+static int expandir_fronteira(const Bitmapa *bitmapa, const Palavra *fronteira, Palavra *proxima, Palavra *visitados, const int *ativas,
+                              int quantidade, int *novas) {
+  const int palavras   = bitmapa->palavras;
+  int quantidade_novas = 0;
+
+  for (int k = 0; k < quantidade; ++k) {
+    const int indice      = ativas[k];
+    const int linha       = indice / palavras;
+    const int w           = indice % palavras;
+    const Palavra ocupada = fronteira[indice];
+
+    entregar(bitmapa, proxima, visitados, indice, (ocupada << 1) | (ocupada >> 1), novas, &quantidade_novas);
+
+    // O "vai um" só existe se a célula da borda estiver ocupada
+    if (w > 0 && (ocupada & 1)) {
+      entregar(bitmapa, proxima, visitados, indice - 1, (Palavra)1 << (BITS_PALAVRA - 1), novas, &quantidade_novas);
+    }
+    if (w + 1 < palavras && (ocupada >> (BITS_PALAVRA - 1))) {
+      entregar(bitmapa, proxima, visitados, indice + 1, 1, novas, &quantidade_novas);
+    }
+    if (linha > 0) {
+      entregar(bitmapa, proxima, visitados, indice - palavras, ocupada, novas, &quantidade_novas);
+    }
+    if (linha + 1 < bitmapa->linhas) {
+      entregar(bitmapa, proxima, visitados, indice + palavras, ocupada, novas, &quantidade_novas);
+    }
+
+    if (bitmapa->escadas && (ocupada & bitmapa->escadas[indice])) {
+      const Palavra nas_escadas = ocupada & bitmapa->escadas[indice];
+      const int passo           = bitmapa->passo_andar;
+      const int deslocado       = passo * palavras;
+
+      if (linha >= passo) {
+        entregar(bitmapa, proxima, visitados, indice - deslocado, nas_escadas & bitmapa->escadas[indice - deslocado], novas,
+                 &quantidade_novas);
+      }
+      if (linha + passo < bitmapa->linhas) {
+        entregar(bitmapa, proxima, visitados, indice + deslocado, nas_escadas & bitmapa->escadas[indice + deslocado], novas,
+                 &quantidade_novas);
+      }
+    }
+  }
+
+  return quantidade_novas;
+}
+
+/**
+ * Reconstrói o caminho de trás pra frente. Guardamos só o nível de cada
+ * célula módulo 3: como vizinhos diferem em no máximo um nível, o vizinho com
+ * nível (d - 1) % 3 é sempre um antecessor válido.
+ */
+static void reconstruir_caminho(const Bitmapa *bitmapa, const Labirinto *labirinto, Palavra *niveis[3], int destino[2], int distancia,
+                                int penalidade, Caminho *caminho) {
+  caminho->direcoes = malloc(max(1, distancia) * sizeof(int));
+  caminho->tamanho  = distancia;
+  caminho->custo    = 0;
+
+  if (caminho->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o caminho.");
+  }
+
+  int atual[2] = { destino[0], destino[1] };
+
+  for (int d = distancia; d > 0; --d) {
+    const Palavra *anterior = niveis[(d - 1) % 3];
+
+    caminho->custo += 1 + (inimigo(labirinto->matriz_inicial[atual[0]][atual[1]]) ? max(0, penalidade) : 0);
+
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      int vizinha[2];
+
+      if (!vizinha_na_direcao(labirinto, atual[0], atual[1], i, vizinha) || !bit_ligado(anterior, bitmapa, vizinha[0], vizinha[1])) {
+        continue;
+      }
+
+      caminho->direcoes[d - 1] = inverter_posicao(i);
+      atual[0]                 = vizinha[0];
+      atual[1]                 = vizinha[1];
+      break;
+    }
+  }
+}
+
+/**
+ * A busca em largura por níveis. Ela para no destino ou, sem ele, na primeira
+ * célula marcada em `alvos`; sem nenhum dos dois, percorre tudo o que alcança.
+ */
+static int busca_bitparalela(const Bitmapa *bitmapa, const Labirinto *labirinto, int origem[2], int destino[2], const Palavra *alvos,
+                             int penalidade, Caminho *caminho, int *alcancaveis) {
+  const size_t total = (size_t)bitmapa->linhas * bitmapa->palavras;
+  Palavra *memoria   = calloc(total * 6, sizeof(Palavra));
+  int *listas        = malloc(total * 2 * sizeof(int));
+  somar(alocacoes, 2);
+
+  if (memoria == NULL || listas == NULL) {
+    erro(L"Falha ao alocar memória para a busca bit-paralela.");
+  }
+
+  Palavra *visitados = memoria;
+  Palavra *fronteira = memoria + total;
+  Palavra *proxima   = memoria + total * 2;
+  Palavra *niveis[3] = { memoria + total * 3, memoria + total * 4, memoria + total * 5 };
+  int *ativas        = listas;
+  int *novas         = listas + total;
+
+  ligar_bit(visitados, bitmapa, origem[0], origem[1]);
+  ligar_bit(fronteira, bitmapa, origem[0], origem[1]);
+  ligar_bit(niveis[0], bitmapa, origem[0], origem[1]);
+
+  int quantidade      = 1;
+  int chegada[2]      = { origem[0], origem[1] };
+  const int na_origem = destino ? comparar_coordenadas(origem, destino) : alvos && bit_ligado(alvos, bitmapa, origem[0], origem[1]);
+  int distancia       = na_origem ? 0 : -1;
+  ativas[0]           = origem[0] * bitmapa->palavras + origem[1] / BITS_PALAVRA;
+
+  for (int nivel = 1; distancia < 0 && quantidade > 0; ++nivel) {
+    const int quantidade_novas = expandir_fronteira(bitmapa, fronteira, proxima, visitados, ativas, quantidade, novas);
+
+    Palavra *nivel_atual = niveis[nivel % 3];
+    for (int k = 0; k < quantidade_novas; ++k) {
+      nivel_atual[novas[k]] |= proxima[novas[k]];
+    }
+
+    if (destino && bit_ligado(proxima, bitmapa, destino[0], destino[1])) {
+      distancia  = nivel;
+      chegada[0] = destino[0];
+      chegada[1] = destino[1];
+    }
+
+    for (int k = 0; alvos && distancia < 0 && k < quantidade_novas; ++k) {
+      const Palavra alcancados = proxima[novas[k]] & alvos[novas[k]];
+
+      if (alcancados) {
+        distancia  = nivel;
+        chegada[0] = novas[k] / bitmapa->palavras;
+        chegada[1] = novas[k] % bitmapa->palavras * BITS_PALAVRA + __builtin_ctzll(alcancados);
+      }
+    }
+
+    for (int k = 0; k < quantidade; ++k) {
+      fronteira[ativas[k]] = 0;
+    }
+
+    Palavra *temp = fronteira;
+    fronteira     = proxima;
+    proxima       = temp;
+
+    int *temp_lista = ativas;
+    ativas          = novas;
+    novas           = temp_lista;
+    quantidade      = quantidade_novas;
+  }
+
+  if (distancia >= 0 && caminho) {
+    reconstruir_caminho(bitmapa, labirinto, niveis, chegada, distancia, penalidade, caminho);
+  }
+
+  if (alcancaveis) {
+    *alcancaveis = 0;
+    for (size_t w = 0; w < total; ++w) {
+      *alcancaveis += __builtin_popcountll(visitados[w]);
+    }
+  }
+
+  free(memoria);
+  free(listas);
+  return distancia;
+}
+
+int buscar_bitparalelo(const Bitmapa *bitmapa, const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, Caminho *caminho) {
+  return busca_bitparalela(bitmapa, labirinto, origem, destino, destino ? NULL : bitmapa->saidas, penalidade, caminho, NULL);
+}
+
+int contar_alcancaveis_bitparalelo(const Bitmapa *bitmapa, int origem[2]) {
+  int alcancaveis = 0;
+  busca_bitparalela(bitmapa, NULL, origem, NULL, NULL, SEM_INIMIGOS, NULL, &alcancaveis);
+  return alcancaveis;
+}
@@ -0,0 +1,321 @@
+/*
+ * busca.c - Buscas sem interface, usadas fora do menu
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/busca.h"
+#include "include/heap.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+Direcoes direcao_entre(int de, int para, int colunas) {
+  if (para == de - colunas) {
+    return ACIMA;
+  }
+  if (para == de + colunas) {
+    return ABAIXO;
+  }
+  if (para == de - 1 || para == de + 1) {
+    return para == de - 1 ? ESQUERDA : DIREITA;
+  }
+  // Só uma escada salta mais de uma linha, e o andar de cima fica mais abaixo na matriz
+  return para > de ? SUBIR : DESCER;
+}
+
+int custo_celula(const Labirinto *labirinto, int penalidade, int linha, int coluna) {
+  if (linha < 0 || linha >= labirinto->tamanho[0] || coluna < 0 || coluna >= labirinto->tamanho[1]) {
+    return -1;
+  }
+  return custo_passo(labirinto->matriz_inicial[linha][coluna], penalidade);
+}
+
+int alvo_da_busca(const Labirinto *labirinto, const int destino[2]) {
+  const int colunas = labirinto->tamanho[1];
+
+  if (destino) {
+    return destino[0] * colunas + destino[1];
+  }
+  return labirinto->quantidade_saidas == 1 ? labirinto->saidas[0][0] * colunas + labirinto->saidas[0][1] : -1;
+}
+
+int chegou_ao_alvo(const Labirinto *labirinto, int celula, int alvo) {
+  const int colunas = labirinto->tamanho[1];
+  return alvo >= 0 ? celula == alvo : labirinto->matriz_inicial[celula / colunas][celula % colunas] == SAIDA;
+}
+
+int estimar_ate_alvo(const Labirinto *labirinto, int celula, int alvo) {
+  const int colunas    = labirinto->tamanho[1];
+  const int posicao[2] = { celula / colunas, celula % colunas };
+
+  if (alvo < 0) {
+    return distancia_ate_saidas(labirinto, posicao);
+  }
+  return distancia_no_labirinto(labirinto, posicao, (int[2]){ alvo / colunas, alvo % colunas });
+}
+
+void reconstruir_por_pais(const Labirinto *labirinto, const int *pais, int origem, int destino, int penalidade, Caminho *caminho) {
+  const int colunas = labirinto->tamanho[1];
+
+  caminho->tamanho = 0;
+  caminho->custo   = 0;
+  for (int atual = destino; atual != origem; atual = pais[atual]) {
+    caminho->tamanho++;
+  }
+
+  caminho->direcoes = malloc(max(1, caminho->tamanho) * sizeof(int));
+  if (caminho->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o caminho.");
+  }
+
+  int passo = caminho->tamanho;
+  for (int atual = destino; atual != origem; atual = pais[atual]) {
+    caminho->direcoes[--passo] = direcao_entre(pais[atual], atual, colunas);
+    caminho->custo += custo_passo(labirinto->matriz_inicial[atual / colunas][atual % colunas], penalidade);
+  }
+}
+
+// Os modelos de custo de um passo: inimigos como paredes, inimigos passáveis
+// com o mesmo custo de uma célula livre e inimigos com penalidade
+typedef enum { INIMIGOS_BLOQUEIAM, SEM_PESOS, COM_PESOS, QUANTIDADE_MODELOS } ModeloCusto;
+
+typedef int (*NucleoAStar)(const Labirinto *labirinto, int inicio, int alvo, int penalidade, int *pesos, int *pais);
+
+typedef struct {
+  int *itens;
+  int tamanho;
+  int capacidade;
+} Balde;
+
+static void empilhar_balde(Balde *balde, int indice) {
+  if (balde->tamanho == balde->capacidade) {
+    balde->capacidade *= 2;
+    balde->itens = realloc(balde->itens, balde->capacidade * sizeof(int));
+
+    if (balde->itens == NULL) {
+      erro(L"Falha ao alocar memória para o A*.");
+    }
+  }
+  balde->itens[balde->tamanho++] = indice;
+}
+
+static inline int estimar(const Labirinto *labirinto, const int celula[2], const int *destino, const int direcoes) {
+  if (destino == NULL) {
+    return distancia_ate_saidas(labirinto, celula);
+  }
+
+  // Sem escadas, a distância de manhattan dispensa o teste dos andares
+  return direcoes == 4 ? abs(celula[0] - destino[0]) + abs(celula[1] - destino[1]) : distancia_no_labirinto(labirinto, celula, destino);
+}
+
+/**
+ * `vizinha_na_direcao` sem a chamada a `checar_coordenada`: com a direção
+ * conhecida, sobra só a comparação com a borda daquele lado.
+ */
+static inline __attribute__((always_inline)) int vizinha_no_nucleo(const Labirinto *labirinto, int linha, int coluna, int direcao,
+                                                                    int vizinha[2]) {
+  char **matriz = labirinto->matriz_inicial;
+
+  vizinha[0] = linha;
+  vizinha[1] = coluna;
+  switch (direcao) {
+  case ACIMA: return --vizinha[0] >= 0;
+  case ABAIXO: return ++vizinha[0] < labirinto->tamanho[0];
+  case ESQUERDA: return --vizinha[1] >= 0;
+  case DIREITA: return ++vizinha[1] < labirinto->tamanho[1];
+  default:
+    vizinha[0] += (direcao == SUBIR ? 1 : -1) * (labirinto->linhas_andar + 1);
+    return vizinha[0] >= 0 && vizinha[0] < labirinto->tamanho[0] && escada(matriz[linha][coluna]) && escada(matriz[vizinha[0]][coluna]);
+  }
+}
+
+/**
+ * O laço do A*, escrito uma vez só para todas as vizinhanças e modelos de
+ * custo. `direcoes`, `com_inimigos` e `ponderado` são sempre constantes nas
+ * instâncias de INSTANCIAR_NUCLEO, então o compilador tira os testes deles de
+ * dentro do laço das vizinhas.
+ *
+ * Sem pesos, todo passo custa 1 e a heurística muda no máximo 1, então uma
+ * vizinha tem prioridade f, f + 1 ou f + 2. A lista aberta vira três baldes,
+ * cada um uma pilha, e inserir e remover deixam de custar log n. Com um alvo
+ * só, a paridade da distância de manhattan deixa o balde do meio sempre vazio.
+ * Tirar do fim da pilha também favorece a célula mais funda, que é o desempate
+ * da heap.
+ *
+ * @return O índice da célula em que a busca chegou, ou -1 se o alvo for inalcançável.
+ */
+static inline __attribute__((always_inline)) int nucleo_a_star(const Labirinto *labirinto, int inicio, int alvo, int penalidade, int *pesos,
+                                                                int *pais, const int direcoes, const int com_inimigos, const int ponderado) {
+  const int linhas          = labirinto->tamanho[0];
+  const int colunas         = labirinto->tamanho[1];
+  const int posicao_alvo[2] = { alvo / colunas, alvo % colunas };
+  const int *destino        = alvo >= 0 ? posicao_alvo : NULL;
+  char **matriz             = labirinto->matriz_inicial;
+
+  Heap abertos;
+  Balde baldes[3];
+  long long prioridade = estimar(labirinto, (int[2]){ inicio / colunas, inicio % colunas }, destino, direcoes);
+  int chegada          = -1;
+
+  if (ponderado) {
+    criar_heap(&abertos, linhas + colunas);
+    inserir_heap(&abertos, (ItemHeap){ .custo = prioridade, .peso = 0, .indice = inicio });
+  } else {
+    for (int i = 0; i < 3; ++i) {
+      baldes[i] = (Balde){ .itens = malloc((linhas + colunas) * sizeof(int)), .tamanho = 0, .capacidade = linhas + colunas };
+
+      if (baldes[i].itens == NULL) {
+        erro(L"Falha ao alocar memória para o A*.");
+      }
+    }
+    empilhar_balde(&baldes[0], inicio);
+  }
+
+  while (1) {
+    int atual;
+
+    if (ponderado) {
+      if (abertos.tamanho == 0) {
+        break;
+      }
+
+      const ItemHeap topo = remover_heap(&abertos);
+      if (topo.peso > pesos[topo.indice]) {
+        continue;
+      }
+      atual = topo.indice;
+    } else {
+      if (baldes[0].tamanho == 0) {
+        if (baldes[1].tamanho == 0 && baldes[2].tamanho == 0) {
+          break;
+        }
+
+        const Balde vazio = baldes[0];
+        baldes[0]         = baldes[1];
+        baldes[1]         = baldes[2];
+        baldes[2]         = vazio;
+        prioridade++;
+        continue;
+      }
+
+      // Uma célula que melhorou depois de entrar no balde seguinte já saiu
+      // pelo balde atual, e a entrada velha fica com a prioridade errada
+      atual = baldes[0].itens[--baldes[0].tamanho];
+      if (pesos[atual] + estimar(labirinto, (int[2]){ atual / colunas, atual % colunas }, destino, direcoes) != prioridade) {
+        continue;
+      }
+    }
+
+    const int linha = atual / colunas, coluna = atual % colunas;
+
+    if (alvo >= 0 ? atual == alvo : matriz[linha][coluna] == SAIDA) {
+      chegada = atual;
+      break;
+    }
+
+    for (int i = 0; i < direcoes; ++i) {
+      int adjacente[2];
+
+      if (!vizinha_no_nucleo(labirinto, linha, coluna, i, adjacente)) {
+        continue;
+      }
+
+      const char celula = matriz[adjacente[0]][adjacente[1]];
+      const int indice  = adjacente[0] * colunas + adjacente[1];
+      const int peso    = pesos[atual] + 1 + (ponderado && inimigo(celula) ? penalidade : 0);
+
+      if (!passavel(celula, com_inimigos) || peso >= pesos[indice]) {
+        continue;
+      }
+
+      pesos[indice]        = peso;
+      pais[indice]         = atual;
+      const int estimativa = peso + estimar(labirinto, adjacente, destino, direcoes);
+
+      if (ponderado) {
+        inserir_heap(&abertos, (ItemHeap){ .custo = estimativa, .peso = peso, .indice = indice });
+      } else {
+        empilhar_balde(&baldes[estimativa - prioridade], indice);
+      }
+    }
+  }
+
+  if (ponderado) {
+    liberar_heap(&abertos);
+  } else {
+    for (int i = 0; i < 3; ++i) {
+      free(baldes[i].itens);
+    }
+  }
+  return chegada;
+}
+
+// Uma instância do núcleo, com a vizinhança e o modelo de custo fixos
+#define INSTANCIAR_NUCLEO(nome, direcoes, com_inimigos, ponderado)                                                                 \
+  static int nome(const Labirinto *labirinto, int inicio, int alvo, int penalidade, int *pesos, int *pais) {                       \
+    return nucleo_a_star(labirinto, inicio, alvo, penalidade, pesos, pais, direcoes, com_inimigos, ponderado);                      \
+  }
+
+INSTANCIAR_NUCLEO(a_star_andar_inimigos_bloqueiam, 4, 0, 0)
+INSTANCIAR_NUCLEO(a_star_andar_sem_pesos, 4, 1, 0)
+INSTANCIAR_NUCLEO(a_star_andar_com_pesos, 4, 1, 1)
+INSTANCIAR_NUCLEO(a_star_andares_inimigos_bloqueiam, 6, 0, 0)
+INSTANCIAR_NUCLEO(a_star_andares_sem_pesos, 6, 1, 0)
+INSTANCIAR_NUCLEO(a_star_andares_com_pesos, 6, 1, 1)
+
+// Indexado pela vizinhança (só o andar ou com escadas) e pelo modelo de custo
+static const NucleoAStar nucleos_a_star[2][QUANTIDADE_MODELOS] = {
+  { a_star_andar_inimigos_bloqueiam, a_star_andar_sem_pesos, a_star_andar_com_pesos },
+  { a_star_andares_inimigos_bloqueiam, a_star_andares_sem_pesos, a_star_andares_com_pesos },
+};
+
+int buscar_a_star(const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, Caminho *caminho) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+  const int alvo    = alvo_da_busca(labirinto, destino);
+  const int inicio  = origem[0] * colunas + origem[1];
+
+  int *pesos = malloc(linhas * colunas * sizeof(int));
+  int *pais  = malloc(linhas * colunas * sizeof(int));
+
+  if (pesos == NULL || pais == NULL) {
+    erro(L"Falha ao alocar memória para o A*.");
+  }
+
+  for (int i = 0; i < linhas * colunas; ++i) {
+    pesos[i] = INT_MAX;
+  }
+
+  pesos[inicio] = 0;
+  pais[inicio]  = inicio;
+
+  // O núcleo é escolhido uma vez por busca, e não a cada vizinha
+  const ModeloCusto modelo = penalidade < 0 ? INIMIGOS_BLOQUEIAM : penalidade == 0 ? SEM_PESOS : COM_PESOS;
+  const int chegada        = nucleos_a_star[labirinto->andares > 1][modelo](labirinto, inicio, alvo, penalidade, pesos, pais);
+  const int custo          = chegada >= 0 ? pesos[chegada] : -1;
+
+  if (custo >= 0 && caminho) {
+    reconstruir_por_pais(labirinto, pais, inicio, chegada, penalidade, caminho);
+  }
+
+  free(pesos);
+  free(pais);
+  return custo;
+}
@@ -0,0 +1,256 @@
+/*
+ * cache.c - Cache de soluções em disco, endereçado pelo conteúdo do labirinto
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/cache.h"
+#include "include/io.h"
+#include "include/os.h"
+#include "include/util.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEMENTE_HASH 0x9E3779B97F4A7C15ULL
+#define SEMENTE_VERIFICACAO 0xD6E8FEB86659FD93ULL
+#define MULTIPLICADOR_HASH 0xBF58476D1CE4E5B9ULL
+#define MULTIPLICADOR_VERIFICACAO 0x94D049BB133111EBULL
+
+/**
+ * O cabeçalho de uma entrada, seguido de `(passos + 3) / 4` bytes com as
+ * direções. Os campos ficam na ordem de bytes da máquina: o cache é local.
+ */
+typedef struct {
+  char assinatura[4];
+  uint32_t versao;
+  uint64_t verificacao;
+  int32_t tamanho[2];
+  int32_t origem[2];
+  int32_t saida[2];
+  int32_t algoritmo;
+  int32_t penalidade;
+  int32_t custo;
+  int32_t passos;
+  uint64_t soma;
+} CabecalhoCache;
+
+static uint64_t misturar(uint64_t hash, uint64_t valor, uint64_t multiplicador) {
+  hash = (hash ^ valor) * multiplicador;
+  return hash ^ (hash >> 29);
+}
+
+static void misturar_nos_dois(ChaveCache *chave, uint64_t valor) {
+  chave->hash        = misturar(chave->hash, valor, MULTIPLICADOR_HASH);
+  chave->verificacao = misturar(chave->verificacao, valor, MULTIPLICADOR_VERIFICACAO);
+}
+
+int calcular_chave_cache(ChaveCache *chave, const char *texto, size_t tamanho, Algoritmo algoritmo, int penalidade, double prazo) {
+  const char *fim = texto + tamanho;
+  int linhas, colunas, andares;
+
+  // As direções são guardadas em 2 bits, então os labirintos com escadas
+  // ficam sempre fora do cache
+  if (!ler_dimensoes(texto, &linhas, &colunas, &andares) || andares > 1) {
+    return 0;
+  }
+
+  const char *atual = memchr(texto, '\n', tamanho);
+  if (atual == NULL) {
+    return 0;
+  }
+
+  *chave = (ChaveCache){ .hash = SEMENTE_HASH, .verificacao = SEMENTE_VERIFICACAO, .algoritmo = algoritmo, .penalidade = penalidade };
+
+  // As células entram de 8 em 8 numa palavra, na mesma ordem em que
+  // `preencher_matriz` as leria, com espaços e quebras de linha ignorados
+  const long total = (long)linhas * colunas;
+  long celula      = 0, origem = -1, saida = -1;
+  uint64_t palavra = 0;
+
+  for (++atual; atual < fim; ++atual) {
+    const char caractere = *atual;
+    if (caractere == ' ' || caractere == '\n' || caractere == '\r') {
+      continue;
+    }
+    if (celula == total) {
+      return 0;
+    }
+
+    // Com mais de uma partida ou saída, a resposta não é um caminho só
+    if (caractere == JOGADOR) {
+      origem = origem == -1 ? celula : -2;
+    } else if (caractere == SAIDA) {
+      saida = saida == -1 ? celula : -2;
+    }
+
+    palavra = palavra << 8 | (uint8_t)caractere;
+    if ((++celula & 7) == 0) {
+      misturar_nos_dois(chave, palavra);
+      palavra = 0;
+    }
+  }
+
+  if (celula != total || origem < 0 || saida < 0) {
+    return 0;
+  }
+
+  chave->tamanho[0] = linhas;
+  chave->tamanho[1] = colunas;
+  chave->origem[0]  = origem / colunas;
+  chave->origem[1]  = origem % colunas;
+  chave->saida[0]   = saida / colunas;
+  chave->saida[1]   = saida % colunas;
+
+  misturar_nos_dois(chave, palavra);
+  misturar_nos_dois(chave, (uint64_t)linhas << 32 | (uint32_t)colunas);
+  misturar_nos_dois(chave, (uint64_t)origem << 32 | (uint32_t)saida);
+  misturar_nos_dois(chave, (uint64_t)algoritmo << 32 | (uint32_t)penalidade);
+
+  if (algoritmo == ALGORITMO_ARA) {
+    uint64_t bits;
+    memcpy(&bits, &prazo, sizeof bits);
+    misturar_nos_dois(chave, bits);
+  }
+
+  return 1;
+}
+
+static void nome_entrada(char *destino, size_t tamanho, const char *diretorio, uint64_t hash) {
+  snprintf(destino, tamanho, "%s/%016llx.lbs", diretorio, (unsigned long long)hash);
+}
+
+static uint64_t somar_direcoes(const uint8_t *empacotado, size_t bytes) {
+  uint64_t soma = SEMENTE_HASH;
+  for (size_t i = 0; i < bytes; ++i) {
+    soma = misturar(soma, empacotado[i], MULTIPLICADOR_HASH);
+  }
+  return soma;
+}
+
+static int cabecalho_confere(const CabecalhoCache *cabecalho, const ChaveCache *chave) {
+  return memcmp(cabecalho->assinatura, ASSINATURA_CACHE, 4) == 0 && cabecalho->versao == VERSAO_CACHE &&
+         cabecalho->verificacao == chave->verificacao && cabecalho->tamanho[0] == chave->tamanho[0] &&
+         cabecalho->tamanho[1] == chave->tamanho[1] && cabecalho->origem[0] == chave->origem[0] &&
+         cabecalho->origem[1] == chave->origem[1] && cabecalho->saida[0] == chave->saida[0] && cabecalho->saida[1] == chave->saida[1] &&
+         cabecalho->algoritmo == chave->algoritmo && cabecalho->penalidade == chave->penalidade && cabecalho->passos >= 0 &&
+         cabecalho->passos < chave->tamanho[0] * chave->tamanho[1] && (cabecalho->custo >= 0 || cabecalho->passos == 0);
+}
+
+/**
+ * Desempacota as direções e confere que elas andam da partida até a saída
+ * sem sair do labirinto.
+ */
+static int desempacotar(const CabecalhoCache *cabecalho, const uint8_t *empacotado, int *direcoes) {
+  int posicao[2] = { cabecalho->origem[0], cabecalho->origem[1] };
+
+  for (int i = 0; i < cabecalho->passos; ++i) {
+    direcoes[i] = (empacotado[i / 4] >> (i % 4 * 2)) & 3;
+    posicao[0] += deslocamento_linha[direcoes[i]];
+    posicao[1] += deslocamento_coluna[direcoes[i]];
+
+    if (posicao[0] < 0 || posicao[0] >= cabecalho->tamanho[0] || posicao[1] < 0 || posicao[1] >= cabecalho->tamanho[1]) {
+      return 0;
+    }
+  }
+
+  return cabecalho->custo < 0 || (posicao[0] == cabecalho->saida[0] && posicao[1] == cabecalho->saida[1]);
+}
+
+int buscar_no_cache(const char *diretorio, const ChaveCache *chave, Caminho *caminho) {
+  char nome[4096];
+  nome_entrada(nome, sizeof nome, diretorio, chave->hash);
+
+  FILE *arquivo = fopen(nome, "rb");
+  if (arquivo == NULL) {
+    return 0;
+  }
+
+  CabecalhoCache cabecalho;
+  int valido = fread(&cabecalho, sizeof cabecalho, 1, arquivo) == 1 && cabecalho_confere(&cabecalho, chave);
+
+  const size_t bytes  = valido ? (cabecalho.passos + 3) / 4 : 0;
+  uint8_t *empacotado = valido ? malloc(bytes + 1) : NULL;
+  int *direcoes       = valido ? malloc((cabecalho.passos + 1) * sizeof(int)) : NULL;
+
+  valido = valido && empacotado != NULL && direcoes != NULL && fread(empacotado, 1, bytes, arquivo) == bytes &&
+           fgetc(arquivo) == EOF && somar_direcoes(empacotado, bytes) == cabecalho.soma &&
+           desempacotar(&cabecalho, empacotado, direcoes);
+
+  fclose(arquivo);
+  free(empacotado);
+
+  if (!valido) {
+    free(direcoes);
+    return 0;
+  }
+
+  caminho->direcoes = direcoes;
+  caminho->tamanho  = cabecalho.passos;
+  caminho->custo    = cabecalho.custo;
+  return 1;
+}
+
+void guardar_no_cache(const char *diretorio, const ChaveCache *chave, int custo, const Caminho *caminho) {
+  static atomic_int sequencia;
+  char nome[4096], temporario[4096 + 32];
+
+  if (!criar_diretorio(diretorio)) {
+    return;
+  }
+
+  const int passos    = custo < 0 ? 0 : caminho->tamanho;
+  const size_t bytes  = (passos + 3) / 4;
+  uint8_t *empacotado = calloc(bytes + 1, sizeof(uint8_t));
+  if (empacotado == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < passos; ++i) {
+    empacotado[i / 4] |= caminho->direcoes[i] << (i % 4 * 2);
+  }
+
+  CabecalhoCache cabecalho = { .versao      = VERSAO_CACHE,
+                               .verificacao = chave->verificacao,
+                               .tamanho     = { chave->tamanho[0], chave->tamanho[1] },
+                               .origem      = { chave->origem[0], chave->origem[1] },
+                               .saida       = { chave->saida[0], chave->saida[1] },
+                               .algoritmo   = chave->algoritmo,
+                               .penalidade  = chave->penalidade,
+                               .custo       = max(-1, custo),
+                               .passos      = passos,
+                               .soma        = somar_direcoes(empacotado, bytes) };
+  memcpy(cabecalho.assinatura, ASSINATURA_CACHE, 4);
+
+  nome_entrada(nome, sizeof nome, diretorio, chave->hash);
+  snprintf(temporario, sizeof temporario, "%s.%d.%d.tmp", nome, identificador_processo(), atomic_fetch_add(&sequencia, 1));
+
+  FILE *arquivo = fopen(temporario, "wb");
+  if (arquivo != NULL) {
+    const int escrito = fwrite(&cabecalho, sizeof cabecalho, 1, arquivo) == 1 && fwrite(empacotado, 1, bytes, arquivo) == bytes;
+
+    // No Windows o rename falha se a entrada já existir, e ela já serve
+    if (fclose(arquivo) != 0 || !escrito || rename(temporario, nome) != 0) {
+      remove(temporario);
+    }
+  }
+
+  free(empacotado);
+}
@@ -0,0 +1,267 @@
+/*
+ * campo.c - Campo de distâncias até a saída, calculado uma vez por labirinto
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/campo.h"
+#include "include/heap.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+/**
+ * O laço do Dijkstra ao contrário: tira as células da heap em ordem de
+ * distância e oferece às vizinhas o caminho que passa por elas.
+ */
+static void propagar_campo(CampoDistancia *campo, const Labirinto *labirinto, Heap *abertos) {
+  const int colunas    = campo->colunas;
+  const int penalidade = campo->penalidade;
+  const int direcoes   = direcoes_do_labirinto(labirinto);
+
+  while (abertos->tamanho > 0) {
+    ItemHeap topo = remover_heap(abertos);
+
+    if (topo.custo > campo->distancias[topo.indice]) {
+      continue;
+    }
+
+    const int linha = topo.indice / colunas, coluna = topo.indice % colunas;
+    const int passo = custo_passo(labirinto->matriz_inicial[linha][coluna], penalidade);
+
+    if (passo < 0) {
+      continue;
+    }
+
+    // Quem estiver num vizinho paga `passo` para entrar nessa célula
+    for (int i = 0; i < direcoes; ++i) {
+      int vizinho[2];
+
+      if (!vizinha_na_direcao(labirinto, linha, coluna, i, vizinho) || custo_passo(labirinto->matriz_inicial[vizinho[0]][vizinho[1]], penalidade) < 0) {
+        continue;
+      }
+
+      const int indice    = vizinho[0] * colunas + vizinho[1];
+      const int distancia = topo.custo + passo;
+
+      if (distancia >= campo->distancias[indice]) {
+        continue;
+      }
+
+      campo->distancias[indice] = distancia;
+      campo->proximo[indice]    = inverter_posicao(i);
+      inserir_heap(abertos, (ItemHeap){ .custo = distancia, .peso = 0, .indice = indice });
+    }
+  }
+}
+
+void calcular_campo(CampoDistancia *campo, const Labirinto *labirinto, int penalidade) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+
+  campo->linhas      = linhas;
+  campo->colunas     = colunas;
+  campo->passo_andar = (labirinto->linhas_andar + 1) * colunas;
+  campo->penalidade  = penalidade;
+  campo->distancias  = malloc(linhas * colunas * sizeof(int));
+  campo->proximo     = malloc(linhas * colunas * sizeof(uint8_t));
+
+  if (campo->distancias == NULL || campo->proximo == NULL) {
+    erro(L"Falha ao alocar memória para o campo de distâncias.");
+  }
+
+  for (int i = 0; i < linhas * colunas; ++i) {
+    campo->distancias[i] = INT_MAX;
+    campo->proximo[i]    = SEM_DIRECAO;
+  }
+
+  Heap abertos;
+  criar_heap(&abertos, linhas + colunas);
+
+  // Todas as saídas entram juntas com distância zero, então uma única passada
+  // dá a distância de cada célula até a saída mais próxima
+  const int quantidade = labirinto->quantidade_saidas;
+  for (int i = 0; i < max(1, quantidade); ++i) {
+    const int *posicao       = quantidade > 0 ? labirinto->saidas[i] : labirinto->posicao_saida;
+    const int saida          = posicao[0] * colunas + posicao[1];
+    campo->distancias[saida] = 0;
+    inserir_heap(&abertos, (ItemHeap){ .custo = 0, .peso = 0, .indice = saida });
+  }
+
+  propagar_campo(campo, labirinto, &abertos);
+  liberar_heap(&abertos);
+}
+
+/**
+ * Acrescenta uma célula à lista das invalidadas, que dobra quando enche.
+ */
+static void invalidar(CampoDistancia *campo, int celula, int **lista, int *quantidade, int *capacidade) {
+  if (*quantidade == *capacidade) {
+    *capacidade *= 2;
+    *lista = realloc(*lista, *capacidade * sizeof(int));
+    if (*lista == NULL) {
+      erro(L"Falha ao alocar memória para o campo de distâncias.");
+    }
+  }
+
+  campo->distancias[celula] = INT_MAX;
+  campo->proximo[celula]    = SEM_DIRECAO;
+  (*lista)[(*quantidade)++] = celula;
+}
+
+int atualizar_campo(CampoDistancia *campo, const Labirinto *labirinto, int (*alteradas)[2], int quantidade) {
+  const int linhas   = campo->linhas;
+  const int colunas  = campo->colunas;
+  const int direcoes = direcoes_do_labirinto(labirinto);
+  char **matriz      = labirinto->matriz_inicial;
+
+  int capacidade = 64, invalidas = 0;
+  int *lista     = malloc(capacidade * sizeof(int));
+  if (lista == NULL) {
+    erro(L"Falha ao alocar memória para o campo de distâncias.");
+  }
+
+  for (int i = 0; i < quantidade; ++i) {
+    invalidar(campo, alteradas[i][0] * colunas + alteradas[i][1], &lista, &invalidas, &capacidade);
+  }
+
+  // As setas formam uma árvore com raízes nas saídas; tudo o que estava
+  // pendurado numa célula alterada perde a distância, o resto continua certo
+  for (int i = 0; i < invalidas; ++i) {
+    const int linha = lista[i] / colunas, coluna = lista[i] % colunas;
+
+    for (int d = 0; d < direcoes; ++d) {
+      // Sem conferir as escadas: quem subia por uma escada que sumiu também perde a distância
+      int posicao[2] = { linha, coluna };
+      avancar_posicao(labirinto, posicao, d);
+      if (!checar_coordenada((int *)labirinto->tamanho, posicao)) {
+        continue;
+      }
+
+      const int vizinha = posicao[0] * colunas + posicao[1];
+      if (campo->proximo[vizinha] == inverter_posicao(d)) {
+        invalidar(campo, vizinha, &lista, &invalidas, &capacidade);
+      }
+    }
+  }
+
+  Heap abertos;
+  criar_heap(&abertos, linhas + colunas);
+
+  // Cada célula invalidada recomeça do melhor vizinho que ficou com distância;
+  // as que melhoraram por causa da mudança são alcançadas pela propagação
+  for (int i = 0; i < invalidas; ++i) {
+    const int celula = lista[i], linha = celula / colunas, coluna = celula % colunas;
+
+    if (custo_passo(matriz[linha][coluna], campo->penalidade) < 0) {
+      continue;
+    }
+
+    if (matriz[linha][coluna] == SAIDA) {
+      campo->distancias[celula] = 0;
+    }
+
+    for (int d = 0; d < direcoes && campo->distancias[celula] > 0; ++d) {
+      int vizinha[2];
+      if (!vizinha_na_direcao(labirinto, linha, coluna, d, vizinha)) {
+        continue;
+      }
+
+      const int indice = vizinha[0] * colunas + vizinha[1];
+      const int passo  = custo_passo(matriz[vizinha[0]][vizinha[1]], campo->penalidade);
+
+      if (passo >= 0 && campo->distancias[indice] != INT_MAX && campo->distancias[indice] + passo < campo->distancias[celula]) {
+        campo->distancias[celula] = campo->distancias[indice] + passo;
+        campo->proximo[celula]    = d;
+      }
+    }
+
+    if (campo->distancias[celula] != INT_MAX) {
+      inserir_heap(&abertos, (ItemHeap){ .custo = campo->distancias[celula], .peso = 0, .indice = celula });
+    }
+  }
+
+  propagar_campo(campo, labirinto, &abertos);
+  liberar_heap(&abertos);
+  free(lista);
+  return invalidas;
+}
+
+const CampoDistancia *obter_campo(Labirinto *labirinto, int penalidade) {
+  if (labirinto->campo != NULL && labirinto->campo->penalidade == penalidade) {
+    return labirinto->campo;
+  }
+
+  if (labirinto->campo == NULL) {
+    labirinto->campo = malloc(sizeof(CampoDistancia));
+    if (labirinto->campo == NULL) {
+      erro(L"Falha ao alocar memória para o campo de distâncias.");
+    }
+  } else {
+    liberar_campo(labirinto->campo);
+  }
+
+  calcular_campo(labirinto->campo, labirinto, penalidade);
+  return labirinto->campo;
+}
+
+int consultar_campo(const CampoDistancia *campo, int origem[2], Caminho *caminho) {
+  int atual = origem[0] * campo->colunas + origem[1];
+
+  if (campo->distancias[atual] == INT_MAX) {
+    return -1;
+  }
+
+  const int custo = campo->distancias[atual];
+
+  if (caminho == NULL) {
+    return custo;
+  }
+
+  int capacidade    = campo->linhas + campo->colunas;
+  caminho->direcoes = malloc(capacidade * sizeof(int));
+  caminho->tamanho  = 0;
+  caminho->custo    = custo;
+
+  while (caminho->direcoes != NULL && campo->proximo[atual] != SEM_DIRECAO) {
+    if (caminho->tamanho == capacidade) {
+      capacidade *= 2;
+      caminho->direcoes = realloc(caminho->direcoes, capacidade * sizeof(int));
+      continue;
+    }
+
+    const int direcao                     = campo->proximo[atual];
+    caminho->direcoes[caminho->tamanho++] = direcao;
+    atual += direcao < SUBIR ? deslocamento_linha[direcao] * campo->colunas + deslocamento_coluna[direcao] :
+                               (direcao == SUBIR ? 1 : -1) * campo->passo_andar;
+  }
+
+  if (caminho->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o caminho.");
+  }
+
+  return custo;
+}
+
+void liberar_campo(CampoDistancia *campo) {
+  free(campo->distancias);
+  free(campo->proximo);
+  campo->distancias = NULL;
+  campo->proximo    = NULL;
+}
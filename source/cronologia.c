@@ -0,0 +1,181 @@
+/*
+ * cronologia.c - Linha do tempo dos trechos do programa no formato do Chrome
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/cronologia.h"
+#include "include/os.h"
+#include "include/typedefs.h"
+#include "include/util.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+  const char *nome;
+  double inicio;
+  double fim;
+} EventoCronologia;
+
+typedef struct {
+  EventoCronologia eventos[EVENTOS_POR_ANEL];
+  unsigned long long escritos;
+  atomic_int livre;
+} AnelCronologia;
+
+static const char *arquivo_cronologia;
+static double inicio_cronologia;
+static int cronologia_ativa;
+
+// Os anéis só são registrados aqui quando a thread grava o primeiro trecho;
+// depois disso cada thread escreve só no seu
+static AnelCronologia *_Atomic aneis[MAXIMO_ANEIS];
+static atomic_int quantidade_aneis;
+static atomic_llong trechos_perdidos;
+
+static _Thread_local AnelCronologia *anel_atual;
+static _Thread_local int sem_anel;
+
+// O benchmark e as buscas paralelas criam threads novas a cada execução, então
+// o anel de uma thread que terminou passa para a próxima que precisar de um,
+// com os trechos antigos, e as duas dividem a mesma trilha
+static pthread_key_t chave_anel;
+static pthread_once_t chave_criada = PTHREAD_ONCE_INIT;
+
+static void devolver_anel(void *anel) {
+  atomic_store(&((AnelCronologia *)anel)->livre, 1);
+}
+
+static void criar_chave() {
+  pthread_key_create(&chave_anel, devolver_anel);
+}
+
+static AnelCronologia *obter_anel() {
+  if (anel_atual != NULL || sem_anel) {
+    return anel_atual;
+  }
+
+  pthread_once(&chave_criada, criar_chave);
+
+  const int quantidade = min(atomic_load(&quantidade_aneis), MAXIMO_ANEIS);
+  for (int i = 0; i < quantidade; ++i) {
+    if (aneis[i] != NULL && atomic_exchange(&aneis[i]->livre, 0)) {
+      anel_atual = aneis[i];
+      pthread_setspecific(chave_anel, anel_atual);
+      return anel_atual;
+    }
+  }
+
+  const int indice = atomic_fetch_add(&quantidade_aneis, 1);
+  if (indice >= MAXIMO_ANEIS) {
+    sem_anel = 1;
+    return NULL;
+  }
+
+  anel_atual = calloc(1, sizeof(AnelCronologia));
+  if (anel_atual == NULL) {
+    erro(L"Falha ao alocar memória para a cronologia.");
+  }
+
+  aneis[indice] = anel_atual;
+  pthread_setspecific(chave_anel, anel_atual);
+  return anel_atual;
+}
+
+Trecho comecar_trecho(const char *nome) {
+  if (!cronologia_ativa) {
+    return (Trecho){ nome, -1 };
+  }
+
+  // O anel é pego já no começo, para threads que rodam ao mesmo tempo nunca
+  // dividirem a mesma trilha
+  obter_anel();
+  return (Trecho){ nome, tempo_monotonico() };
+}
+
+void terminar_trecho(Trecho trecho) {
+  if (trecho.inicio < 0) {
+    return;
+  }
+
+  const double fim     = tempo_monotonico();
+  AnelCronologia *anel = obter_anel();
+
+  if (anel == NULL) {
+    atomic_fetch_add_explicit(&trechos_perdidos, 1, memory_order_relaxed);
+    return;
+  }
+
+  anel->eventos[anel->escritos++ % EVENTOS_POR_ANEL] = (EventoCronologia){ trecho.nome, trecho.inicio, fim };
+}
+
+/**
+ * Escreve os anéis como eventos completos ("X") do formato do Chrome, uma
+ * trilha por thread, na ordem em que as threads gravaram o primeiro trecho.
+ */
+static void escrever_cronologia() {
+  FILE *arquivo = fopen(arquivo_cronologia, "w");
+  if (arquivo == NULL) {
+    fwprintf(stderr, L"Não foi possível criar o arquivo da cronologia.\n");
+    return;
+  }
+
+  const int quantidade   = min(atomic_load(&quantidade_aneis), MAXIMO_ANEIS);
+  long long sobrescritos = 0;
+
+  fprintf(arquivo, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(arquivo, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"labirintite\"}}");
+
+  for (int t = 0; t < quantidade; ++t) {
+    const AnelCronologia *anel = aneis[t];
+    if (anel == NULL) {
+      continue;
+    }
+
+    const unsigned long long fim = anel->escritos;
+    unsigned long long primeiro  = fim > EVENTOS_POR_ANEL ? fim - EVENTOS_POR_ANEL : 0;
+
+    char nome[32] = "principal";
+    if (t > 0) {
+      snprintf(nome, sizeof nome, "thread %d", t);
+    }
+
+    sobrescritos += primeiro;
+    fprintf(arquivo, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", t, nome);
+
+    for (; primeiro < fim; ++primeiro) {
+      const EventoCronologia *evento = &anel->eventos[primeiro % EVENTOS_POR_ANEL];
+      fprintf(arquivo, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", evento->nome, t,
+              (evento->inicio - inicio_cronologia) * 1e6, (evento->fim - evento->inicio) * 1e6);
+    }
+  }
+
+  fprintf(arquivo, "\n],\"otherData\":{\"trechos_sobrescritos\":%lld,\"trechos_perdidos\":%lld}}\n", sobrescritos,
+          atomic_load(&trechos_perdidos));
+  fclose(arquivo);
+}
+
+void iniciar_cronologia(const char *nome) {
+  arquivo_cronologia = nome;
+  inicio_cronologia  = tempo_monotonico();
+  cronologia_ativa   = 1;
+  atexit(escrever_cronologia);
+}
@@ -0,0 +1,145 @@
+/*
+ * desempenho.c - Contadores de hardware do processador via perf_event_open
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/desempenho.h"
+
+#include <string.h>
+
+const wchar_t *nomes_eventos_hw[QUANTIDADE_EVENTOS_HW]  = { L"ciclos", L"instruções", L"faltas L1", L"faltas LLC", L"desvios errados", L"faltas dTLB" };
+const wchar_t *chaves_eventos_hw[QUANTIDADE_EVENTOS_HW] = { L"ciclos", L"instrucoes", L"faltas_l1", L"faltas_llc", L"desvios_errados", L"faltas_dtlb" };
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define CACHE_LEITURA_FALTA(cache) ((cache) | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+
+static const struct {
+  uint32_t tipo;
+  uint64_t configuracao;
+} eventos[QUANTIDADE_EVENTOS_HW] = {
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { PERF_TYPE_HW_CACHE, CACHE_LEITURA_FALTA(PERF_COUNT_HW_CACHE_L1D) },
+  { PERF_TYPE_HW_CACHE, CACHE_LEITURA_FALTA(PERF_COUNT_HW_CACHE_LL) },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { PERF_TYPE_HW_CACHE, CACHE_LEITURA_FALTA(PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+int abrir_medidor(Medidor *medidor) {
+  medidor->disponiveis = 0;
+
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+
+    atributos.size           = sizeof(atributos);
+    atributos.type           = eventos[i].tipo;
+    atributos.config         = eventos[i].configuracao;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv     = 1;
+    atributos.inherit        = 1; // Soma as threads dos resolvedores paralelos quando elas terminam
+    atributos.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    medidor->descritores[i] = syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+    medidor->disponiveis += medidor->descritores[i] >= 0;
+  }
+
+  return medidor->disponiveis;
+}
+
+void ler_medidor(const Medidor *medidor, LeituraHw *leitura) {
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    uint64_t valores[3];
+    leitura->valores[i] = -1;
+
+    // Um medidor zerado, que nunca foi aberto, não tem descritores válidos
+    if (!medidor->disponiveis || medidor->descritores[i] < 0 || read(medidor->descritores[i], valores, sizeof(valores)) != sizeof(valores)) {
+      continue;
+    }
+
+    const double proporcao = valores[2] > 0 && valores[2] < valores[1] ? (double)valores[1] / valores[2] : 1.0;
+    leitura->valores[i]    = (long long)(valores[0] * proporcao);
+  }
+}
+
+void fechar_medidor(Medidor *medidor) {
+  for (int i = 0; medidor->disponiveis && i < QUANTIDADE_EVENTOS_HW; ++i) {
+    if (medidor->descritores[i] >= 0) {
+      close(medidor->descritores[i]);
+      medidor->descritores[i] = -1;
+    }
+  }
+  medidor->disponiveis = 0;
+}
+
+void explicar_medidor_indisponivel(FILE *saida) {
+  int paranoia       = -1;
+  FILE *configuracao = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+
+  if (configuracao != NULL) {
+    if (fscanf(configuracao, "%d", &paranoia) != 1) {
+      paranoia = -1;
+    }
+    fclose(configuracao);
+  }
+
+  if (paranoia > 2) {
+    fwprintf(saida, L"Contadores de hardware indisponíveis: perf_event_paranoid = %d bloqueia o acesso (tente 2 ou menos).\n", paranoia);
+  } else {
+    fwprintf(saida, L"Contadores de hardware indisponíveis: o processador ou a máquina virtual não os expõe.\n");
+  }
+}
+
+#else
+
+int abrir_medidor(Medidor *medidor) {
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    medidor->descritores[i] = -1;
+  }
+  medidor->disponiveis = 0;
+  return 0;
+}
+
+void ler_medidor(const Medidor *medidor, LeituraHw *leitura) {
+  (void)medidor;
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    leitura->valores[i] = -1;
+  }
+}
+
+void fechar_medidor(Medidor *medidor) {
+  medidor->disponiveis = 0;
+}
+
+void explicar_medidor_indisponivel(FILE *saida) {
+  fwprintf(saida, L"Contadores de hardware indisponíveis: só existem no Linux, via perf_event_open.\n");
+}
+
+#endif
+
+void acumular_leitura(LeituraHw *total, const LeituraHw *fim, const LeituraHw *inicio) {
+  for (int i = 0; i < QUANTIDADE_EVENTOS_HW; ++i) {
+    total->valores[i] = fim->valores[i] < 0 || inicio->valores[i] < 0 ? -1 : max(total->valores[i], 0) + fim->valores[i] - inicio->valores[i];
+  }
+}
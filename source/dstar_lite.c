@@ -0,0 +1,266 @@
+/*
+ * dstar_lite.c - Replanejamento incremental com D* Lite
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/dstar_lite.h"
+#include "include/busca.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#define INFINITO (INT_MAX / 2)
+#define FORA_DA_LISTA -1LL
+
+// As chaves do D* Lite são pares comparados em ordem lexicográfica; como as
+// duas partes cabem em 32 bits, elas viram um único custo da heap
+#define juntar_chave(k1, k2) (((long long)(k1) << 32) | (k2))
+
+static int heuristica(const DStarLite *planejador, int de, int para) {
+  const int a[2] = { de / planejador->colunas, de % planejador->colunas };
+  const int b[2] = { para / planejador->colunas, para % planejador->colunas };
+
+  return distancia_no_labirinto(planejador->labirinto, a, b);
+}
+
+static long long calcular_chave(const DStarLite *planejador, int celula) {
+  const int menor = min(planejador->g[celula], planejador->rhs[celula]);
+  return juntar_chave(menor + heuristica(planejador, planejador->origem, celula) + planejador->km, menor);
+}
+
+/**
+ * Preenche `vizinhos` com as células vizinhas dentro do labirinto. Como o
+ * custo de um passo é o custo da célula em que ele entra, os vizinhos servem
+ * tanto de sucessores quanto de antecessores.
+ *
+ * @return A quantidade de vizinhos.
+ */
+static int listar_vizinhos(const DStarLite *planejador, int celula, int vizinhos[6]) {
+  const int linha = celula / planejador->colunas, coluna = celula % planejador->colunas;
+  int quantidade  = 0;
+
+  for (int i = 0; i < direcoes_do_labirinto(planejador->labirinto); ++i) {
+    int vizinha[2];
+
+    if (vizinha_na_direcao(planejador->labirinto, linha, coluna, i, vizinha)) {
+      vizinhos[quantidade++] = vizinha[0] * planejador->colunas + vizinha[1];
+    }
+  }
+
+  return quantidade;
+}
+
+/**
+ * Recalcula o rhs da célula (o melhor custo até a saída passando por um
+ * vizinho) e a coloca na lista aberta se ela ficou inconsistente.
+ */
+static void atualizar_celula(DStarLite *planejador, int celula) {
+  if (celula != planejador->saida) {
+    int vizinhos[6], melhor = INFINITO;
+    const int quantidade    = listar_vizinhos(planejador, celula, vizinhos);
+
+    for (int i = 0; i < quantidade; ++i) {
+      if (planejador->custos[vizinhos[i]] >= 0 && planejador->g[vizinhos[i]] < INFINITO) {
+        melhor = min(melhor, planejador->custos[vizinhos[i]] + planejador->g[vizinhos[i]]);
+      }
+    }
+    planejador->rhs[celula] = melhor;
+  }
+
+  if (planejador->g[celula] == planejador->rhs[celula]) {
+    planejador->chaves[celula] = FORA_DA_LISTA;
+    return;
+  }
+
+  // A entrada antiga, se houver, fica na heap e é descartada quando sair
+  const long long chave      = calcular_chave(planejador, celula);
+  planejador->chaves[celula] = chave;
+  inserir_heap(&planejador->abertos, (ItemHeap){ .custo = chave, .peso = 0, .indice = celula });
+}
+
+static void atualizar_vizinhos(DStarLite *planejador, int celula) {
+  int vizinhos[6];
+  const int quantidade = listar_vizinhos(planejador, celula, vizinhos);
+
+  for (int i = 0; i < quantidade; ++i) {
+    atualizar_celula(planejador, vizinhos[i]);
+  }
+}
+
+/**
+ * Tira do topo da heap as entradas que não valem mais, porque a célula saiu
+ * da lista ou foi recolocada com outra chave.
+ */
+static int topo_valido(DStarLite *planejador) {
+  while (planejador->abertos.tamanho > 0) {
+    const ItemHeap topo = planejador->abertos.itens[0];
+
+    if (planejador->chaves[topo.indice] == topo.custo) {
+      return 1;
+    }
+    remover_heap(&planejador->abertos);
+  }
+  return 0;
+}
+
+void iniciar_dstar_lite(DStarLite *planejador, const Labirinto *labirinto, int origem[2], int penalidade) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+
+  planejador->labirinto     = labirinto;
+  planejador->linhas        = linhas;
+  planejador->colunas       = colunas;
+  planejador->penalidade    = penalidade;
+  planejador->origem        = origem[0] * colunas + origem[1];
+  planejador->ultima_origem = planejador->origem;
+  planejador->saida         = labirinto->posicao_saida[0] * colunas + labirinto->posicao_saida[1];
+  planejador->km            = 0;
+  planejador->expansoes     = 0;
+  planejador->custos        = malloc(linhas * colunas * sizeof(int));
+  planejador->g             = malloc(linhas * colunas * sizeof(int));
+  planejador->rhs           = malloc(linhas * colunas * sizeof(int));
+  planejador->chaves        = malloc(linhas * colunas * sizeof(long long));
+
+  if (planejador->custos == NULL || planejador->g == NULL || planejador->rhs == NULL || planejador->chaves == NULL) {
+    erro(L"Falha ao alocar memória para o D* Lite.");
+  }
+
+  for (int i = 0; i < linhas * colunas; ++i) {
+    planejador->custos[i] = custo_celula(labirinto, penalidade, i / colunas, i % colunas);
+    planejador->g[i]      = INFINITO;
+    planejador->rhs[i]    = INFINITO;
+    planejador->chaves[i] = FORA_DA_LISTA;
+  }
+
+  criar_heap(&planejador->abertos, linhas + colunas);
+
+  planejador->rhs[planejador->saida]    = 0;
+  planejador->chaves[planejador->saida] = calcular_chave(planejador, planejador->saida);
+  inserir_heap(&planejador->abertos, (ItemHeap){ .custo = planejador->chaves[planejador->saida], .peso = 0, .indice = planejador->saida });
+}
+
+void marcar_celula_alterada(DStarLite *planejador, int posicao[2], char celula) {
+  const int indice = posicao[0] * planejador->colunas + posicao[1];
+  const int custo  = custo_passo(celula, planejador->penalidade);
+
+  if (custo == planejador->custos[indice]) {
+    return;
+  }
+
+  // Só os passos que entram na célula mudaram de custo, e eles saem dos vizinhos
+  planejador->custos[indice] = custo;
+  atualizar_vizinhos(planejador, indice);
+}
+
+void mover_origem_dstar(DStarLite *planejador, int origem[2]) {
+  const int nova = origem[0] * planejador->colunas + origem[1];
+
+  planejador->km += heuristica(planejador, planejador->ultima_origem, nova);
+  planejador->ultima_origem = nova;
+  planejador->origem        = nova;
+}
+
+static void calcular_menor_caminho(DStarLite *planejador) {
+  const int origem = planejador->origem;
+
+  while (topo_valido(planejador) &&
+         (planejador->abertos.itens[0].custo < calcular_chave(planejador, origem) || planejador->rhs[origem] != planejador->g[origem])) {
+    const ItemHeap topo        = remover_heap(&planejador->abertos);
+    const int celula           = topo.indice;
+    const long long chave_nova = calcular_chave(planejador, celula);
+
+    planejador->expansoes++;
+
+    if (topo.custo < chave_nova) {
+      planejador->chaves[celula] = chave_nova;
+      inserir_heap(&planejador->abertos, (ItemHeap){ .custo = chave_nova, .peso = 0, .indice = celula });
+    } else if (planejador->g[celula] > planejador->rhs[celula]) {
+      planejador->g[celula]      = planejador->rhs[celula];
+      planejador->chaves[celula] = FORA_DA_LISTA;
+      atualizar_vizinhos(planejador, celula);
+    } else {
+      planejador->g[celula] = INFINITO;
+      atualizar_celula(planejador, celula);
+      atualizar_vizinhos(planejador, celula);
+    }
+  }
+}
+
+int replanejar(DStarLite *planejador, Caminho *caminho) {
+  calcular_menor_caminho(planejador);
+
+  const int custo = planejador->rhs[planejador->origem];
+  if (custo >= INFINITO) {
+    return -1;
+  }
+
+  if (caminho == NULL) {
+    return custo;
+  }
+
+  // Com a busca consistente, basta descer pelo vizinho de menor custo + g
+  int capacidade    = 64;
+  caminho->direcoes = malloc(capacidade * sizeof(int));
+  caminho->tamanho  = 0;
+  caminho->custo    = custo;
+
+  if (caminho->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o caminho.");
+  }
+
+  for (int atual = planejador->origem; atual != planejador->saida;) {
+    int vizinhos[6], proximo = -1, melhor = INFINITO;
+    const int quantidade = listar_vizinhos(planejador, atual, vizinhos);
+
+    for (int i = 0; i < quantidade; ++i) {
+      const int v = vizinhos[i];
+      if (planejador->custos[v] >= 0 && planejador->g[v] < INFINITO && planejador->custos[v] + planejador->g[v] < melhor) {
+        melhor  = planejador->custos[v] + planejador->g[v];
+        proximo = v;
+      }
+    }
+
+    if (caminho->tamanho == capacidade) {
+      capacidade *= 2;
+      caminho->direcoes = realloc(caminho->direcoes, capacidade * sizeof(int));
+
+      if (caminho->direcoes == NULL) {
+        erro(L"Falha ao alocar memória para o caminho.");
+      }
+    }
+
+    caminho->direcoes[caminho->tamanho++] = direcao_entre(atual, proximo, planejador->colunas);
+    atual                                 = proximo;
+  }
+
+  return custo;
+}
+
+void liberar_dstar_lite(DStarLite *planejador) {
+  liberar_heap(&planejador->abertos);
+  free(planejador->custos);
+  free(planejador->g);
+  free(planejador->rhs);
+  free(planejador->chaves);
+  planejador->custos = NULL;
+  planejador->g      = NULL;
+  planejador->rhs    = NULL;
+  planejador->chaves = NULL;
+}
@@ -0,0 +1,257 @@
+/*
+ * estatisticas.c - Contadores dos resolvedores e o relatório do --stats
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/estatisticas.h"
+#include "include/os.h"
+#include "include/util.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+static FormatoRelatorio formato_relatorio;
+static int hardware_pedido;
+
+#ifdef CONTADORES
+
+_Thread_local Estatisticas estatisticas_atuais;
+
+static _Thread_local Fase fase_atual = FASE_NENHUMA;
+static _Thread_local double inicio_fase;
+
+// Só a thread que pediu o relatório lê os contadores do processador
+static Medidor medidor;
+static _Thread_local int medindo_hardware;
+static _Thread_local LeituraHw leitura_fase;
+
+static Estatisticas sessao;
+static Estatisticas *execucoes;
+static int quantidade_execucoes;
+
+static const wchar_t *nomes_fases[QUANTIDADE_FASES] = { L"carga", L"preparo", L"busca", L"caminho", L"desenho", L"espera" };
+
+/**
+ * Os contadores na ordem do relatório, com o deslocamento de cada um dentro
+ * da estrutura, para a tabela e o JSON percorrerem a mesma lista.
+ */
+static const struct {
+  const wchar_t *nome;
+  const wchar_t *chave;
+  size_t deslocamento;
+} contadores[] = {
+  { L"Nós expandidos", L"nos_expandidos", offsetof(Estatisticas, nos_expandidos) },
+  { L"Inserções", L"insercoes", offsetof(Estatisticas, insercoes) },
+  { L"Remoções", L"remocoes", offsetof(Estatisticas, remocoes) },
+  { L"Maior fronteira", L"maior_fronteira", offsetof(Estatisticas, maior_fronteira) },
+  { L"Retrocessos", L"retrocessos", offsetof(Estatisticas, retrocessos) },
+  { L"Restaurações", L"restauracoes", offsetof(Estatisticas, restauracoes) },
+  { L"Alocações", L"alocacoes", offsetof(Estatisticas, alocacoes) },
+  { L"Quadros", L"quadros", offsetof(Estatisticas, quadros) },
+  { L"Caracteres desenhados", L"caracteres_desenhados", offsetof(Estatisticas, caracteres_desenhados) },
+  { L"Células desenhadas", L"celulas_desenhadas", offsetof(Estatisticas, celulas_desenhadas) },
+};
+
+#define QUANTIDADE_CONTADORES (int)(sizeof(contadores) / sizeof(contadores[0]))
+#define valor_contador(estatisticas, i) (*(const long long *)((const char *)(estatisticas) + contadores[i].deslocamento))
+
+Fase entrar_fase(Fase fase) {
+  const double agora  = tempo_monotonico();
+  const Fase anterior = fase_atual;
+
+  if (anterior != FASE_NENHUMA) {
+    estatisticas_atuais.tempo[anterior] += agora - inicio_fase;
+  }
+
+  if (medindo_hardware) {
+    LeituraHw leitura;
+    ler_medidor(&medidor, &leitura);
+    if (anterior != FASE_NENHUMA) {
+      acumular_leitura(&estatisticas_atuais.hardware[anterior], &leitura, &leitura_fase);
+    }
+    leitura_fase = leitura;
+  }
+
+  fase_atual  = fase;
+  inicio_fase = agora;
+  return anterior;
+}
+
+static void acumular(Estatisticas *destino, const Estatisticas *origem) {
+  for (int i = 0; i < QUANTIDADE_CONTADORES; ++i) {
+    *(long long *)((char *)destino + contadores[i].deslocamento) += valor_contador(origem, i);
+  }
+  for (int i = 0; i < QUANTIDADE_FASES; ++i) {
+    destino->tempo[i] += origem->tempo[i];
+  }
+}
+
+void iniciar_execucao(const char *resolvedor) {
+  entrar_fase(FASE_NENHUMA);
+  acumular(&sessao, &estatisticas_atuais);
+
+  estatisticas_atuais            = (Estatisticas){ 0 };
+  estatisticas_atuais.resolvedor = resolvedor;
+}
+
+void terminar_execucao() {
+  entrar_fase(FASE_NENHUMA);
+
+  Estatisticas *novas = realloc(execucoes, (quantidade_execucoes + 1) * sizeof(Estatisticas));
+  if (novas == NULL) {
+    erro(L"Falha ao alocar memória para as estatísticas.");
+  }
+
+  execucoes                         = novas;
+  execucoes[quantidade_execucoes++] = estatisticas_atuais;
+  estatisticas_atuais               = (Estatisticas){ 0 };
+}
+
+/**
+ * Um evento do processador numa fase, dividido pelos nós expandidos ou, no
+ * desenho, pelas células desenhadas. Negativo quando não há o que dividir.
+ */
+static double razao_hardware(const Estatisticas *estatisticas, Fase fase, EventoHw evento) {
+  const long long valor   = estatisticas->hardware[fase].valores[evento];
+  const long long divisor = fase == FASE_DESENHO ? estatisticas->celulas_desenhadas : estatisticas->nos_expandidos;
+  return valor < 0 || divisor <= 0 ? -1 : (double)valor / divisor;
+}
+
+static void imprimir_tabela() {
+  fwprintf(stderr, L"\n%-24ls", L"Estatísticas");
+  for (int j = 0; j < quantidade_execucoes; ++j) {
+    fwprintf(stderr, L" %14s", execucoes[j].resolvedor);
+  }
+  fwprintf(stderr, L"\n");
+
+  for (int i = 0; i < QUANTIDADE_CONTADORES; ++i) {
+    fwprintf(stderr, L"%-24ls", contadores[i].nome);
+    for (int j = 0; j < quantidade_execucoes; ++j) {
+      fwprintf(stderr, L" %14lld", valor_contador(&execucoes[j], i));
+    }
+    fwprintf(stderr, L"\n");
+  }
+
+  for (int f = FASE_PREPARO; f < QUANTIDADE_FASES; ++f) {
+    fwprintf(stderr, L"Tempo de %-15ls", nomes_fases[f]);
+    for (int j = 0; j < quantidade_execucoes; ++j) {
+      fwprintf(stderr, L" %11.3f ms", execucoes[j].tempo[f] * 1e3);
+    }
+    fwprintf(stderr, L"\n");
+  }
+
+  fwprintf(stderr, L"Carga do labirinto: %.3f ms\n", sessao.tempo[FASE_CARGA] * 1e3);
+
+  if (hardware_pedido && !medidor.disponiveis) {
+    explicar_medidor_indisponivel(stderr);
+    return;
+  }
+
+  for (int f = FASE_PREPARO; hardware_pedido && f <= FASE_DESENHO; ++f) {
+    fwprintf(stderr, L"\nHardware: %ls, por %ls\n", nomes_fases[f], f == FASE_DESENHO ? L"célula desenhada" : L"nó expandido");
+    for (int e = 0; e < QUANTIDADE_EVENTOS_HW; ++e) {
+      fwprintf(stderr, L"%-24ls", nomes_eventos_hw[e]);
+      for (int j = 0; j < quantidade_execucoes; ++j) {
+        const double valor = razao_hardware(&execucoes[j], f, e);
+        if (valor < 0) {
+          fwprintf(stderr, L" %14ls", L"-");
+        } else {
+          fwprintf(stderr, L" %14.3f", valor);
+        }
+      }
+      fwprintf(stderr, L"\n");
+    }
+  }
+}
+
+static void imprimir_json() {
+  fwprintf(stderr, L"{\"carga_ms\":%.3f,\"execucoes\":[", sessao.tempo[FASE_CARGA] * 1e3);
+
+  for (int j = 0; j < quantidade_execucoes; ++j) {
+    fwprintf(stderr, L"%ls{\"resolvedor\":\"%s\"", j ? L"," : L"", execucoes[j].resolvedor);
+    for (int i = 0; i < QUANTIDADE_CONTADORES; ++i) {
+      fwprintf(stderr, L",\"%ls\":%lld", contadores[i].chave, valor_contador(&execucoes[j], i));
+    }
+
+    fwprintf(stderr, L",\"tempo_ms\":{");
+    for (int f = FASE_PREPARO; f < QUANTIDADE_FASES; ++f) {
+      fwprintf(stderr, L"%ls\"%ls\":%.3f", f > FASE_PREPARO ? L"," : L"", nomes_fases[f], execucoes[j].tempo[f] * 1e3);
+    }
+    fwprintf(stderr, L"}");
+
+    // Os eventos indisponíveis ficam de fora, em vez de aparecerem como -1
+    for (int f = FASE_PREPARO; medidor.disponiveis && f <= FASE_DESENHO; ++f) {
+      fwprintf(stderr, L"%ls\"%ls\":{\"%ls\":{", f > FASE_PREPARO ? L"," : L",\"hardware\":{", nomes_fases[f],
+               f == FASE_DESENHO ? L"por_celula" : L"por_no");
+      for (int e = 0, primeiro = 1; e < QUANTIDADE_EVENTOS_HW; ++e) {
+        const double valor = razao_hardware(&execucoes[j], f, e);
+        if (valor >= 0) {
+          fwprintf(stderr, L"%ls\"%ls\":%.3f", primeiro ? L"" : L",", chaves_eventos_hw[e], valor);
+          primeiro = 0;
+        }
+      }
+      fwprintf(stderr, L"}}%ls", f == FASE_DESENHO ? L"}" : L"");
+    }
+    fwprintf(stderr, L"}");
+  }
+
+  fwprintf(stderr, L"]}\n");
+}
+
+static void imprimir_relatorio() {
+  // Uma resolução interrompida com Ctrl+C entra no relatório até onde chegou
+  if (estatisticas_atuais.resolvedor != NULL) {
+    terminar_execucao();
+  } else {
+    entrar_fase(FASE_NENHUMA);
+    acumular(&sessao, &estatisticas_atuais);
+  }
+
+  if (formato_relatorio == RELATORIO_JSON) {
+    imprimir_json();
+  } else {
+    imprimir_tabela();
+  }
+
+  free(execucoes);
+  fechar_medidor(&medidor);
+}
+
+#else
+
+static void imprimir_relatorio() {
+  (void)formato_relatorio;
+  (void)hardware_pedido;
+  fwprintf(stderr, L"\nO programa foi compilado sem contadores; compile com `make CONTADORES=1` para ter as estatísticas.\n");
+}
+
+#endif
+
+void relatar_estatisticas_ao_sair(FormatoRelatorio formato, int com_hardware) {
+  formato_relatorio = formato;
+  hardware_pedido   = com_hardware;
+
+#ifdef CONTADORES
+  if (com_hardware) {
+    medindo_hardware = abrir_medidor(&medidor) > 0;
+  }
+#endif
+
+  atexit(imprimir_relatorio);
+}
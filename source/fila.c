@@ -0,0 +1,71 @@
+/*
+ * fila.c - Fila sem travas com vários produtores e um consumidor
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/fila.h"
+
+#include <stddef.h>
+
+void criar_fila(FilaMPSC *fila) {
+  atomic_store_explicit(&fila->sentinela.proximo, NULL, memory_order_relaxed);
+  atomic_store_explicit(&fila->entrada, &fila->sentinela, memory_order_relaxed);
+  fila->saida = &fila->sentinela;
+}
+
+void inserir_fila(FilaMPSC *fila, NoFila *no) {
+  atomic_store_explicit(&no->proximo, NULL, memory_order_relaxed);
+  NoFila *anterior = atomic_exchange_explicit(&fila->entrada, no, memory_order_acq_rel);
+  atomic_store_explicit(&anterior->proximo, no, memory_order_release);
+}
+
+NoFila *remover_fila(FilaMPSC *fila) {
+  NoFila *saida   = fila->saida;
+  NoFila *proximo = atomic_load_explicit(&saida->proximo, memory_order_acquire);
+
+  // A sentinela nunca é entregue, só marca a fila vazia
+  if (saida == &fila->sentinela) {
+    if (proximo == NULL) {
+      return NULL;
+    }
+    fila->saida = proximo;
+    saida       = proximo;
+    proximo     = atomic_load_explicit(&saida->proximo, memory_order_acquire);
+  }
+
+  if (proximo != NULL) {
+    fila->saida = proximo;
+    return saida;
+  }
+
+  // `saida` é o último nó; se um produtor estiver inserindo agora, esperamos
+  if (saida != atomic_load_explicit(&fila->entrada, memory_order_acquire)) {
+    return NULL;
+  }
+
+  inserir_fila(fila, &fila->sentinela);
+  proximo = atomic_load_explicit(&saida->proximo, memory_order_acquire);
+
+  if (proximo != NULL) {
+    fila->saida = proximo;
+    return saida;
+  }
+
+  return NULL;
+}
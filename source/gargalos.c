@@ -0,0 +1,303 @@
+/*
+ * gargalos.c - Articulações e pontes de Tarjan e a busca por trechos
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/gargalos.h"
+#include "include/busca.h"
+#include "include/cronologia.h"
+#include "include/mem.h"
+#include "include/util.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MARCA_ARTICULACAO 1
+#define MARCA_PONTE 2 // A aresta entre a célula e o pai dela na árvore é uma ponte
+#define MARCA_CONTORNO 4 // Alguma saída abaixo da célula é alcançável sem passar por ela
+
+/**
+ * Separa as células marcadas com uma marca numa lista nova.
+ *
+ * @param quantidade Recebe o tamanho da lista.
+ * @param pares Boolean, se cada célula entra junto com o pai, como nas pontes.
+ */
+static int *coletar_marcadas(const uint8_t *marcas, const int *pais, int celulas, uint8_t marca, int pares, int *quantidade) {
+  *quantidade = 0;
+  for (int i = 0; i < celulas; ++i) {
+    *quantidade += (marcas[i] & marca) != 0;
+  }
+
+  int *lista = malloc(max(1, *quantidade * (pares ? 2 : 1)) * sizeof(int));
+  if (lista == NULL) {
+    erro(L"Falha ao alocar memória para os gargalos.");
+  }
+
+  for (int i = 0, j = 0; i < celulas; ++i) {
+    if (marcas[i] & marca) {
+      if (pares) {
+        lista[j++] = pais[i];
+      }
+      lista[j++] = i;
+    }
+  }
+  return lista;
+}
+
+void encontrar_gargalos(Gargalos *gargalos, const Labirinto *labirinto, int com_inimigos, int origem[2]) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+  const int celulas = linhas * colunas;
+  const int raiz    = origem[0] * colunas + origem[1];
+  char **matriz     = labirinto->matriz_inicial;
+
+  const int quantidade_direcoes = direcoes_do_labirinto(labirinto);
+
+  int *descoberta   = malloc((size_t)celulas * sizeof(int));
+  int *menor        = malloc((size_t)celulas * sizeof(int));
+  int *pais         = malloc((size_t)celulas * sizeof(int));
+  int *pilha        = malloc((size_t)celulas * sizeof(int));
+  int *saidas       = calloc(celulas, sizeof(int));
+  uint8_t *direcoes = calloc(celulas, sizeof(uint8_t));
+  uint8_t *marcas   = calloc(celulas, sizeof(uint8_t));
+  if (descoberta == NULL || menor == NULL || pais == NULL || pilha == NULL || saidas == NULL || direcoes == NULL || marcas == NULL) {
+    erro(L"Falha ao alocar memória para os gargalos.");
+  }
+
+  memset(descoberta, 0xff, (size_t)celulas * sizeof(int));
+  memset(gargalos, 0, sizeof(Gargalos));
+  gargalos->calculados = 1;
+  gargalos->origem[0]  = origem[0];
+  gargalos->origem[1]  = origem[1];
+
+  const Trecho trecho = comecar_trecho("encontrar_gargalos");
+
+  int tempo = 0, topo = 0, filhos_raiz = 0;
+
+  descoberta[raiz] = menor[raiz] = tempo++;
+  pais[raiz]       = -1;
+  pilha[topo++]    = raiz;
+
+  // Cada célula fica na pilha até todas as direções serem tentadas;
+  // `direcoes` guarda a próxima, fazendo o papel do laço da versão recursiva
+  while (topo > 0) {
+    const int atual = pilha[topo - 1];
+
+    if (direcoes[atual] < quantidade_direcoes) {
+      const int d = direcoes[atual]++;
+      int posicao[2];
+
+      if (!vizinha_na_direcao(labirinto, atual / colunas, atual % colunas, d, posicao) || !passavel(matriz[posicao[0]][posicao[1]], com_inimigos)) {
+        continue;
+      }
+
+      const int vizinha = posicao[0] * colunas + posicao[1];
+      if (descoberta[vizinha] < 0) {
+        descoberta[vizinha] = menor[vizinha] = tempo++;
+        pais[vizinha]       = atual;
+        pilha[topo++]       = vizinha;
+        filhos_raiz += atual == raiz;
+      } else if (vizinha != pais[atual]) {
+        menor[atual] = min(menor[atual], descoberta[vizinha]);
+      }
+      continue;
+    }
+
+    topo--;
+    const int pai = pais[atual];
+    if (pai < 0) {
+      continue;
+    }
+
+    menor[pai] = min(menor[pai], menor[atual]);
+    if (pai != raiz && menor[atual] >= descoberta[pai]) {
+      marcas[pai] |= MARCA_ARTICULACAO;
+    }
+    if (menor[atual] > descoberta[pai]) {
+      marcas[atual] |= MARCA_PONTE;
+    }
+  }
+
+  // A raiz só é articulação se a árvore se dividir logo nela
+  if (filhos_raiz > 1) {
+    marcas[raiz] |= MARCA_ARTICULACAO;
+  }
+
+  gargalos->articulacoes     = coletar_marcadas(marcas, pais, celulas, MARCA_ARTICULACAO, 0, &gargalos->quantidade_articulacoes);
+  gargalos->pontes           = coletar_marcadas(marcas, pais, celulas, MARCA_PONTE, 1, &gargalos->quantidade_pontes);
+
+  // Um filho é descoberto depois do pai, então percorrer as células da última
+  // descoberta para a primeira soma as saídas de cada subárvore
+  for (int i = 0; i < celulas; ++i) {
+    if (descoberta[i] >= 0) {
+      pilha[descoberta[i]] = i;
+    }
+  }
+  for (int t = tempo - 1; t > 0; --t) {
+    const int atual = pilha[t], pai = pais[atual];
+
+    saidas[atual] += matriz[atual / colunas][atual % colunas] == SAIDA;
+    saidas[pai] += saidas[atual];
+    if (saidas[atual] > 0 && menor[atual] < descoberta[pai]) {
+      marcas[pai] |= MARCA_CONTORNO;
+    }
+  }
+  saidas[raiz] += matriz[origem[0]][origem[1]] == SAIDA;
+  gargalos->saida_alcancavel = saidas[raiz] > 0;
+
+  // Uma célula separa a origem de todas as saídas quando todas estão abaixo
+  // dela e nenhuma subárvore com saída tem aresta de volta acima dela. Essas
+  // células formam um caminho que desce da raiz, em ordem de descoberta
+  int quantidade = 0;
+  for (int t = 1; gargalos->saida_alcancavel && t < tempo; ++t) {
+    const int atual = pilha[t];
+
+    if (saidas[atual] == saidas[raiz] && matriz[atual / colunas][atual % colunas] != SAIDA && !(marcas[atual] & MARCA_CONTORNO)) {
+      pilha[quantidade++] = atual;
+    }
+  }
+
+  gargalos->obrigatorias            = malloc(max(1, quantidade) * sizeof(int));
+  gargalos->quantidade_obrigatorias = quantidade;
+  if (gargalos->obrigatorias == NULL) {
+    erro(L"Falha ao alocar memória para os gargalos.");
+  }
+  memcpy(gargalos->obrigatorias, pilha, quantidade * sizeof(int));
+
+  terminar_trecho(trecho);
+
+  free(descoberta);
+  free(menor);
+  free(pais);
+  free(pilha);
+  free(saidas);
+  free(direcoes);
+  free(marcas);
+}
+
+/**
+ * Os trechos de uma consulta dividida, que as threads pegam em ordem por um
+ * contador atômico. O trecho i vai de `pontos[i]` a `pontos[i + 1]`, e o
+ * último, de `pontos[quantidade - 1]` até a saída mais próxima.
+ */
+typedef struct {
+  const Labirinto *labirinto;
+  int penalidade;
+  int (*pontos)[2];
+  int quantidade;
+  Caminho *caminhos;
+  int *custos;
+  atomic_int proximo;
+} BuscaPorTrechos;
+
+static void *buscar_trechos(void *argumento) {
+  BuscaPorTrechos *busca = argumento;
+
+  for (int i = atomic_fetch_add(&busca->proximo, 1); i < busca->quantidade; i = atomic_fetch_add(&busca->proximo, 1)) {
+    TRECHO("buscar_trecho");
+    int *destino     = i + 1 < busca->quantidade ? busca->pontos[i + 1] : NULL;
+    busca->custos[i] = buscar_a_star(busca->labirinto, busca->pontos[i], destino, busca->penalidade,
+                                     busca->caminhos ? &busca->caminhos[i] : NULL);
+  }
+  return NULL;
+}
+
+int buscar_por_gargalos(const Gargalos *gargalos, const Labirinto *labirinto, int penalidade, int threads, Caminho *caminho) {
+  if (!gargalos->saida_alcancavel) {
+    return -1;
+  }
+
+  const int colunas      = labirinto->tamanho[1];
+  const int obrigatorias = gargalos->quantidade_obrigatorias;
+  const int trechos      = min(obrigatorias + 1, max(1, threads) * TRECHOS_POR_THREAD);
+
+  BuscaPorTrechos busca = { .labirinto = labirinto, .penalidade = penalidade, .quantidade = trechos };
+  busca.pontos          = malloc(trechos * sizeof(int[2]));
+  busca.custos          = malloc(trechos * sizeof(int));
+  busca.caminhos        = caminho ? calloc(trechos, sizeof(Caminho)) : NULL;
+  if (busca.pontos == NULL || busca.custos == NULL || (caminho && busca.caminhos == NULL)) {
+    erro(L"Falha ao alocar memória para os trechos.");
+  }
+  atomic_init(&busca.proximo, 0);
+
+  // Os pontos de corte são espalhados igualmente entre as células obrigatórias
+  busca.pontos[0][0] = gargalos->origem[0];
+  busca.pontos[0][1] = gargalos->origem[1];
+  for (int i = 1; i < trechos; ++i) {
+    const int celula   = gargalos->obrigatorias[(int)((long long)i * (obrigatorias + 1) / trechos) - 1];
+    busca.pontos[i][0] = celula / colunas;
+    busca.pontos[i][1] = celula % colunas;
+  }
+
+  const int quantidade_threads = min(max(1, threads), trechos);
+  pthread_t *ids               = malloc(quantidade_threads * sizeof(pthread_t));
+  if (ids == NULL) {
+    erro(L"Falha ao alocar memória para os trechos.");
+  }
+
+  // A thread atual também busca, então só as outras são criadas
+  for (int i = 1; i < quantidade_threads; ++i) {
+    if (pthread_create(&ids[i], NULL, buscar_trechos, &busca) != 0) {
+      erro(L"Falha ao criar as threads dos trechos.");
+    }
+  }
+  buscar_trechos(&busca);
+  for (int i = 1; i < quantidade_threads; ++i) {
+    pthread_join(ids[i], NULL);
+  }
+
+  int custo = 0, passos = 0;
+  for (int i = 0; i < trechos && custo >= 0; ++i) {
+    custo = busca.custos[i] < 0 ? -1 : custo + busca.custos[i];
+    passos += caminho ? busca.caminhos[i].tamanho : 0;
+  }
+
+  if (custo >= 0 && caminho) {
+    caminho->direcoes = malloc(max(1, passos) * sizeof(int));
+    caminho->tamanho  = 0;
+    caminho->custo    = custo;
+    if (caminho->direcoes == NULL) {
+      erro(L"Falha ao alocar memória para o caminho.");
+    }
+
+    for (int i = 0; i < trechos; ++i) {
+      memcpy(caminho->direcoes + caminho->tamanho, busca.caminhos[i].direcoes, busca.caminhos[i].tamanho * sizeof(int));
+      caminho->tamanho += busca.caminhos[i].tamanho;
+    }
+  }
+
+  for (int i = 0; caminho && i < trechos; ++i) {
+    liberar_caminho(&busca.caminhos[i]);
+  }
+  free(busca.caminhos);
+  free(busca.custos);
+  free(busca.pontos);
+  free(ids);
+  return custo;
+}
+
+void liberar_gargalos(Gargalos *gargalos) {
+  free(gargalos->articulacoes);
+  free(gargalos->pontes);
+  free(gargalos->obrigatorias);
+  memset(gargalos, 0, sizeof(Gargalos));
+}
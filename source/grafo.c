@@ -0,0 +1,317 @@
+/*
+ * grafo.c - Contração dos corredores num grafo de junções
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/grafo.h"
+#include "include/busca.h"
+#include "include/heap.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+/**
+ * Custo de entrar na vizinha de uma célula, ou -1 se ela não for passável ou
+ * não existir, como numa escada sem continuação.
+ */
+static int custo_vizinha(const Labirinto *labirinto, int penalidade, int linha, int coluna, int direcao) {
+  int vizinha[2];
+  if (!vizinha_na_direcao(labirinto, linha, coluna, direcao, vizinha)) {
+    return -1;
+  }
+  return custo_celula(labirinto, penalidade, vizinha[0], vizinha[1]);
+}
+
+static int contar_vizinhos(const Labirinto *labirinto, int penalidade, int linha, int coluna) {
+  int vizinhos = 0;
+  for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+    vizinhos += custo_vizinha(labirinto, penalidade, linha, coluna, i) >= 0;
+  }
+  return vizinhos;
+}
+
+/**
+ * Anda por um corredor a partir de `celula`, dando o primeiro passo na
+ * `direcao` e depois sempre seguindo a única saída que não volta, até chegar
+ * num vértice ou dar a volta e retornar à `celula`.
+ *
+ * @param peso Recebe a soma dos custos das células em que o percurso entrou.
+ * @param passos Recebe a quantidade de passos dados.
+ * @param direcoes Recebe as direções de cada passo, ou NULL.
+ * @return O índice da célula em que o percurso parou.
+ */
+static int percorrer_corredor(const GrafoJuncoes *grafo, const Labirinto *labirinto, int celula, int direcao, int *peso, int *passos,
+                              int *direcoes) {
+  int posicao[2] = { celula / grafo->colunas, celula % grafo->colunas };
+
+  *peso   = 0;
+  *passos = 0;
+
+  for (;;) {
+    avancar_posicao(labirinto, posicao, direcao);
+    const int linha = posicao[0], coluna = posicao[1];
+    *peso += custo_celula(labirinto, grafo->penalidade, linha, coluna);
+    if (direcoes) {
+      direcoes[*passos] = direcao;
+    }
+    (*passos)++;
+
+    const int atual = linha * grafo->colunas + coluna;
+    if (grafo->vertice_da_celula[atual] >= 0 || atual == celula) {
+      return atual;
+    }
+
+    // Num corredor só há uma saída além da que leva de volta
+    const int volta = inverter_posicao(direcao);
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      if (i != volta && custo_vizinha(labirinto, grafo->penalidade, linha, coluna, i) >= 0) {
+        direcao = i;
+        break;
+      }
+    }
+  }
+}
+
+void construir_grafo(GrafoJuncoes *grafo, const Labirinto *labirinto, int penalidade) {
+  grafo->linhas              = labirinto->tamanho[0];
+  grafo->colunas             = labirinto->tamanho[1];
+  grafo->penalidade          = penalidade;
+  grafo->quantidade_vertices = 0;
+  grafo->quantidade_arestas  = 0;
+
+  const int total          = grafo->linhas * grafo->colunas;
+  grafo->vertice_da_celula = malloc(total * sizeof(int));
+
+  if (grafo->vertice_da_celula == NULL) {
+    erro(L"Falha ao alocar memória para o grafo de junções.");
+  }
+
+  int saidas_totais = 0;
+  for (int i = 0; i < total; ++i) {
+    const int linha = i / grafo->colunas, coluna = i % grafo->colunas;
+    grafo->vertice_da_celula[i] = -1;
+
+    if (custo_celula(labirinto, penalidade, linha, coluna) < 0) {
+      continue;
+    }
+
+    // Toda saída vira vértice, para a busca poder parar em qualquer uma
+    const int vizinhos = contar_vizinhos(labirinto, penalidade, linha, coluna);
+    if (vizinhos != 2 || labirinto->matriz_inicial[linha][coluna] == SAIDA) {
+      grafo->vertice_da_celula[i] = grafo->quantidade_vertices++;
+      saidas_totais += vizinhos;
+    }
+  }
+
+  grafo->celulas  = malloc(max(1, grafo->quantidade_vertices) * sizeof(int));
+  grafo->inicio   = malloc((grafo->quantidade_vertices + 1) * sizeof(int));
+  grafo->destinos = malloc(max(1, saidas_totais) * sizeof(int));
+  grafo->pesos    = malloc(max(1, saidas_totais) * sizeof(int));
+  grafo->passos   = malloc(max(1, saidas_totais) * sizeof(int));
+  grafo->direcoes = malloc(max(1, saidas_totais) * sizeof(uint8_t));
+
+  if (grafo->celulas == NULL || grafo->inicio == NULL || grafo->destinos == NULL || grafo->pesos == NULL || grafo->passos == NULL ||
+      grafo->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o grafo de junções.");
+  }
+
+  for (int i = 0; i < total; ++i) {
+    if (grafo->vertice_da_celula[i] >= 0) {
+      grafo->celulas[grafo->vertice_da_celula[i]] = i;
+    }
+  }
+
+  for (int v = 0; v < grafo->quantidade_vertices; ++v) {
+    const int celula = grafo->celulas[v];
+    grafo->inicio[v] = grafo->quantidade_arestas;
+
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      if (custo_vizinha(labirinto, penalidade, celula / grafo->colunas, celula % grafo->colunas, i) < 0) {
+        continue;
+      }
+
+      int peso, passos;
+      const int fim = percorrer_corredor(grafo, labirinto, celula, i, &peso, &passos, NULL);
+
+      // Um corredor que volta para o próprio vértice nunca encurta caminho
+      if (fim == celula) {
+        continue;
+      }
+
+      const int aresta        = grafo->quantidade_arestas++;
+      grafo->destinos[aresta] = grafo->vertice_da_celula[fim];
+      grafo->pesos[aresta]    = peso;
+      grafo->passos[aresta]   = passos;
+      grafo->direcoes[aresta] = i;
+    }
+  }
+  grafo->inicio[grafo->quantidade_vertices] = grafo->quantidade_arestas;
+}
+
+void liberar_grafo(GrafoJuncoes *grafo) {
+  free(grafo->vertice_da_celula);
+  free(grafo->celulas);
+  free(grafo->inicio);
+  free(grafo->destinos);
+  free(grafo->pesos);
+  free(grafo->passos);
+  free(grafo->direcoes);
+  grafo->vertice_da_celula = NULL;
+  grafo->celulas           = NULL;
+  grafo->inicio            = NULL;
+  grafo->destinos          = NULL;
+  grafo->pesos             = NULL;
+  grafo->passos            = NULL;
+  grafo->direcoes          = NULL;
+}
+
+static int heuristica(const GrafoJuncoes *grafo, const Labirinto *labirinto, int celula) {
+  const int posicao[2] = { celula / grafo->colunas, celula % grafo->colunas };
+  return distancia_ate_saidas(labirinto, posicao);
+}
+
+/**
+ * Monta o caminho a partir das arestas usadas para chegar em cada vértice.
+ * `chegada[v]` é a aresta que levou ao vértice v, ou -1 - d quando v foi
+ * alcançado direto da origem dando o primeiro passo na direção d.
+ */
+static void expandir_caminho(const GrafoJuncoes *grafo, const Labirinto *labirinto, const int *chegada, const int *anterior, int origem,
+                             int alvo, int custo, Caminho *caminho) {
+  caminho->tamanho = 0;
+  caminho->custo   = custo;
+
+  int v = alvo, peso, passos;
+  for (; chegada[v] >= 0; v = anterior[v]) {
+    caminho->tamanho += grafo->passos[chegada[v]];
+  }
+
+  const int direcao_inicial = chegada[v] < -1 ? -chegada[v] - 2 : -1;
+  if (direcao_inicial >= 0) {
+    percorrer_corredor(grafo, labirinto, origem, direcao_inicial, &peso, &passos, NULL);
+    caminho->tamanho += passos;
+  }
+
+  caminho->direcoes = malloc(max(1, caminho->tamanho) * sizeof(int));
+  if (caminho->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o caminho.");
+  }
+
+  // As arestas são visitadas do fim para o começo, então o caminho também
+  int fim = caminho->tamanho;
+  for (v = alvo; chegada[v] >= 0; v = anterior[v]) {
+    const int aresta = chegada[v];
+    fim -= grafo->passos[aresta];
+    percorrer_corredor(grafo, labirinto, grafo->celulas[anterior[v]], grafo->direcoes[aresta], &peso, &passos, caminho->direcoes + fim);
+  }
+
+  if (direcao_inicial >= 0) {
+    percorrer_corredor(grafo, labirinto, origem, direcao_inicial, &peso, &passos, caminho->direcoes);
+  }
+}
+
+int buscar_no_grafo(const GrafoJuncoes *grafo, const Labirinto *labirinto, int origem[2], Caminho *caminho) {
+  const int celula_origem = origem[0] * grafo->colunas + origem[1];
+
+  if (labirinto->quantidade_saidas == 0) {
+    return -1;
+  }
+
+  int *pesos    = malloc(max(1, grafo->quantidade_vertices) * sizeof(int));
+  int *chegada  = malloc(max(1, grafo->quantidade_vertices) * sizeof(int));
+  int *anterior = malloc(max(1, grafo->quantidade_vertices) * sizeof(int));
+
+  if (pesos == NULL || chegada == NULL || anterior == NULL) {
+    erro(L"Falha ao alocar memória para a busca no grafo.");
+  }
+
+  for (int v = 0; v < grafo->quantidade_vertices; ++v) {
+    pesos[v] = INT_MAX;
+  }
+
+  Heap abertos;
+  criar_heap(&abertos, 64);
+
+  // Uma origem no meio de um corredor começa já nas duas pontas dele
+  if (grafo->vertice_da_celula[celula_origem] >= 0) {
+    const int v = grafo->vertice_da_celula[celula_origem];
+    pesos[v]    = 0;
+    chegada[v]  = -1;
+    inserir_heap(&abertos, (ItemHeap){ .custo = heuristica(grafo, labirinto, celula_origem), .peso = 0, .indice = v });
+  } else {
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      if (custo_vizinha(labirinto, grafo->penalidade, origem[0], origem[1], i) < 0) {
+        continue;
+      }
+
+      int peso, passos;
+      const int fim = percorrer_corredor(grafo, labirinto, celula_origem, i, &peso, &passos, NULL);
+      const int v   = grafo->vertice_da_celula[fim];
+
+      if (fim == celula_origem || peso >= pesos[v]) {
+        continue;
+      }
+
+      pesos[v]   = peso;
+      chegada[v] = -2 - i;
+      inserir_heap(&abertos, (ItemHeap){ .custo = peso + heuristica(grafo, labirinto, fim), .peso = peso, .indice = v });
+    }
+  }
+
+  int custo = -1, alvo = -1;
+
+  while (abertos.tamanho > 0) {
+    ItemHeap topo = remover_heap(&abertos);
+
+    if (topo.peso > pesos[topo.indice]) {
+      continue;
+    }
+
+    const int celula = grafo->celulas[topo.indice];
+    if (labirinto->matriz_inicial[celula / grafo->colunas][celula % grafo->colunas] == SAIDA) {
+      custo = topo.peso;
+      alvo  = topo.indice;
+      break;
+    }
+
+    for (int aresta = grafo->inicio[topo.indice]; aresta < grafo->inicio[topo.indice + 1]; ++aresta) {
+      const int v    = grafo->destinos[aresta];
+      const int peso = topo.peso + grafo->pesos[aresta];
+
+      if (peso >= pesos[v]) {
+        continue;
+      }
+
+      pesos[v]    = peso;
+      chegada[v]  = aresta;
+      anterior[v] = topo.indice;
+      inserir_heap(&abertos, (ItemHeap){ .custo = peso + heuristica(grafo, labirinto, grafo->celulas[v]), .peso = peso, .indice = v });
+    }
+  }
+
+  if (custo >= 0 && caminho) {
+    expandir_caminho(grafo, labirinto, chegada, anterior, celula_origem, alvo, custo, caminho);
+  }
+
+  liberar_heap(&abertos);
+  free(pesos);
+  free(chegada);
+  free(anterior);
+  return custo;
+}
@@ -0,0 +1,82 @@
+/*
+ * heap.c - Fila de prioridade (heap binária) usada pelos resolvedores
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/heap.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+
+#define antes(a, b) ((a).custo < (b).custo || ((a).custo == (b).custo && (a).peso > (b).peso))
+
+void criar_heap(Heap *heap, int capacidade) {
+  heap->capacidade = max(capacidade, 16);
+  heap->tamanho    = 0;
+  heap->itens      = malloc(heap->capacidade * sizeof(ItemHeap));
+
+  if (heap->itens == NULL) {
+    erro(L"Falha ao alocar memória para a heap.");
+  }
+}
+
+void liberar_heap(Heap *heap) {
+  free(heap->itens);
+  heap->itens   = NULL;
+  heap->tamanho = 0;
+}
+
+void inserir_heap(Heap *heap, ItemHeap item) {
+  if (heap->tamanho == heap->capacidade) {
+    heap->capacidade *= 2;
+    heap->itens = realloc(heap->itens, heap->capacidade * sizeof(ItemHeap));
+
+    if (heap->itens == NULL) {
+      erro(L"Falha ao aumentar a heap.");
+    }
+  }
+
+  int i = heap->tamanho++;
+  while (i > 0 && antes(item, heap->itens[(i - 1) / 2])) {
+    heap->itens[i] = heap->itens[(i - 1) / 2];
+    i              = (i - 1) / 2;
+  }
+  heap->itens[i] = item;
+}
+
+ItemHeap remover_heap(Heap *heap) {
+  ItemHeap topo   = heap->itens[0];
+  ItemHeap ultimo = heap->itens[--heap->tamanho];
+
+  int i = 0;
+  while (2 * i + 1 < heap->tamanho) {
+    int filho = 2 * i + 1;
+    if (filho + 1 < heap->tamanho && antes(heap->itens[filho + 1], heap->itens[filho])) {
+      filho++;
+    }
+    if (!antes(heap->itens[filho], ultimo)) {
+      break;
+    }
+    heap->itens[i] = heap->itens[filho];
+    i              = filho;
+  }
+  heap->itens[i] = ultimo;
+
+  return topo;
+}
@@ -0,0 +1,647 @@
+/*
+ * hierarquia.c - Busca hierárquica (HPA*) por agrupamentos de células
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/hierarquia.h"
+#include "include/busca.h"
+#include "include/heap.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#define AREA_AGRUPAMENTO (TAMANHO_AGRUPAMENTO * TAMANHO_AGRUPAMENTO)
+
+// Chaves do grafo abstrato além das células: a origem e a saída da consulta
+#define CHAVE_ORIGEM(h) ((h)->linhas * (h)->colunas)
+#define CHAVE_SAIDA(h) ((h)->linhas * (h)->colunas + 1)
+
+/**
+ * Uma tabela de espalhamento com endereçamento aberto para o estado do A*
+ * abstrato, para a consulta só pagar pelos nós que de fato visitar.
+ */
+typedef struct {
+  int chave;
+  int peso;
+  int pai;
+} EntradaTabela;
+
+typedef struct {
+  EntradaTabela *entradas;
+  int capacidade;
+  int quantidade;
+} Tabela;
+
+static void criar_tabela(Tabela *tabela, int capacidade) {
+  tabela->capacidade = capacidade;
+  tabela->quantidade = 0;
+  tabela->entradas   = malloc(capacidade * sizeof(EntradaTabela));
+
+  if (tabela->entradas == NULL) {
+    erro(L"Falha ao alocar memória para a busca hierárquica.");
+  }
+
+  for (int i = 0; i < capacidade; ++i) {
+    tabela->entradas[i].chave = -1;
+  }
+}
+
+static EntradaTabela *procurar_tabela(const Tabela *tabela, int chave) {
+  unsigned posicao = ((unsigned)chave * 2654435761u) & (tabela->capacidade - 1);
+
+  while (tabela->entradas[posicao].chave != -1 && tabela->entradas[posicao].chave != chave) {
+    posicao = (posicao + 1) & (tabela->capacidade - 1);
+  }
+
+  return &tabela->entradas[posicao];
+}
+
+/**
+ * Retorna a entrada da chave, criando-a com peso INT_MAX se ela não existir.
+ * A tabela dobra de tamanho ao ficar meio cheia.
+ */
+static EntradaTabela *obter_entrada(Tabela *tabela, int chave) {
+  EntradaTabela *entrada = procurar_tabela(tabela, chave);
+
+  if (entrada->chave == chave) {
+    return entrada;
+  }
+
+  if (2 * (tabela->quantidade + 1) > tabela->capacidade) {
+    Tabela maior;
+    criar_tabela(&maior, tabela->capacidade * 2);
+
+    for (int i = 0; i < tabela->capacidade; ++i) {
+      if (tabela->entradas[i].chave != -1) {
+        *procurar_tabela(&maior, tabela->entradas[i].chave) = tabela->entradas[i];
+      }
+    }
+
+    maior.quantidade = tabela->quantidade;
+    free(tabela->entradas);
+    *tabela = maior;
+    entrada = procurar_tabela(tabela, chave);
+  }
+
+  tabela->quantidade++;
+  *entrada = (EntradaTabela){ .chave = chave, .peso = INT_MAX, .pai = -1 };
+  return entrada;
+}
+
+static int agrupamento_de(const Hierarquia *hierarquia, int celula) {
+  const int linha = celula / hierarquia->colunas, coluna = celula % hierarquia->colunas;
+  return (linha / TAMANHO_AGRUPAMENTO) * hierarquia->agrupamentos_colunas + coluna / TAMANHO_AGRUPAMENTO;
+}
+
+/**
+ * Os limites do agrupamento: linhas [inicio[0], fim[0]) e colunas
+ * [inicio[1], fim[1]). Os agrupamentos da última linha e coluna podem ser
+ * menores que os outros.
+ */
+static void limites(const Hierarquia *hierarquia, int agrupamento, int inicio[2], int fim[2]) {
+  inicio[0] = (agrupamento / hierarquia->agrupamentos_colunas) * TAMANHO_AGRUPAMENTO;
+  inicio[1] = (agrupamento % hierarquia->agrupamentos_colunas) * TAMANHO_AGRUPAMENTO;
+  fim[0]    = min(inicio[0] + TAMANHO_AGRUPAMENTO, hierarquia->linhas);
+  fim[1]    = min(inicio[1] + TAMANHO_AGRUPAMENTO, hierarquia->colunas);
+}
+
+// Índice de uma célula dentro do seu agrupamento, para os vetores locais
+static int indice_local(const Hierarquia *hierarquia, int celula) {
+  return (celula / hierarquia->colunas % TAMANHO_AGRUPAMENTO) * TAMANHO_AGRUPAMENTO + celula % hierarquia->colunas % TAMANHO_AGRUPAMENTO;
+}
+
+/**
+ * Dijkstra preso ao agrupamento, a partir de uma célula. Ao contrário
+ * (`reverso`), `distancias` recebe o custo de cada célula *até* a origem, o
+ * que é usado para ligar os nós de um agrupamento com saídas até elas.
+ *
+ * @param origem A célula de partida, ou -1 para partir de todas as saídas do agrupamento.
+ * @param distancias Vetor de AREA_AGRUPAMENTO posições, indexado por `indice_local`.
+ * @param pais Vetor de AREA_AGRUPAMENTO posições que recebe o pai de cada célula, ou NULL.
+ */
+static void dijkstra_local(const Hierarquia *hierarquia, const Labirinto *labirinto, Heap *abertos, int agrupamento, int origem, int reverso,
+                           int *distancias, int *pais) {
+  int inicio[2], fim[2];
+  limites(hierarquia, agrupamento, inicio, fim);
+
+  for (int i = 0; i < AREA_AGRUPAMENTO; ++i) {
+    distancias[i] = INT_MAX;
+  }
+
+  abertos->tamanho = 0;
+  if (origem >= 0) {
+    distancias[indice_local(hierarquia, origem)] = 0;
+    inserir_heap(abertos, (ItemHeap){ .custo = 0, .peso = 0, .indice = origem });
+  }
+
+  // Sem origem, todas as saídas do agrupamento partem juntas com custo zero
+  for (int l = inicio[0]; origem < 0 && l < fim[0]; ++l) {
+    for (int c = inicio[1]; c < fim[1]; ++c) {
+      const int celula = l * hierarquia->colunas + c;
+
+      if (labirinto->matriz_inicial[l][c] == SAIDA) {
+        distancias[indice_local(hierarquia, celula)] = 0;
+        inserir_heap(abertos, (ItemHeap){ .custo = 0, .peso = 0, .indice = celula });
+      }
+    }
+  }
+
+  while (abertos->tamanho > 0) {
+    const ItemHeap topo = remover_heap(abertos);
+    const int local     = indice_local(hierarquia, topo.indice);
+
+    if (topo.custo > distancias[local]) {
+      continue;
+    }
+
+    const int linha  = topo.indice / hierarquia->colunas, coluna = topo.indice % hierarquia->colunas;
+    const int saindo = reverso ? custo_celula(labirinto, hierarquia->penalidade, linha, coluna) : 0;
+
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      int vizinha[2];
+
+      if (!vizinha_na_direcao(labirinto, linha, coluna, i, vizinha)) {
+        continue;
+      }
+
+      const int l = vizinha[0], c = vizinha[1];
+      if (l < inicio[0] || l >= fim[0] || c < inicio[1] || c >= fim[1]) {
+        continue;
+      }
+
+      const int passo = custo_celula(labirinto, hierarquia->penalidade, l, c);
+      if (passo < 0) {
+        continue;
+      }
+
+      const int adjacente = l * hierarquia->colunas + c;
+      const int peso      = distancias[local] + (reverso ? saindo : passo);
+      const int vizinho   = indice_local(hierarquia, adjacente);
+
+      if (peso < distancias[vizinho]) {
+        distancias[vizinho] = peso;
+        if (pais) {
+          pais[vizinho] = topo.indice;
+        }
+        inserir_heap(abertos, (ItemHeap){ .custo = peso, .peso = peso, .indice = adjacente });
+      }
+    }
+  }
+}
+
+/**
+ * Percorre uma borda do agrupamento e adiciona as entradas à lista de nós.
+ * `dentro` é a primeira célula da borda do lado do agrupamento, `passo` o
+ * deslocamento ao longo da borda e `fora` o deslocamento até o vizinho.
+ * Os dois agrupamentos percorrem a borda na mesma ordem, então escolhem as
+ * mesmas entradas.
+ */
+static void varrer_borda(Hierarquia *hierarquia, const Labirinto *labirinto, Agrupamento *agrupamento, const int dentro[2], const int passo[2],
+                         const int fora[2], int comprimento) {
+  int inicio_trecho = -1;
+
+  for (int t = 0; t <= comprimento; ++t) {
+    const int linha  = dentro[0] + t * passo[0], coluna = dentro[1] + t * passo[1];
+    const int aberta = t < comprimento && custo_celula(labirinto, hierarquia->penalidade, linha, coluna) >= 0 &&
+                       custo_celula(labirinto, hierarquia->penalidade, linha + fora[0], coluna + fora[1]) >= 0;
+
+    if (aberta && inicio_trecho < 0) {
+      inicio_trecho = t;
+    }
+
+    if (aberta || inicio_trecho < 0) {
+      continue;
+    }
+
+    const int fim_trecho     = t - 1;
+    const int entradas[2][2] = { { inicio_trecho, fim_trecho }, { (inicio_trecho + fim_trecho) / 2, -1 } };
+    const int *escolhidas    = entradas[t - inicio_trecho < ENTRADA_LONGA];
+
+    for (int i = 0; i < 2 && escolhidas[i] >= 0; ++i) {
+      const int celula = (dentro[0] + escolhidas[i] * passo[0]) * hierarquia->colunas + dentro[1] + escolhidas[i] * passo[1];
+
+      // Uma célula de canto pode ser entrada de duas bordas
+      if (hierarquia->indice_no[celula] < 0) {
+        hierarquia->indice_no[celula]                   = agrupamento->quantidade;
+        agrupamento->celulas[agrupamento->quantidade++] = celula;
+      }
+    }
+    inicio_trecho = -1;
+  }
+}
+
+static void calcular_nos(Hierarquia *hierarquia, const Labirinto *labirinto, int indice) {
+  Agrupamento *agrupamento = &hierarquia->agrupamentos[indice];
+  int inicio[2], fim[2];
+  limites(hierarquia, indice, inicio, fim);
+
+  for (int i = 0; i < agrupamento->quantidade; ++i) {
+    hierarquia->indice_no[agrupamento->celulas[i]] = -1;
+  }
+
+  // Cada borda tem no máximo uma entrada a cada duas células, mais as pontas,
+  // e com vários andares qualquer célula pode ser uma escada
+  agrupamento->quantidade = 0;
+  agrupamento->celulas    = realloc(agrupamento->celulas, (2 * TAMANHO_AGRUPAMENTO + 4 + (labirinto->andares > 1 ? AREA_AGRUPAMENTO : 0)) * sizeof(int));
+
+  if (agrupamento->celulas == NULL) {
+    erro(L"Falha ao alocar memória para a hierarquia.");
+  }
+
+  const int largura = fim[1] - inicio[1], altura = fim[0] - inicio[0];
+
+  if (inicio[0] > 0) {
+    varrer_borda(hierarquia, labirinto, agrupamento, (int[2]){ inicio[0], inicio[1] }, (int[2]){ 0, 1 }, (int[2]){ -1, 0 }, largura);
+  }
+  if (fim[0] < hierarquia->linhas) {
+    varrer_borda(hierarquia, labirinto, agrupamento, (int[2]){ fim[0] - 1, inicio[1] }, (int[2]){ 0, 1 }, (int[2]){ 1, 0 }, largura);
+  }
+  if (inicio[1] > 0) {
+    varrer_borda(hierarquia, labirinto, agrupamento, (int[2]){ inicio[0], inicio[1] }, (int[2]){ 1, 0 }, (int[2]){ 0, -1 }, altura);
+  }
+  if (fim[1] < hierarquia->colunas) {
+    varrer_borda(hierarquia, labirinto, agrupamento, (int[2]){ inicio[0], fim[1] - 1 }, (int[2]){ 1, 0 }, (int[2]){ 0, 1 }, altura);
+  }
+
+  // Uma escada que leva a outro agrupamento também é uma entrada, a um passo da escada do outro andar
+  for (int i = inicio[0]; i < fim[0] && labirinto->andares > 1; ++i) {
+    for (int j = inicio[1]; j < fim[1]; ++j) {
+      const int celula = i * hierarquia->colunas + j;
+
+      for (int d = SUBIR; d <= DESCER && hierarquia->indice_no[celula] < 0; ++d) {
+        int vizinha[2];
+        if (vizinha_na_direcao(labirinto, i, j, d, vizinha) && custo_celula(labirinto, hierarquia->penalidade, i, j) >= 0 &&
+            custo_celula(labirinto, hierarquia->penalidade, vizinha[0], vizinha[1]) >= 0 &&
+            agrupamento_de(hierarquia, vizinha[0] * hierarquia->colunas + vizinha[1]) != indice) {
+          hierarquia->indice_no[celula]                   = agrupamento->quantidade;
+          agrupamento->celulas[agrupamento->quantidade++] = celula;
+        }
+      }
+    }
+  }
+}
+
+static void calcular_distancias(Hierarquia *hierarquia, const Labirinto *labirinto, Heap *abertos, int indice) {
+  Agrupamento *agrupamento = &hierarquia->agrupamentos[indice];
+  const int quantidade     = agrupamento->quantidade;
+  int distancias[AREA_AGRUPAMENTO];
+
+  free(agrupamento->distancias);
+  agrupamento->distancias = malloc(max(1, quantidade * quantidade) * sizeof(int));
+
+  if (agrupamento->distancias == NULL) {
+    erro(L"Falha ao alocar memória para a hierarquia.");
+  }
+
+  for (int i = 0; i < quantidade; ++i) {
+    dijkstra_local(hierarquia, labirinto, abertos, indice, agrupamento->celulas[i], 0, distancias, NULL);
+
+    for (int j = 0; j < quantidade; ++j) {
+      const int distancia                         = distancias[indice_local(hierarquia, agrupamento->celulas[j])];
+      agrupamento->distancias[i * quantidade + j] = distancia == INT_MAX ? -1 : distancia;
+    }
+  }
+}
+
+void construir_hierarquia(Hierarquia *hierarquia, const Labirinto *labirinto, int penalidade) {
+  hierarquia->linhas               = labirinto->tamanho[0];
+  hierarquia->colunas              = labirinto->tamanho[1];
+  hierarquia->penalidade           = penalidade;
+  hierarquia->agrupamentos_linhas  = (hierarquia->linhas + TAMANHO_AGRUPAMENTO - 1) / TAMANHO_AGRUPAMENTO;
+  hierarquia->agrupamentos_colunas = (hierarquia->colunas + TAMANHO_AGRUPAMENTO - 1) / TAMANHO_AGRUPAMENTO;
+
+  const int total_agrupamentos = hierarquia->agrupamentos_linhas * hierarquia->agrupamentos_colunas;
+  hierarquia->agrupamentos     = calloc(total_agrupamentos, sizeof(Agrupamento));
+  hierarquia->indice_no        = malloc(hierarquia->linhas * hierarquia->colunas * sizeof(int));
+
+  if (hierarquia->agrupamentos == NULL || hierarquia->indice_no == NULL) {
+    erro(L"Falha ao alocar memória para a hierarquia.");
+  }
+
+  for (int i = 0; i < hierarquia->linhas * hierarquia->colunas; ++i) {
+    hierarquia->indice_no[i] = -1;
+  }
+
+  Heap abertos;
+  criar_heap(&abertos, AREA_AGRUPAMENTO);
+
+  for (int k = 0; k < total_agrupamentos; ++k) {
+    calcular_nos(hierarquia, labirinto, k);
+    calcular_distancias(hierarquia, labirinto, &abertos, k);
+  }
+
+  liberar_heap(&abertos);
+}
+
+void atualizar_agrupamento(Hierarquia *hierarquia, const Labirinto *labirinto, int posicao[2]) {
+  const int linha          = posicao[0] / TAMANHO_AGRUPAMENTO, coluna = posicao[1] / TAMANHO_AGRUPAMENTO;
+  const int passo          = labirinto->linhas_andar + 1;
+  const int vizinhos[7][2] = { { linha, coluna },
+                               { linha - 1, coluna },
+                               { linha + 1, coluna },
+                               { linha, coluna - 1 },
+                               { linha, coluna + 1 },
+                               { posicao[0] >= passo ? (posicao[0] - passo) / TAMANHO_AGRUPAMENTO : -1, coluna },
+                               { (posicao[0] + passo) / TAMANHO_AGRUPAMENTO, coluna } };
+
+  // Com vários andares, a escada do outro lado também pode deixar de ser entrada
+  const int quantidade = labirinto->andares > 1 ? 7 : 5;
+
+  Heap abertos;
+  criar_heap(&abertos, AREA_AGRUPAMENTO);
+
+  // Primeiro todas as entradas, depois as distâncias, que dependem delas
+  for (int etapa = 0; etapa < 2; ++etapa) {
+    for (int i = 0; i < quantidade; ++i) {
+      if (vizinhos[i][0] < 0 || vizinhos[i][0] >= hierarquia->agrupamentos_linhas || vizinhos[i][1] < 0 ||
+          vizinhos[i][1] >= hierarquia->agrupamentos_colunas) {
+        continue;
+      }
+
+      const int indice = vizinhos[i][0] * hierarquia->agrupamentos_colunas + vizinhos[i][1];
+      if (etapa == 0) {
+        calcular_nos(hierarquia, labirinto, indice);
+      } else {
+        calcular_distancias(hierarquia, labirinto, &abertos, indice);
+      }
+    }
+  }
+
+  liberar_heap(&abertos);
+}
+
+void liberar_hierarquia(Hierarquia *hierarquia) {
+  for (int k = 0; k < hierarquia->agrupamentos_linhas * hierarquia->agrupamentos_colunas; ++k) {
+    free(hierarquia->agrupamentos[k].celulas);
+    free(hierarquia->agrupamentos[k].distancias);
+  }
+
+  free(hierarquia->agrupamentos);
+  free(hierarquia->indice_no);
+  hierarquia->agrupamentos = NULL;
+  hierarquia->indice_no    = NULL;
+}
+
+int contar_nos(const Hierarquia *hierarquia) {
+  int total = 0;
+  for (int k = 0; k < hierarquia->agrupamentos_linhas * hierarquia->agrupamentos_colunas; ++k) {
+    total += hierarquia->agrupamentos[k].quantidade;
+  }
+  return total;
+}
+
+/**
+ * Anexa ao caminho o trecho de `de` até `para`, refeito por dentro do
+ * agrupamento de `de`, ou um passo só quando os dois estão em agrupamentos
+ * vizinhos.
+ */
+static void refinar_trecho(const Hierarquia *hierarquia, const Labirinto *labirinto, Heap *abertos, int de, int para, Caminho *caminho,
+                           int *capacidade) {
+  int distancias[AREA_AGRUPAMENTO], pais[AREA_AGRUPAMENTO];
+  int passos = 1;
+
+  if (agrupamento_de(hierarquia, de) == agrupamento_de(hierarquia, para)) {
+    dijkstra_local(hierarquia, labirinto, abertos, agrupamento_de(hierarquia, de), de, 0, distancias, pais);
+    passos = 0;
+    for (int atual = para; atual != de; atual = pais[indice_local(hierarquia, atual)]) {
+      passos++;
+    }
+  }
+
+  if (caminho->tamanho + passos > *capacidade) {
+    *capacidade       = max(*capacidade * 2, caminho->tamanho + passos);
+    caminho->direcoes = realloc(caminho->direcoes, *capacidade * sizeof(int));
+
+    if (caminho->direcoes == NULL) {
+      erro(L"Falha ao alocar memória para o caminho.");
+    }
+  }
+
+  if (passos == 1 && agrupamento_de(hierarquia, de) != agrupamento_de(hierarquia, para)) {
+    caminho->direcoes[caminho->tamanho++] = direcao_entre(de, para, hierarquia->colunas);
+    return;
+  }
+
+  caminho->tamanho += passos;
+  int escrita = caminho->tamanho;
+  for (int atual = para; atual != de; atual = pais[indice_local(hierarquia, atual)]) {
+    caminho->direcoes[--escrita] = direcao_entre(pais[indice_local(hierarquia, atual)], atual, hierarquia->colunas);
+  }
+}
+
+/**
+ * Relaxa a aresta do grafo abstrato até `chave`, cuja célula é `celula`, ou
+ * -1 para a chave da saída, que já está nela e não precisa de estimativa.
+ */
+static void relaxar(Tabela *tabela, Heap *abertos, int chave, int celula, int peso, int pai, const Labirinto *labirinto) {
+  EntradaTabela *entrada = obter_entrada(tabela, chave);
+
+  if (peso >= entrada->peso) {
+    return;
+  }
+
+  const int colunas    = labirinto->tamanho[1];
+  entrada->peso        = peso;
+  entrada->pai         = pai;
+  int posicao[2]       = { celula / colunas, celula % colunas };
+  const int estimativa = celula < 0 ? 0 : distancia_ate_saidas(labirinto, posicao);
+  inserir_heap(abertos, (ItemHeap){ .custo = peso + estimativa, .peso = peso, .indice = chave });
+}
+
+/**
+ * O custo de uma célula até a saída mais próxima dentro do seu agrupamento,
+ * ou INT_MAX se o agrupamento não tiver saída alcançável por dentro.
+ */
+static int custo_ate_saida(const Hierarquia *hierarquia, const int *vagas, const int *chegadas, int celula) {
+  const int vaga = vagas[agrupamento_de(hierarquia, celula)];
+  return vaga < 0 ? INT_MAX : chegadas[vaga * AREA_AGRUPAMENTO + indice_local(hierarquia, celula)];
+}
+
+/**
+ * A saída mais barata a partir de uma célula, sem sair do agrupamento dela.
+ * É a que a busca usou ao ligar essa célula à chave da saída.
+ */
+static int saida_mais_proxima(const Hierarquia *hierarquia, const Labirinto *labirinto, Heap *abertos, int celula) {
+  int distancias[AREA_AGRUPAMENTO], inicio[2], fim[2];
+  int saida = -1;
+
+  dijkstra_local(hierarquia, labirinto, abertos, agrupamento_de(hierarquia, celula), celula, 0, distancias, NULL);
+  limites(hierarquia, agrupamento_de(hierarquia, celula), inicio, fim);
+
+  for (int l = inicio[0]; l < fim[0]; ++l) {
+    for (int c = inicio[1]; c < fim[1]; ++c) {
+      const int candidata = l * hierarquia->colunas + c;
+      const int distancia = distancias[indice_local(hierarquia, candidata)];
+
+      if (labirinto->matriz_inicial[l][c] == SAIDA && distancia != INT_MAX &&
+          (saida < 0 || distancia < distancias[indice_local(hierarquia, saida)])) {
+        saida = candidata;
+      }
+    }
+  }
+  return saida;
+}
+
+int buscar_hierarquico(const Hierarquia *hierarquia, const Labirinto *labirinto, int origem[2], Caminho *caminho) {
+  const int colunas            = hierarquia->colunas;
+  const int celula_origem      = origem[0] * colunas + origem[1];
+  const int agrupamento_origem = agrupamento_de(hierarquia, celula_origem);
+  const int total_agrupamentos = hierarquia->agrupamentos_linhas * hierarquia->agrupamentos_colunas;
+
+  // Cada agrupamento com saídas ganha uma vaga em `chegadas`, com o custo de
+  // cada célula dele até a saída mais próxima lá dentro
+  int *vagas    = malloc(total_agrupamentos * sizeof(int));
+  int *chegadas = malloc(max(1, labirinto->quantidade_saidas) * AREA_AGRUPAMENTO * sizeof(int));
+  int partida[AREA_AGRUPAMENTO];
+  Heap abertos;
+
+  if (vagas == NULL || chegadas == NULL) {
+    erro(L"Falha ao alocar memória para a busca hierárquica.");
+  }
+
+  for (int k = 0; k < total_agrupamentos; ++k) {
+    vagas[k] = -1;
+  }
+
+  criar_heap(&abertos, AREA_AGRUPAMENTO);
+
+  // A origem e as saídas entram no grafo ligadas aos nós do próprio agrupamento
+  dijkstra_local(hierarquia, labirinto, &abertos, agrupamento_origem, celula_origem, 0, partida, NULL);
+  for (int i = 0, quantidade_vagas = 0; i < labirinto->quantidade_saidas; ++i) {
+    const int agrupamento = agrupamento_de(hierarquia, labirinto->saidas[i][0] * colunas + labirinto->saidas[i][1]);
+
+    if (vagas[agrupamento] < 0) {
+      vagas[agrupamento] = quantidade_vagas++;
+      dijkstra_local(hierarquia, labirinto, &abertos, agrupamento, -1, 1, chegadas + vagas[agrupamento] * AREA_AGRUPAMENTO, NULL);
+    }
+  }
+  abertos.tamanho = 0;
+
+  Tabela tabela;
+  criar_tabela(&tabela, 256);
+  relaxar(&tabela, &abertos, CHAVE_ORIGEM(hierarquia), celula_origem, 0, -1, labirinto);
+
+  int custo = -1;
+
+  while (abertos.tamanho > 0) {
+    const ItemHeap topo = remover_heap(&abertos);
+
+    if (topo.peso > procurar_tabela(&tabela, topo.indice)->peso) {
+      continue;
+    }
+
+    if (topo.indice == CHAVE_SAIDA(hierarquia)) {
+      custo = topo.peso;
+      break;
+    }
+
+    if (topo.indice == CHAVE_ORIGEM(hierarquia)) {
+      const Agrupamento *agrupamento = &hierarquia->agrupamentos[agrupamento_origem];
+
+      for (int j = 0; j < agrupamento->quantidade; ++j) {
+        const int distancia = partida[indice_local(hierarquia, agrupamento->celulas[j])];
+        if (distancia != INT_MAX) {
+          relaxar(&tabela, &abertos, agrupamento->celulas[j], agrupamento->celulas[j], distancia, topo.indice, labirinto);
+        }
+      }
+
+      const int ate_saida = custo_ate_saida(hierarquia, vagas, chegadas, celula_origem);
+      if (ate_saida != INT_MAX) {
+        relaxar(&tabela, &abertos, CHAVE_SAIDA(hierarquia), -1, ate_saida, topo.indice, labirinto);
+      }
+      continue;
+    }
+
+    const int celula               = topo.indice;
+    const int indice               = agrupamento_de(hierarquia, celula);
+    const Agrupamento *agrupamento = &hierarquia->agrupamentos[indice];
+    const int no                   = hierarquia->indice_no[celula];
+
+    for (int j = 0; j < agrupamento->quantidade; ++j) {
+      const int distancia = agrupamento->distancias[no * agrupamento->quantidade + j];
+      if (j != no && distancia >= 0) {
+        relaxar(&tabela, &abertos, agrupamento->celulas[j], agrupamento->celulas[j], topo.peso + distancia, celula, labirinto);
+      }
+    }
+
+    // As entradas do agrupamento vizinho ficam a um passo, do outro lado da borda
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      int vizinha[2];
+      if (!vizinha_na_direcao(labirinto, celula / colunas, celula % colunas, i, vizinha)) {
+        continue;
+      }
+
+      const int l     = vizinha[0], c = vizinha[1];
+      const int passo = custo_celula(labirinto, hierarquia->penalidade, l, c);
+
+      if (passo >= 0 && hierarquia->indice_no[l * colunas + c] >= 0 && agrupamento_de(hierarquia, l * colunas + c) != indice) {
+        relaxar(&tabela, &abertos, l * colunas + c, l * colunas + c, topo.peso + passo, celula, labirinto);
+      }
+    }
+
+    const int ate_saida = custo_ate_saida(hierarquia, vagas, chegadas, celula);
+    if (ate_saida != INT_MAX) {
+      relaxar(&tabela, &abertos, CHAVE_SAIDA(hierarquia), -1, topo.peso + ate_saida, celula, labirinto);
+    }
+  }
+
+  if (custo >= 0 && caminho) {
+    // A sequência de nós sai de trás para frente; ela é invertida antes do refinamento
+    // A saída alcançada é a mais próxima do último nó antes da chave da saída
+    const int pai_saida    = procurar_tabela(&tabela, CHAVE_SAIDA(hierarquia))->pai;
+    const int ultimo       = pai_saida == CHAVE_ORIGEM(hierarquia) ? celula_origem : pai_saida;
+    const int celula_saida = saida_mais_proxima(hierarquia, labirinto, &abertos, ultimo);
+
+    int quantidade = 0, capacidade = 64;
+    int *nos       = malloc(capacidade * sizeof(int));
+
+    for (int chave = CHAVE_SAIDA(hierarquia); chave != -1; chave = procurar_tabela(&tabela, chave)->pai) {
+      if (quantidade == capacidade) {
+        capacidade *= 2;
+        nos = realloc(nos, capacidade * sizeof(int));
+      }
+      if (nos == NULL) {
+        erro(L"Falha ao alocar memória para o caminho.");
+      }
+      nos[quantidade++] = chave == CHAVE_SAIDA(hierarquia) ? celula_saida : chave == CHAVE_ORIGEM(hierarquia) ? celula_origem : chave;
+    }
+
+    int capacidade_caminho = 64;
+    caminho->direcoes      = malloc(capacidade_caminho * sizeof(int));
+    caminho->tamanho       = 0;
+    caminho->custo         = custo;
+
+    if (caminho->direcoes == NULL) {
+      erro(L"Falha ao alocar memória para o caminho.");
+    }
+
+    for (int i = quantidade - 1; i > 0; --i) {
+      refinar_trecho(hierarquia, labirinto, &abertos, nos[i], nos[i - 1], caminho, &capacidade_caminho);
+    }
+
+    free(nos);
+  }
+
+  liberar_heap(&abertos);
+  free(tabela.entradas);
+  free(vagas);
+  free(chegadas);
+  return custo;
+}
@@ -0,0 +1,47 @@
+/*
+ * a_star_paralelo.h - Protótipos do A* distribuído entre threads
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef A_STAR_PARALELO_H
+#define A_STAR_PARALELO_H
+
+#include "typedefs.h"
+
+/**
+ * A* distribuído entre várias threads (HDA*). Cada célula tem uma thread
+ * dona, escolhida por hash, que guarda o peso dela e a mantém na sua própria
+ * lista aberta. Quem descobre um vizinho manda uma mensagem para o dono dele
+ * por uma fila sem travas.
+ *
+ * O caminho retornado é ótimo: a busca só termina quando nenhuma thread tem
+ * nó com custo estimado menor que a melhor solução e não há mensagens em
+ * trânsito.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param origem A posição de partida.
+ * @param destino A posição de chegada, ou NULL para ir até a saída mais próxima.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param threads A quantidade de threads.
+ * @param caminho Recebe o caminho de menor custo, ou NULL para apenas calcular o custo.
+ * @return O custo do menor caminho, ou -1 se o destino for inalcançável.
+ */
+int buscar_a_star_paralelo(const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, int threads, Caminho *caminho);
+
+#endif
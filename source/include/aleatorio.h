@@ -0,0 +1,65 @@
+/*
+ * aleatorio.h - Protótipos do gerador de números aleatórios
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <stdint.h>
+
+#define rotacionar(x, k) (((x) << (k)) | ((x) >> (64 - (k))))
+
+/**
+ * Gerador xoshiro256**: rápido, com período de 2^256 - 1 e estado pequeno o
+ * bastante para cada thread ter o seu, ao invés de disputar o `rand()`.
+ */
+typedef struct {
+  uint64_t estado[4];
+} Gerador;
+
+/**
+ * Semeia o gerador a partir de uma semente e de um número de fluxo. Fluxos
+ * diferentes da mesma semente dão sequências independentes, o que permite
+ * dar a cada simulação o seu próprio fluxo e reproduzir qualquer uma delas.
+ *
+ * @param gerador O gerador.
+ * @param semente A semente.
+ * @param fluxo O número do fluxo.
+ */
+void semear_gerador(Gerador *gerador, uint64_t semente, uint64_t fluxo);
+
+/**
+ * Sorteia 64 bits.
+ *
+ * @param gerador O gerador.
+ * @return O número sorteado.
+ */
+uint64_t proximo_aleatorio(Gerador *gerador);
+
+/**
+ * Sorteia um inteiro em [0, limite), sem o viés do resto da divisão.
+ *
+ * @param gerador O gerador.
+ * @param limite O limite, maior que zero.
+ * @return O número sorteado.
+ */
+uint32_t sortear(Gerador *gerador, uint32_t limite);
+
+#endif
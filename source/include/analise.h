@@ -0,0 +1,81 @@
+/*
+ * analise.h - Protótipos da análise estrutural do labirinto
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANALISE_H
+#define ANALISE_H
+
+#include "typedefs.h"
+
+/**
+ * As duas classes de células passáveis: sem os inimigos (que viram paredes)
+ * e com eles.
+ */
+enum { CLASSE_SEM_INIMIGOS, CLASSE_COM_INIMIGOS, QUANTIDADE_CLASSES };
+
+/**
+ * A estrutura do labirinto em cada classe de passagem. `ciclos` é o número
+ * de ciclos independentes (arestas - células + componentes): zero num
+ * labirinto perfeito. Becos têm um único vizinho passável e junções, três ou
+ * mais. As articulações, pontes e células obrigatórias até a saída são da
+ * componente do jogador e só são preenchidas por `analisar_gargalos`.
+ */
+typedef struct {
+  int celulas[QUANTIDADE_CLASSES];
+  int componentes[QUANTIDADE_CLASSES];
+  int becos[QUANTIDADE_CLASSES];
+  int juncoes[QUANTIDADE_CLASSES];
+  int ciclos[QUANTIDADE_CLASSES];
+  int saida_alcancavel[QUANTIDADE_CLASSES];
+  int articulacoes[QUANTIDADE_CLASSES];
+  int pontes[QUANTIDADE_CLASSES];
+  int obrigatorias[QUANTIDADE_CLASSES];
+} AnaliseLabirinto;
+
+/**
+ * Analisa o labirinto inicial com uma única passada de union-find por
+ * classe, ligando cada célula às vizinhas de cima e da esquerda. Como é
+ * quase linear, dá para rodar antes de qualquer busca e saber na hora se
+ * alguma saída é alcançável a partir do jogador e se é preciso passar por
+ * inimigos.
+ *
+ * @param analise Recebe a análise.
+ * @param labirinto A instância do labirinto.
+ */
+void analisar_labirinto(AnaliseLabirinto *analise, const Labirinto *labirinto);
+
+/**
+ * Completa a análise com os gargalos de Tarjan a partir do jogador, em cada
+ * classe. É linear, mas bem mais cara que o union-find, por isso fica fora de
+ * `analisar_labirinto`.
+ *
+ * @param analise A análise, já feita por `analisar_labirinto`.
+ * @param labirinto A instância do labirinto.
+ */
+void analisar_gargalos(AnaliseLabirinto *analise, const Labirinto *labirinto);
+
+/**
+ * Escreve a análise como uma tabela, uma coluna por classe.
+ *
+ * @param analise A análise.
+ */
+void imprimir_analise(const AnaliseLabirinto *analise);
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * ara_star.h - Protótipos do A* com prazo (ARA*)
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARA_STAR_H
+#define ARA_STAR_H
+
+#include "typedefs.h"
+
+#define EPSILON_INICIAL 3.0
+#define PASSO_EPSILON 0.5
+
+/**
+ * Chamada pelo ARA* a cada caminho encontrado.
+ *
+ * @param caminho O caminho encontrado.
+ * @param limite O custo do caminho é no máximo `limite` vezes o custo ótimo.
+ * @param segundos Tempo desde o início da busca.
+ * @param contexto O ponteiro passado para `buscar_ara_star`.
+ */
+typedef void (*RelatorARA)(const Caminho *caminho, double limite, double segundos, void *contexto);
+
+/**
+ * A* "a qualquer momento" (ARA*). Começa com a heurística inflada por
+ * `epsilon`, o que acha um caminho rápido mas não necessariamente ótimo, e
+ * vai diminuindo o epsilon reaproveitando os pesos já calculados até chegar
+ * no ótimo ou estourar o prazo.
+ *
+ * O prazo só interrompe a busca depois do primeiro caminho; sem ele não
+ * teríamos nada para devolver.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param origem A posição de partida.
+ * @param destino A posição de chegada, ou NULL para ir até a saída mais próxima.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param epsilon O fator inicial da heurística, maior ou igual a 1.
+ * @param prazo O tempo máximo da busca, em segundos.
+ * @param relatar Chamada a cada caminho melhorado, ou NULL.
+ * @param contexto Repassado para `relatar`.
+ * @param caminho Recebe o melhor caminho encontrado dentro do prazo.
+ * @return O custo do melhor caminho, ou -1 se o destino for inalcançável.
+ */
+int buscar_ara_star(const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, double epsilon, double prazo,
+                    RelatorARA relatar, void *contexto, Caminho *caminho);
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * benchmark.h - Protótipos das medições de desempenho
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "typedefs.h"
+
+/**
+ * Mede quantas células por segundo cada resolvedor processa no labirinto e
+ * imprime uma tabela comparando com o percurso célula a célula original.
+ *
+ * @param labirinto A instância do labirinto, já carregada.
+ * @param opcoes As opções da linha de comando, como a quantidade de threads.
+ */
+void executar_benchmark(Labirinto *labirinto, const Opcoes *opcoes);
+
+#endif
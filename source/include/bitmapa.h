@@ -0,0 +1,98 @@
+/*
+ * bitmapa.h - Protótipos da busca em largura bit-paralela
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITMAPA_H
+#define BITMAPA_H
+
+#include "typedefs.h"
+#include <stdint.h>
+
+#define BITS_PALAVRA 64
+
+typedef uint64_t Palavra;
+
+/**
+ * O labirinto compactado em bits: cada linha ocupa `palavras` palavras de 64
+ * bits, e o bit de uma célula vale 1 quando ela é passável. Com mais de um
+ * andar, `escadas` marca as escadas do mesmo jeito e `passo_andar` é quantas
+ * linhas separam uma célula da mesma célula no andar seguinte; com um andar
+ * só, `escadas` é NULL. `saidas` marca as saídas, que a busca sem destino
+ * confere a cada nível.
+ */
+typedef struct {
+  int linhas;
+  int colunas;
+  int palavras;
+  int passo_andar;
+  Palavra *livres;
+  Palavra *escadas;
+  Palavra *saidas;
+} Bitmapa;
+
+/**
+ * Compacta as células passáveis do labirinto inicial em um bitmapa.
+ *
+ * @param bitmapa O bitmapa que será preenchido.
+ * @param labirinto A instância do labirinto.
+ * @param com_inimigos Se verdadeiro, células com inimigos também são passáveis.
+ */
+void construir_bitmapa(Bitmapa *bitmapa, const Labirinto *labirinto, int com_inimigos);
+
+/**
+ * Desliga os bits das células fora da máscara, para que as buscas nem
+ * considerem entrar nelas.
+ *
+ * @param bitmapa O bitmapa.
+ * @param mascara Vetor de linhas * colunas posições, 0 nas células descartadas.
+ */
+void aplicar_mascara(Bitmapa *bitmapa, const uint8_t *mascara);
+
+/**
+ * Libera a memória do bitmapa.
+ *
+ * @param bitmapa O bitmapa que será liberado.
+ */
+void liberar_bitmapa(Bitmapa *bitmapa);
+
+/**
+ * Busca em largura que expande a fronteira inteira com deslocamentos de bits,
+ * 64 células por operação, ao invés de uma célula por vez.
+ *
+ * @param bitmapa O bitmapa do labirinto.
+ * @param labirinto A instância do labirinto, usada para somar o custo dos inimigos no caminho.
+ * @param origem A posição de partida.
+ * @param destino A posição de chegada, ou NULL para ir até a saída mais próxima.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param caminho Recebe o menor caminho encontrado, ou NULL para apenas checar se há caminho.
+ * @return A distância em passos até o destino, ou -1 se ele for inalcançável.
+ */
+int buscar_bitparalelo(const Bitmapa *bitmapa, const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, Caminho *caminho);
+
+/**
+ * Conta quantas células são alcançáveis a partir da origem, incluindo ela.
+ *
+ * @param bitmapa O bitmapa do labirinto.
+ * @param origem A posição de partida.
+ * @return A quantidade de células alcançáveis.
+ */
+int contar_alcancaveis_bitparalelo(const Bitmapa *bitmapa, int origem[2]);
+
+#endif
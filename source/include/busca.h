@@ -0,0 +1,105 @@
+/*
+ * busca.h - Protótipos das buscas sem interface
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include "typedefs.h"
+
+/**
+ * Descobre a direção de um passo entre duas células vizinhas, inclusive de
+ * uma escada para a do outro andar.
+ *
+ * @param de O índice (linha * colunas + coluna) da célula de partida.
+ * @param para O índice da célula de chegada.
+ * @param colunas A quantidade de colunas do labirinto.
+ * @return A direção que leva de `de` até `para`.
+ */
+Direcoes direcao_entre(int de, int para, int colunas);
+
+/**
+ * Custo de entrar numa célula do labirinto inicial.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param linha A linha da célula.
+ * @param coluna A coluna da célula.
+ * @return O custo, ou -1 se a célula não for passável ou estiver fora do labirinto.
+ */
+int custo_celula(const Labirinto *labirinto, int penalidade, int linha, int coluna);
+
+/**
+ * O alvo de uma busca: a célula do destino ou, sem destino, a única saída do
+ * labirinto. Com várias saídas, qualquer uma serve e o alvo é -1.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param destino A posição de chegada, ou NULL para ir até a saída mais próxima.
+ * @return O índice (linha * colunas + coluna) do alvo, ou -1.
+ */
+int alvo_da_busca(const Labirinto *labirinto, const int destino[2]);
+
+/**
+ * Confere se a busca chegou: na célula do alvo ou, com o alvo -1, em qualquer
+ * saída.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param celula O índice da célula.
+ * @param alvo O alvo devolvido por `alvo_da_busca`.
+ * @return Boolean, verdadeiro se a célula encerra a busca.
+ */
+int chegou_ao_alvo(const Labirinto *labirinto, int celula, int alvo);
+
+/**
+ * A heurística até o alvo, ou até a saída mais próxima com o alvo -1.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param celula O índice da célula.
+ * @param alvo O alvo devolvido por `alvo_da_busca`.
+ * @return Uma estimativa que nunca passa do custo real.
+ */
+int estimar_ate_alvo(const Labirinto *labirinto, int celula, int alvo);
+
+/**
+ * Monta um caminho seguindo o vetor de pais do destino até a origem.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param pais O pai de cada célula, indexado por linha * colunas + coluna.
+ * @param origem O índice da célula de partida.
+ * @param destino O índice da célula de chegada.
+ * @param penalidade O custo extra de cada inimigo no caminho.
+ * @param caminho Recebe as direções do caminho e o seu custo.
+ */
+void reconstruir_por_pais(const Labirinto *labirinto, const int *pais, int origem, int destino, int penalidade, Caminho *caminho);
+
+/**
+ * A* sem interface, com uma heap binária como lista aberta. Serve de
+ * referência para os resolvedores mais sofisticados.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param origem A posição de partida.
+ * @param destino A posição de chegada, ou NULL para ir até a saída mais próxima.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param caminho Recebe o caminho de menor custo, ou NULL para apenas calcular o custo.
+ * @return O custo do menor caminho, ou -1 se o destino for inalcançável.
+ */
+int buscar_a_star(const Labirinto *labirinto, int origem[2], int destino[2], int penalidade, Caminho *caminho);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * cache.h - Protótipos do cache de soluções em disco
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "resolvedor.h"
+#include "typedefs.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define ASSINATURA_CACHE "LBSC"
+#define VERSAO_CACHE 1
+
+/**
+ * O que identifica uma solução: as células do labirinto, a partida, a saída,
+ * o algoritmo e o modelo de custo. `hash` dá o nome da entrada no diretório
+ * e `verificacao`, calculado com outra semente, é guardado dentro dela para
+ * descartar colisões.
+ */
+typedef struct {
+  uint64_t hash;
+  uint64_t verificacao;
+  int tamanho[2];
+  int origem[2];
+  int saida[2];
+  int algoritmo;
+  int penalidade;
+} ChaveCache;
+
+/**
+ * Calcula a chave de um labirinto direto do texto do arquivo, numa única
+ * passada pelas células, sem alocar as matrizes. A partida é a célula do
+ * jogador.
+ *
+ * @param chave Recebe a chave.
+ * @param texto O conteúdo do arquivo do labirinto.
+ * @param tamanho O tamanho do conteúdo em bytes.
+ * @param algoritmo O algoritmo da consulta.
+ * @param penalidade A penalidade de inimigo da consulta, ou SEM_INIMIGOS.
+ * @param prazo O prazo do ARA*, que muda a resposta dele e entra só na chave dele.
+ * @return Boolean, falso se o texto não for um labirinto bem formado com
+ * exatamente um jogador e uma saída; nesse caso a consulta deve seguir sem
+ * cache.
+ */
+int calcular_chave_cache(ChaveCache *chave, const char *texto, size_t tamanho, Algoritmo algoritmo, int penalidade, double prazo);
+
+/**
+ * Procura a solução de uma chave no diretório. A entrada só é aceita se o
+ * cabeçalho, a chave completa, o tamanho do arquivo e a soma das direções
+ * baterem; qualquer diferença conta como ausência.
+ *
+ * @param diretorio O diretório do cache.
+ * @param chave A chave da consulta.
+ * @param caminho Recebe o caminho guardado, com o custo -1 quando a saída
+ * era inalcançável.
+ * @return Boolean, verdadeiro se a solução estava no cache.
+ */
+int buscar_no_cache(const char *diretorio, const ChaveCache *chave, Caminho *caminho);
+
+/**
+ * Guarda uma solução no diretório, criando-o se preciso, com as direções
+ * empacotadas em 2 bits cada. A entrada é escrita num arquivo temporário e
+ * renomeada, então quem lê ao mesmo tempo nunca vê uma entrada pela metade.
+ * Falhas de escrita só deixam de guardar a solução.
+ *
+ * @param diretorio O diretório do cache.
+ * @param chave A chave da consulta.
+ * @param custo O custo do caminho, ou -1 se a saída for inalcançável.
+ * @param caminho O caminho encontrado.
+ */
+void guardar_no_cache(const char *diretorio, const ChaveCache *chave, int custo, const Caminho *caminho);
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * campo.h - Protótipos do campo de distâncias até a saída
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CAMPO_H
+#define CAMPO_H
+
+#include "typedefs.h"
+#include <stdint.h>
+
+#define SEM_DIRECAO 0xFF
+
+/**
+ * Distância de cada célula até a saída mais próxima e a direção do primeiro
+ * passo do menor caminho. Como as saídas nunca mudam, o campo é calculado uma
+ * vez e qualquer consulta depois disso só segue as setas. `passo_andar` é
+ * quanto o índice de uma célula muda ao subir uma escada.
+ */
+typedef struct CampoDistancia {
+  int linhas;
+  int colunas;
+  int passo_andar;
+  int penalidade;
+  int *distancias;
+  uint8_t *proximo;
+} CampoDistancia;
+
+/**
+ * Calcula o campo com um Dijkstra ao contrário, partindo de todas as saídas
+ * ao mesmo tempo.
+ *
+ * @param campo O campo que será preenchido.
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ */
+void calcular_campo(CampoDistancia *campo, const Labirinto *labirinto, int penalidade);
+
+/**
+ * Conserta o campo depois que células de `labirinto->matriz_inicial` mudaram,
+ * sem refazê-lo inteiro. As células alteradas e todas as que chegavam à
+ * saída passando por elas perdem a distância; elas recomeçam das vizinhas
+ * que ficaram certas e o Dijkstra continua só a partir delas, o que também
+ * leva adiante os atalhos que a mudança abriu.
+ *
+ * @param campo O campo, calculado para o labirinto antes das mudanças.
+ * @param labirinto A instância do labirinto, já com as células novas.
+ * @param alteradas As posições das células que mudaram.
+ * @param quantidade A quantidade de posições.
+ * @return Quantas células tiveram a distância refeita.
+ */
+int atualizar_campo(CampoDistancia *campo, const Labirinto *labirinto, int (*alteradas)[2], int quantidade);
+
+/**
+ * Retorna o campo guardado no labirinto, calculando-o na primeira vez ou
+ * quando a penalidade pedida for diferente da guardada.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @return O campo de distâncias até a saída.
+ */
+const CampoDistancia *obter_campo(Labirinto *labirinto, int penalidade);
+
+/**
+ * Monta o caminho de uma célula até a saída mais próxima seguindo as setas
+ * do campo, em tempo proporcional ao tamanho do caminho.
+ *
+ * @param campo O campo de distâncias.
+ * @param origem A posição de partida.
+ * @param caminho Recebe o caminho até a saída, ou NULL para apenas consultar o custo.
+ * @return O custo até a saída, ou -1 se ela for inalcançável a partir da origem.
+ */
+int consultar_campo(const CampoDistancia *campo, int origem[2], Caminho *caminho);
+
+/**
+ * Libera a memória do campo.
+ *
+ * @param campo O campo que será liberado.
+ */
+void liberar_campo(CampoDistancia *campo);
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * cronologia.h - Protótipos da linha do tempo dos trechos do programa
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRONOLOGIA_H
+#define CRONOLOGIA_H
+
+#define EVENTOS_POR_ANEL 4096
+#define MAXIMO_ANEIS 256
+
+/**
+ * Um trecho aberto. `inicio` negativo quer dizer que a cronologia está
+ * desligada e o trecho não será gravado.
+ */
+typedef struct {
+  const char *nome;
+  double inicio;
+} Trecho;
+
+/**
+ * Liga a cronologia: a partir daqui os trechos são guardados e, quando o
+ * programa terminar, escritos no arquivo no formato de eventos do Chrome,
+ * que o Perfetto (ui.perfetto.dev) e o chrome://tracing abrem.
+ *
+ * @param nome O caminho do arquivo JSON.
+ */
+void iniciar_cronologia(const char *nome);
+
+/**
+ * Abre um trecho da linha do tempo. Com a cronologia desligada custa só uma
+ * comparação.
+ *
+ * @param nome O nome do trecho, que deve continuar válido até o fim do programa.
+ * @return O trecho, para ser passado a `terminar_trecho` no mesmo escopo.
+ */
+Trecho comecar_trecho(const char *nome);
+
+/**
+ * Fecha um trecho e o guarda no anel da thread atual. Cada thread tem o seu
+ * anel de EVENTOS_POR_ANEL trechos, sem trava nenhuma; quando ele enche, os
+ * trechos mais antigos são sobrescritos.
+ *
+ * @param trecho O trecho devolvido por `comecar_trecho`.
+ */
+void terminar_trecho(Trecho trecho);
+
+/**
+ * Fecha o trecho apontado. Existe para ser usada pelo `cleanup` de `TRECHO`.
+ *
+ * @param trecho O trecho a ser fechado.
+ */
+static inline void fechar_trecho(const Trecho *trecho) {
+  terminar_trecho(*trecho);
+}
+
+/**
+ * Abre um trecho que se fecha sozinho quando o escopo atual termina, por
+ * qualquer `return` ou `break`, então um retorno antecipado não deixa o trecho
+ * aberto. Só pode haver um por escopo.
+ */
+#define TRECHO(nome) const Trecho trecho_escopo __attribute__((cleanup(fechar_trecho))) = comecar_trecho(nome)
+
+#endif
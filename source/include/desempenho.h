@@ -0,0 +1,104 @@
+/*
+ * desempenho.h - Protótipos dos contadores de hardware do processador
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DESEMPENHO_H
+#define DESEMPENHO_H
+
+#include "typedefs.h"
+#include <stdio.h>
+#include <wchar.h>
+
+typedef enum {
+  HW_CICLOS,
+  HW_INSTRUCOES,
+  HW_FALTAS_L1,
+  HW_FALTAS_LLC,
+  HW_DESVIOS_ERRADOS,
+  HW_FALTAS_DTLB,
+  QUANTIDADE_EVENTOS_HW
+} EventoHw;
+
+/**
+ * Os contadores do processador abertos para a thread atual e as threads que
+ * ela criar depois. Um descritor -1 é um evento que o processador, o sistema
+ * ou as permissões não deixaram abrir.
+ */
+typedef struct {
+  int descritores[QUANTIDADE_EVENTOS_HW];
+  int disponiveis;
+} Medidor;
+
+/**
+ * Uma leitura de todos os eventos, -1 nos indisponíveis.
+ */
+typedef struct {
+  long long valores[QUANTIDADE_EVENTOS_HW];
+} LeituraHw;
+
+/**
+ * Os nomes dos eventos para as tabelas e as chaves para o JSON.
+ */
+extern const wchar_t *nomes_eventos_hw[QUANTIDADE_EVENTOS_HW];
+extern const wchar_t *chaves_eventos_hw[QUANTIDADE_EVENTOS_HW];
+
+/**
+ * Abre os contadores com `perf_event_open`, contando só o código do
+ * programa, sem o do sistema. Fora do Linux nenhum evento fica disponível.
+ *
+ * @param medidor O medidor que será aberto.
+ * @return Quantos eventos puderam ser abertos.
+ */
+int abrir_medidor(Medidor *medidor);
+
+/**
+ * Lê o valor acumulado de cada evento. Quando há mais eventos que
+ * contadores no processador, o sistema os reveza, e o valor é estimado
+ * proporcionalmente ao tempo em que cada um contou.
+ *
+ * @param medidor O medidor.
+ * @param leitura Recebe os valores.
+ */
+void ler_medidor(const Medidor *medidor, LeituraHw *leitura);
+
+/**
+ * Soma em `total` a diferença entre duas leituras, evento a evento.
+ *
+ * @param total O acumulado.
+ * @param fim A leitura do fim do trecho.
+ * @param inicio A leitura do começo do trecho.
+ */
+void acumular_leitura(LeituraHw *total, const LeituraHw *fim, const LeituraHw *inicio);
+
+/**
+ * Fecha os contadores.
+ *
+ * @param medidor O medidor.
+ */
+void fechar_medidor(Medidor *medidor);
+
+/**
+ * Explica por que nenhum contador pôde ser aberto, na saída indicada.
+ *
+ * @param saida Onde escrever.
+ */
+void explicar_medidor_indisponivel(FILE *saida);
+
+#endif
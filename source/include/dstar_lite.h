@@ -0,0 +1,100 @@
+/*
+ * dstar_lite.h - Protótipos do replanejamento incremental (D* Lite)
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include "heap.h"
+#include "typedefs.h"
+
+/**
+ * O estado do D* Lite. A busca parte da saída em direção à origem, então os
+ * pesos `g` (custo de cada célula até a saída) continuam válidos quando a
+ * origem anda; quando uma célula muda, só as células cujo `g` dependia dela
+ * são refeitas. `custos` é a cópia do planejador do custo de entrar em cada
+ * célula, -1 para as intransponíveis; o labirinto só é consultado para saber
+ * onde há escadas.
+ */
+typedef struct {
+  const Labirinto *labirinto;
+  int linhas;
+  int colunas;
+  int penalidade;
+  int origem;
+  int saida;
+  int ultima_origem;
+  long long km;
+  int *custos;
+  int *g;
+  int *rhs;
+  long long *chaves;
+  Heap abertos;
+  long long expansoes;
+} DStarLite;
+
+/**
+ * Prepara o planejador para o labirinto inicial. O primeiro caminho só é
+ * calculado em `replanejar`.
+ *
+ * @param planejador O planejador que será inicializado.
+ * @param labirinto A instância do labirinto.
+ * @param origem A posição de partida.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ */
+void iniciar_dstar_lite(DStarLite *planejador, const Labirinto *labirinto, int origem[2], int penalidade);
+
+/**
+ * Avisa o planejador que uma célula mudou, como um inimigo que apareceu ou
+ * sumiu ou uma parede que foi colocada ou tirada. O reparo só acontece no
+ * próximo `replanejar`, então várias mudanças podem ser marcadas de uma vez.
+ *
+ * @param planejador O planejador.
+ * @param posicao A posição da célula.
+ * @param celula O novo conteúdo da célula, como PAREDE, INIMIGO ou CAMINHO_LIVRE.
+ */
+void marcar_celula_alterada(DStarLite *planejador, int posicao[2], char celula);
+
+/**
+ * Move a origem, por exemplo depois que o jogador andou pelo caminho.
+ *
+ * @param planejador O planejador.
+ * @param origem A nova posição de partida.
+ */
+void mover_origem_dstar(DStarLite *planejador, int origem[2]);
+
+/**
+ * Repara a busca depois das mudanças e devolve o caminho atualizado da
+ * origem até a saída.
+ *
+ * @param planejador O planejador.
+ * @param caminho Recebe o caminho, ou NULL para apenas calcular o custo.
+ * @return O custo do menor caminho, ou -1 se a saída ficou inalcançável.
+ */
+int replanejar(DStarLite *planejador, Caminho *caminho);
+
+/**
+ * Libera a memória do planejador.
+ *
+ * @param planejador O planejador que será liberado.
+ */
+void liberar_dstar_lite(DStarLite *planejador);
+
+#endif
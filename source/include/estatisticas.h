@@ -0,0 +1,132 @@
+/*
+ * estatisticas.h - Protótipos e macros dos contadores dos resolvedores
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include "desempenho.h"
+#include "typedefs.h"
+
+/**
+ * As fases em que o tempo de uma resolução é dividido. O desenho e a espera
+ * (`pausar`) interrompem a fase em que estavam e a devolvem ao terminar.
+ */
+typedef enum {
+  FASE_CARGA,
+  FASE_PREPARO,
+  FASE_BUSCA,
+  FASE_CAMINHO,
+  FASE_DESENHO,
+  FASE_ESPERA,
+  QUANTIDADE_FASES,
+  FASE_NENHUMA = QUANTIDADE_FASES
+} Fase;
+
+/**
+ * Os contadores de uma resolução do menu. `maior_fronteira` é o maior
+ * tamanho que a pilha ou a lista de abertos chegou a ter, e
+ * `caracteres_desenhados`, quantos caracteres foram escritos no terminal.
+ * `hardware` só é preenchido quando os contadores do processador foram
+ * pedidos.
+ */
+typedef struct {
+  const char *resolvedor;
+  long long nos_expandidos;
+  long long insercoes;
+  long long remocoes;
+  long long maior_fronteira;
+  long long retrocessos;
+  long long restauracoes;
+  long long alocacoes;
+  long long quadros;
+  long long caracteres_desenhados;
+  long long celulas_desenhadas;
+  double tempo[QUANTIDADE_FASES];
+  LeituraHw hardware[QUANTIDADE_FASES];
+} Estatisticas;
+
+typedef enum { RELATORIO_TABELA, RELATORIO_JSON } FormatoRelatorio;
+
+/**
+ * Os contadores só existem quando o programa é compilado com CONTADORES
+ * (`make CONTADORES=1`, o padrão). Sem ele, todas as macros abaixo somem e
+ * os resolvedores ficam exatamente como eram.
+ */
+#ifdef CONTADORES
+
+extern _Thread_local Estatisticas estatisticas_atuais;
+
+#define contar(campo) (estatisticas_atuais.campo++)
+#define somar(campo, valor) (estatisticas_atuais.campo += (valor))
+#define registrar_maximo(campo, valor) (estatisticas_atuais.campo = max(estatisticas_atuais.campo, (long long)(valor)))
+
+/**
+ * Fecha o tempo da fase atual e passa a contar o de outra.
+ *
+ * @param fase A nova fase, ou FASE_NENHUMA para parar de contar.
+ * @return A fase anterior, para ser retomada depois.
+ */
+Fase entrar_fase(Fase fase);
+
+/**
+ * Começa os contadores de uma nova resolução. O que foi contado antes dela,
+ * como a carga do labirinto e o menu, fica com a sessão.
+ *
+ * @param resolvedor O nome do resolvedor, usado no relatório.
+ */
+void iniciar_execucao(const char *resolvedor);
+
+/**
+ * Guarda os contadores da resolução atual para o relatório.
+ */
+void terminar_execucao();
+
+#else
+
+#define contar(campo) ((void)0)
+#define somar(campo, valor) ((void)(valor))
+#define registrar_maximo(campo, valor) ((void)0)
+
+static inline Fase entrar_fase(Fase fase) {
+  (void)fase;
+  return FASE_NENHUMA;
+}
+
+static inline void iniciar_execucao(const char *resolvedor) {
+  (void)resolvedor;
+}
+
+static inline void terminar_execucao() {}
+
+#endif
+
+/**
+ * Faz o relatório das resoluções ser impresso na saída de erros quando o
+ * programa terminar, por qualquer caminho (Sair, Ctrl+C ou depois de salvar).
+ *
+ * @param formato Tabela para ler ou JSON para outras ferramentas.
+ * @param com_hardware Se verdadeiro, também lê os contadores do processador
+ * a cada troca de fase, e o relatório os mostra por nó expandido (ou por
+ * célula desenhada, no desenho).
+ */
+void relatar_estatisticas_ao_sair(FormatoRelatorio formato, int com_hardware);
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * fila.h - Protótipos da fila sem travas usada entre threads
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILA_H
+#define FILA_H
+
+#include <stdatomic.h>
+
+/**
+ * Nó de uma fila MPSC. Ele fica dentro da mensagem (como primeiro campo da
+ * struct), então a fila nunca aloca memória sozinha.
+ */
+typedef struct NoFila {
+  _Atomic(struct NoFila *) proximo;
+} NoFila;
+
+/**
+ * Fila sem travas com vários produtores e um único consumidor, no estilo da
+ * fila intrusiva de Dmitry Vyukov: inserir é uma única troca atômica, e só a
+ * thread dona da fila pode remover.
+ */
+typedef struct {
+  _Atomic(NoFila *) entrada;
+  NoFila *saida;
+  NoFila sentinela;
+} FilaMPSC;
+
+/**
+ * Inicializa uma fila vazia.
+ *
+ * @param fila A fila que será inicializada.
+ */
+void criar_fila(FilaMPSC *fila);
+
+/**
+ * Insere um nó na fila. Pode ser chamada por qualquer thread.
+ *
+ * @param fila A fila.
+ * @param no O nó que será inserido.
+ */
+void inserir_fila(FilaMPSC *fila, NoFila *no);
+
+/**
+ * Remove o nó mais antigo da fila. Só pode ser chamada pela thread dona.
+ *
+ * Pode retornar NULL enquanto um produtor ainda está no meio de uma
+ * inserção; nesse caso basta tentar de novo depois.
+ *
+ * @param fila A fila.
+ * @return O nó removido, ou NULL se a fila estiver vazia.
+ */
+NoFila *remover_fila(FilaMPSC *fila);
+
+#endif
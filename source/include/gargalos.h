@@ -0,0 +1,84 @@
+/*
+ * gargalos.h - Protótipos das articulações, pontes e trechos
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GARGALOS_H
+#define GARGALOS_H
+
+#include "typedefs.h"
+
+#define TRECHOS_POR_THREAD 4
+
+/**
+ * Os pontos de articulação e as pontes da componente de uma origem, achados
+ * por uma busca em profundidade de Tarjan. `obrigatorias` são as
+ * articulações por onde todo caminho da origem até qualquer saída passa, na
+ * ordem em que aparecem nele; `pontes` guarda as duas células de cada ponte,
+ * em pares.
+ */
+typedef struct {
+  int calculados;
+  int origem[2];
+  int saida_alcancavel;
+  int *articulacoes;
+  int quantidade_articulacoes;
+  int *pontes;
+  int quantidade_pontes;
+  int *obrigatorias;
+  int quantidade_obrigatorias;
+} Gargalos;
+
+/**
+ * Encontra as articulações, as pontes e as células obrigatórias entre a
+ * origem e as saídas. A busca em profundidade é iterativa, com uma pilha
+ * explícita, porque um labirinto grande passaria do limite da pilha de
+ * chamadas.
+ *
+ * @param gargalos Recebe o resultado, que deve ser liberado com `liberar_gargalos`.
+ * @param labirinto A instância do labirinto.
+ * @param com_inimigos Boolean, se as células com inimigo são passáveis.
+ * @param origem A posição de partida, que deve ser passável.
+ */
+void encontrar_gargalos(Gargalos *gargalos, const Labirinto *labirinto, int com_inimigos, int origem[2]);
+
+/**
+ * Resolve a consulta dividindo-a nas células obrigatórias: como todo caminho
+ * passa por elas em ordem, o menor caminho é a junção dos menores caminhos
+ * entre cada par consecutivo. Os trechos são buscados com A* em paralelo, e
+ * as células obrigatórias são agrupadas para haver no máximo
+ * TRECHOS_POR_THREAD trechos por thread.
+ *
+ * @param gargalos Os gargalos calculados para a origem da consulta.
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param threads A quantidade de threads.
+ * @param caminho Recebe o caminho de menor custo, ou NULL para apenas calcular o custo.
+ * @return O custo do menor caminho, ou -1 se a saída for inalcançável.
+ */
+int buscar_por_gargalos(const Gargalos *gargalos, const Labirinto *labirinto, int penalidade, int threads, Caminho *caminho);
+
+/**
+ * Libera os gargalos.
+ *
+ * @param gargalos Os gargalos.
+ */
+void liberar_gargalos(Gargalos *gargalos);
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * grafo.h - Protótipos do grafo de junções
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAFO_H
+#define GRAFO_H
+
+#include "typedefs.h"
+#include <stdint.h>
+
+/**
+ * O labirinto com os corredores contraídos. Os vértices são as células de
+ * decisão (as passáveis com um, três ou quatro vizinhos passáveis) e as saídas;
+ * cada aresta é um corredor inteiro entre dois vértices. As arestas ficam no
+ * formato CSR: as que saem do vértice v vão de `inicio[v]` a `inicio[v + 1]`.
+ */
+typedef struct {
+  int linhas;
+  int colunas;
+  int penalidade;
+  int quantidade_vertices;
+  int quantidade_arestas;
+  int *vertice_da_celula;
+  int *celulas;
+  int *inicio;
+  int *destinos;
+  int *pesos;
+  int *passos;
+  uint8_t *direcoes;
+} GrafoJuncoes;
+
+/**
+ * Contrai os corredores do labirinto inicial num grafo de junções. O peso de
+ * uma aresta é a soma dos custos das células em que ela entra, inimigos
+ * incluídos.
+ *
+ * @param grafo O grafo que será preenchido.
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ */
+void construir_grafo(GrafoJuncoes *grafo, const Labirinto *labirinto, int penalidade);
+
+/**
+ * Libera a memória do grafo.
+ *
+ * @param grafo O grafo que será liberado.
+ */
+void liberar_grafo(GrafoJuncoes *grafo);
+
+/**
+ * A* sobre o grafo de junções até a saída mais próxima. Uma origem no meio de um corredor
+ * entra no grafo pelas duas pontas dele; no fim, as arestas do caminho são
+ * expandidas de volta em passos célula a célula.
+ *
+ * @param grafo O grafo de junções.
+ * @param labirinto A instância do labirinto usada para construir o grafo.
+ * @param origem A posição de partida, que deve ser passável.
+ * @param caminho Recebe o caminho de menor custo, ou NULL para apenas calcular o custo.
+ * @return O custo do menor caminho, ou -1 se a saída for inalcançável.
+ */
+int buscar_no_grafo(const GrafoJuncoes *grafo, const Labirinto *labirinto, int origem[2], Caminho *caminho);
+
+#endif
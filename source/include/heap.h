@@ -0,0 +1,73 @@
+/*
+ * heap.h - Protótipos da fila de prioridade usada pelos resolvedores
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+/**
+ * Um item da fila de prioridade. Itens com menor `custo` saem primeiro e,
+ * no empate, sai o que tiver o maior `peso` (o que já andou mais, ou seja,
+ * o que está mais perto do destino segundo a heurística).
+ */
+typedef struct {
+  long long custo;
+  int peso;
+  int indice;
+} ItemHeap;
+
+typedef struct {
+  ItemHeap *itens;
+  int tamanho;
+  int capacidade;
+} Heap;
+
+/**
+ * Inicializa uma heap vazia.
+ *
+ * @param heap A heap que será inicializada.
+ * @param capacidade A capacidade inicial; a heap cresce sozinha quando precisa.
+ */
+void criar_heap(Heap *heap, int capacidade);
+
+/**
+ * Libera a memória da heap.
+ *
+ * @param heap A heap que será liberada.
+ */
+void liberar_heap(Heap *heap);
+
+/**
+ * Insere um item na heap.
+ *
+ * @param heap A heap.
+ * @param item O item que será inserido.
+ */
+void inserir_heap(Heap *heap, ItemHeap item);
+
+/**
+ * Remove e retorna o item de menor custo. A heap não pode estar vazia.
+ *
+ * @param heap A heap.
+ * @return O item removido.
+ */
+ItemHeap remover_heap(Heap *heap);
+
+#endif
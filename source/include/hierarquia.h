@@ -0,0 +1,111 @@
+/*
+ * hierarquia.h - Protótipos da busca hierárquica (HPA*)
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HIERARQUIA_H
+#define HIERARQUIA_H
+
+#include "typedefs.h"
+
+#define TAMANHO_AGRUPAMENTO 16
+#define ENTRADA_LONGA 6
+
+/**
+ * Um bloco de TAMANHO_AGRUPAMENTO x TAMANHO_AGRUPAMENTO células. Os nós são
+ * as células de entrada nas bordas com os blocos vizinhos, e `distancias`
+ * guarda, em `quantidade * quantidade` posições, o menor custo entre cada par
+ * de nós andando só por dentro do bloco (-1 se não houver caminho).
+ */
+typedef struct {
+  int quantidade;
+  int *celulas;
+  int *distancias;
+} Agrupamento;
+
+/**
+ * A abstração do HPA*: o labirinto dividido em agrupamentos, ligados pelas
+ * entradas que eles têm em comum. `indice_no` diz, para cada célula, a sua
+ * posição na lista de nós do seu agrupamento, ou -1 se ela não for um nó.
+ */
+typedef struct {
+  int linhas;
+  int colunas;
+  int penalidade;
+  int agrupamentos_linhas;
+  int agrupamentos_colunas;
+  Agrupamento *agrupamentos;
+  int *indice_no;
+} Hierarquia;
+
+/**
+ * Divide o labirinto em agrupamentos, encontra as entradas entre eles e
+ * calcula as distâncias internas de cada um.
+ *
+ * Cada trecho contínuo de borda, passável dos dois lados, vira uma entrada no
+ * meio, ou duas nas pontas se tiver ENTRADA_LONGA células ou mais.
+ *
+ * @param hierarquia A hierarquia que será preenchida.
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ */
+void construir_hierarquia(Hierarquia *hierarquia, const Labirinto *labirinto, int penalidade);
+
+/**
+ * Refaz a abstração ao redor de uma célula que mudou no labirinto inicial:
+ * o agrupamento dela e os quatro vizinhos, cujas entradas em comum podem ter
+ * mudado. O resto da hierarquia não é tocado.
+ *
+ * @param hierarquia A hierarquia.
+ * @param labirinto A instância do labirinto, já com a célula alterada.
+ * @param posicao A posição da célula alterada.
+ */
+void atualizar_agrupamento(Hierarquia *hierarquia, const Labirinto *labirinto, int posicao[2]);
+
+/**
+ * Libera a memória da hierarquia.
+ *
+ * @param hierarquia A hierarquia que será liberada.
+ */
+void liberar_hierarquia(Hierarquia *hierarquia);
+
+/**
+ * Conta os nós de todos os agrupamentos.
+ *
+ * @param hierarquia A hierarquia.
+ * @return A quantidade de nós do grafo abstrato.
+ */
+int contar_nos(const Hierarquia *hierarquia);
+
+/**
+ * Busca um caminho até a saída mais próxima com HPA*: um A* no grafo abstrato, seguido do
+ * refinamento de cada trecho escolhido por dentro do seu agrupamento. O
+ * trabalho cresce com a quantidade de agrupamentos atravessados, e não com a
+ * área do labirinto. O caminho fica perto do ótimo, mas não há garantia de
+ * que seja o menor, pois só as entradas escolhidas cruzam as bordas.
+ *
+ * @param hierarquia A hierarquia do labirinto.
+ * @param labirinto A instância do labirinto usada para construir a hierarquia.
+ * @param origem A posição de partida, que deve ser passável.
+ * @param caminho Recebe o caminho encontrado, ou NULL para apenas calcular o custo.
+ * @return O custo do caminho, ou -1 se a busca não chegar na saída.
+ */
+int buscar_hierarquico(const Hierarquia *hierarquia, const Labirinto *labirinto, int origem[2], Caminho *caminho);
+
+#endif
@@ -42,6 +42,19 @@
  */
 FILE *abrir_arquivo(const char *nome);
 
+/**
+ * Lê o cabeçalho de um labirinto, só da primeira linha do texto: as linhas e
+ * as colunas de cada andar e, se houver, a quantidade de andares, que é 1
+ * quando falta. As linhas e as colunas ficam zeradas se não puderem ser lidas.
+ *
+ * @param texto O texto do arquivo, a partir do cabeçalho.
+ * @param linhas Recebe as linhas de cada andar.
+ * @param colunas Recebe as colunas.
+ * @param andares Recebe a quantidade de andares.
+ * @return Boolean, falso se o cabeçalho faltar ou passar dos limites.
+ */
+int ler_dimensoes(const char *texto, int *linhas, int *colunas, int *andares);
+
 /**
  * Lê arquivo do labirinto e carrega dados na instância do labirinto
  *
@@ -52,6 +65,43 @@ FILE *abrir_arquivo(const char *nome);
  */
 void ler_arquivo(Labirinto *labirinto);
 
+/**
+ * Abre, lê e preenche um labirinto de uma vez, sem passar pelo menu
+ * interativo. Fora do menu o limite de 20 linhas e colunas não se aplica.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param nome O caminho do arquivo do labirinto.
+ */
+void carregar_labirinto(Labirinto *labirinto, const char *nome);
+
+/**
+ * Lê o arquivo inteiro de uma vez para a memória, sem interpretar nada.
+ *
+ * @param nome O caminho do arquivo.
+ * @param tamanho Recebe o tamanho do conteúdo em bytes.
+ * @return O conteúdo, terminado em '\0', que deve ser liberado com `free`, ou
+ * NULL se o arquivo não puder ser lido.
+ */
+char *ler_conteudo_arquivo(const char *nome, size_t *tamanho);
+
+struct Arena;
+
+/**
+ * Monta um labirinto a partir do texto de um arquivo já lido, com as
+ * matrizes alocadas na arena. Só a matriz inicial, o tamanho, o jogador, a
+ * saída e as listas de partidas e saídas são preenchidos, o bastante para os
+ * resolvedores sem interface; a matriz atual aponta para a inicial. Ao
+ * contrário de `carregar_labirinto`, um texto inválido não encerra o
+ * programa.
+ *
+ * @param labirinto A instância do labirinto, que deve estar zerada.
+ * @param texto O texto do labirinto, terminado em '\0'.
+ * @param tamanho O tamanho do texto em bytes.
+ * @param arena A arena das matrizes.
+ * @return NULL se deu certo, ou a mensagem do erro.
+ */
+const char *ler_labirinto_de_texto(Labirinto *labirinto, const char *texto, size_t tamanho, struct Arena *arena);
+
 /**
  * Salva o estado atual do labirinto em um arquivo.
  *
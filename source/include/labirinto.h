@@ -42,7 +42,8 @@ char *encontrar_adjacencias(char **matriz, int *tamanho, int linha, int coluna);
 
 /**
  * Preenche a matriz com os caracteres do arquivo do labirinto, também carrega
- * as posições do jogador e da saída.
+ * as posições de todas as partidas ('@') e saídas ('$'). A primeira de cada,
+ * na ordem de leitura, é a posição inicial do jogador e a saída principal.
  *
  * @param labirinto A instância do labirinto.
  */
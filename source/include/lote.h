@@ -0,0 +1,56 @@
+/*
+ * lote.h - Protótipos da resolução em lote de muitos labirintos
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "typedefs.h"
+
+// Quantos labirintos lidos podem esperar pela escrita; uma potência de 2
+#define JANELA_TAREFAS 4096
+// De quantos em quantos labirintos lidos as threads são avisadas
+#define TAREFAS_POR_PUBLICACAO 256
+
+/**
+ * Resolve muitos labirintos de uma vez, com `opcoes->threads` threads, e
+ * escreve uma linha JSON por partida ('@') de cada labirinto (NDJSON), na
+ * ordem da entrada e, dentro de um labirinto, na ordem do arquivo.
+ *
+ * A entrada (`opcoes->lote`) pode ser um diretório, cujos arquivos são
+ * resolvidos em ordem alfabética; um arquivo com um caminho de labirinto por
+ * linha; ou "-", para ler da entrada padrão labirintos concatenados, cada um
+ * com o seu cabeçalho de tamanho, que diz quantas linhas são dele. Um
+ * cabeçalho inválido sai como erro, e a leitura segue no próximo válido.
+ *
+ * As threads são criadas uma vez para o lote inteiro. A thread principal lê
+ * a entrada enquanto houver vaga numa janela de JANELA_TAREFAS labirintos e
+ * escreve os resultados em ordem, o que libera as vagas. Cada thread pega
+ * uma faixa contígua dos labirintos lidos e ainda não distribuídos e, quando
+ * a sua acaba, rouba labirintos do fim da faixa das outras; só quando não
+ * há o que roubar ela pega uma faixa nova. Cada thread monta os seus
+ * labirintos numa arena própria, esvaziada entre um labirinto e outro.
+ *
+ * @param opcoes As opções da linha de comando: a entrada, o algoritmo, a
+ * penalidade, as threads e o cache.
+ */
+void executar_lote(const Opcoes *opcoes);
+
+#endif
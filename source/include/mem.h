@@ -67,6 +67,13 @@ void copiar_matriz(void *origem, void *destino, size_t tamanho);
  */
 void copiar_matriz_bidimensional(char **origem, char **destino, int linhas, int colunas);
 
+/**
+ * Libera as direções de um caminho encontrado por um resolvedor.
+ *
+ * @param caminho O caminho que será liberado.
+ */
+void liberar_caminho(Caminho *caminho);
+
 /**
  * Fecha o arquivo do labirinto e libera a memória alocada para as matrizes
  * do labirinto e do labirinto inicial.
@@ -75,4 +82,51 @@ void copiar_matriz_bidimensional(char **origem, char **destino, int linhas, int
  */
 void fechar_labirinto(Labirinto *labirinto);
 
+#define BLOCO_MINIMO_ARENA (64 * 1024)
+
+/**
+ * Um bloco de memória da arena, encadeado com os blocos anteriores.
+ */
+typedef struct BlocoArena {
+  struct BlocoArena *anterior;
+  size_t capacidade;
+  size_t usado;
+  _Alignas(16) unsigned char dados[];
+} BlocoArena;
+
+/**
+ * Alocador por região: cada alocação só avança um ponteiro, e tudo é
+ * devolvido de uma vez com `esvaziar_arena`. Uma arena zerada está vazia e
+ * pronta para uso; ela não é segura para várias threads, então cada thread
+ * deve ter a sua.
+ */
+typedef struct Arena {
+  BlocoArena *bloco;
+} Arena;
+
+/**
+ * Reserva memória na arena, alinhada a 16 bytes. Quando o bloco atual
+ * acaba, um novo com pelo menos o dobro do tamanho é alocado.
+ *
+ * @param arena A arena.
+ * @param tamanho O tamanho em bytes.
+ * @return A memória, que não precisa ser liberada individualmente.
+ */
+void *alocar_na_arena(Arena *arena, size_t tamanho);
+
+/**
+ * Devolve tudo o que foi reservado na arena. O maior bloco é mantido, então
+ * depois das primeiras vezes a arena não chama mais o `malloc`.
+ *
+ * @param arena A arena.
+ */
+void esvaziar_arena(Arena *arena);
+
+/**
+ * Libera todos os blocos da arena.
+ *
+ * @param arena A arena.
+ */
+void liberar_arena(Arena *arena);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+ * monte_carlo.h - Protótipos das simulações de Monte Carlo
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include "typedefs.h"
+
+#define LIMITE_TENTATIVAS 1000
+#define SIMULACOES_POR_LOTE 1024
+
+enum { BLOQUEADA, LIVRE, COM_INIMIGO };
+
+/**
+ * O resultado de uma simulação: os passos dados em todas as vidas, as mortes
+ * até chegar na saída e quantas delas foram em combate.
+ */
+typedef struct {
+  long long passos;
+  int tentativas;
+  int mortes_em_combate;
+  int chegou;
+} Simulacao;
+
+/**
+ * O labirinto como as simulações o enxergam, com uma moldura de células
+ * bloqueadas em volta para andar sem checar os limites. `deslocamentos` segue
+ * a ordem de Direcoes, só com as quatro direções do andar: as escadas contam
+ * como bloqueadas, então a simulação nunca sai do andar da partida.
+ */
+typedef struct {
+  int largura;
+  int total;
+  int inicio;
+  int saida;
+  int deslocamentos[4];
+  char *tipos;
+} MapaSimulacao;
+
+/**
+ * Repete a tentativa e erro sem interface, `opcoes->simulacoes` vezes,
+ * dividida entre `opcoes->threads` threads, e imprime a distribuição dos
+ * passos até a saída, das tentativas e a taxa de sobrevivência.
+ *
+ * Cada simulação segue as regras de `resolver_tentativa_e_erro` e tem o seu
+ * próprio fluxo de números aleatórios, derivado da semente e do número da
+ * simulação, então o resultado é o mesmo para qualquer quantidade de threads.
+ * Uma simulação que passa de LIMITE_TENTATIVAS mortes é dada como perdida.
+ *
+ * Por padrão as simulações rodam uma por vez; com `opcoes->pistas`, 16 lado
+ * a lado em vetores (veja `pistas.h`), o que só compensa em alguns
+ * labirintos.
+ *
+ * @param labirinto A instância do labirinto, já carregada.
+ * @param opcoes As opções da linha de comando.
+ */
+void executar_monte_carlo(const Labirinto *labirinto, const Opcoes *opcoes);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * multidao.h - Protótipos da multidão guiada pelo campo
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MULTIDAO_H
+#define MULTIDAO_H
+
+#include "campo.h"
+#include "typedefs.h"
+#include <stdint.h>
+
+#define RODADAS_POR_CELULA 2
+#define RODADAS_SEM_PASSOS 16
+
+enum { AGENTE_ANDANDO, AGENTE_CHEGOU };
+
+/**
+ * Os agentes de uma multidão como estrutura de vetores: a célula (linha *
+ * colunas + coluna), o custo pago até agora e o estado de cada agente ficam
+ * em vetores separados, então uma rodada percorre cada um em sequência.
+ */
+typedef struct {
+  int quantidade;
+  int andando;
+  int *celulas;
+  int *custos;
+  uint8_t *estados;
+} Multidao;
+
+/**
+ * Põe um agente em cada partida ('@') do labirinto e mais `extras` em células
+ * passáveis sorteadas.
+ *
+ * @param multidao A multidão.
+ * @param labirinto A instância do labirinto.
+ * @param extras Quantos agentes sortear além das partidas.
+ * @param penalidade A penalidade de inimigo, que diz se inimigos são passáveis.
+ * @param semente A semente do sorteio.
+ */
+void criar_multidao(Multidao *multidao, const Labirinto *labirinto, int extras, int penalidade, uint64_t semente);
+
+/**
+ * Uma rodada: cada agente que ainda anda dá um passo na direção da seta do
+ * campo, sem busca nenhuma. Quem está numa célula sem caminho até uma saída
+ * espera no lugar.
+ *
+ * @param multidao A multidão.
+ * @param campo O campo de distâncias até as saídas.
+ * @return Quantos agentes andaram.
+ */
+int avancar_multidao(Multidao *multidao, const CampoDistancia *campo);
+
+/**
+ * Libera a memória da multidão.
+ *
+ * @param multidao A multidão.
+ */
+void liberar_multidao(Multidao *multidao);
+
+/**
+ * Simula uma multidão indo até as saídas, sem interface, e imprime o
+ * resultado. Com `opcoes->mudancas`, a cada rodada as paredes da anterior
+ * somem e outras tantas aparecem em células sorteadas, e o campo é
+ * consertado com `atualizar_campo` ao invés de refeito. A simulação acaba
+ * quando todos chegam, quando ninguém anda (por RODADAS_SEM_PASSOS rodadas
+ * seguidas, com mudanças) ou depois de RODADAS_POR_CELULA rodadas por célula
+ * do labirinto.
+ *
+ * @param labirinto A instância do labirinto, já carregada; a matriz inicial é
+ * alterada durante a simulação.
+ * @param opcoes As opções da linha de comando.
+ */
+void executar_multidao(Labirinto *labirinto, const Opcoes *opcoes);
+
+#endif
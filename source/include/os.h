@@ -60,12 +60,21 @@ void restaurar_terminal();
 
 /**
  * Se a tecla pressionada for uma das setinhas, retorna o valor correspondente
- * ou -1 se a tecla não for uma das setas. É necessário ativar o modo
+ * de Direcoes, senão a própria tecla (Enter vira '\n'). É necessário ativar o modo
  * não-canônico, pra garantir que a tecla seja lida imediatamente, sem precisar
  * dar enter.
  */
 int ler_tecla_pressionada();
 
+/**
+ * Espera até uma tecla ser pressionada ou o tempo acabar, sem consumir a
+ * tecla, que ainda deve ser lida com `ler_tecla_pressionada`.
+ *
+ * @param segundos O tempo máximo de espera; se for negativo, espera para sempre.
+ * @return 1 se houver uma tecla para ler, 0 se o tempo acabou.
+ */
+int esperar_tecla(double segundos);
+
 /**
  * Configura a saída para UTF-8 e configura o gerador de números aleatórios para
  * gerar diferentes resultados em cada execução do programa.
@@ -75,4 +84,51 @@ int ler_tecla_pressionada();
  */
 void configurar_idioma();
 
+/**
+ * Passa a saída padrão a receber bytes, sem conversão pela localidade, para
+ * textos que já estão em UTF-8. Depois disso, só `fputs` e `fwrite` devem
+ * escrever nela.
+ *
+ * No Windows, desfaz o UTF-16LE que `configurar_idioma` liga.
+ */
+void usar_saida_em_bytes();
+
+/**
+ * Retorna um instante em segundos de um relógio monotônico, que não volta
+ * no tempo se o relógio do sistema for ajustado. Só serve pra medir
+ * intervalos, subtraindo dois instantes.
+ */
+double tempo_monotonico();
+
+/**
+ * Retorna quantos processadores estão disponíveis, usado como quantidade
+ * padrão de threads dos resolvedores paralelos.
+ */
+int numero_de_processadores();
+
+/**
+ * Cria um diretório, se ele ainda não existir.
+ *
+ * @param caminho O caminho do diretório.
+ * @return Boolean, verdadeiro se o diretório existe ao final.
+ */
+int criar_diretorio(const char *caminho);
+
+/**
+ * Retorna o identificador do processo atual, usado para dar nomes únicos a
+ * arquivos temporários.
+ */
+int identificador_processo();
+
+/**
+ * Lista os arquivos de um diretório em ordem alfabética, sem os ocultos e
+ * sem os subdiretórios.
+ *
+ * @param caminho O caminho do diretório.
+ * @param quantidade Recebe quantos arquivos foram listados.
+ * @return Os caminhos dos arquivos, já com o diretório na frente; cada um e
+ * o vetor devem ser liberados com `free`. NULL se não for um diretório.
+ */
+char **listar_diretorio(const char *caminho, int *quantidade);
+
 #endif
@@ -0,0 +1,106 @@
+/*
+ * patrulhas.h - Protótipos das patrulhas e da busca no tempo
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PATRULHAS_H
+#define PATRULHAS_H
+
+#include "campo.h"
+#include "typedefs.h"
+
+#define ALCANCE_PATRULHA 4
+#define PERIODO_MAXIMO 65536
+#define FOLGA_HORIZONTE 4
+#define ESPERAR 6
+
+/**
+ * As rotas dos inimigos que patrulham e a tabela de ocupação no tempo. Cada
+ * rota é um ciclo de células, guardado em `rotas` a partir de
+ * `inicio_rotas[i]`: o inimigo i está na célula `rotas[inicio_rotas[i] + t %
+ * tamanho]` no passo t. Em vez de uma grade por passo, a ocupação guarda, para
+ * cada célula, os pares {inimigo, fase} dos momentos da rota em que algum
+ * inimigo está nela, a partir de `inicio_ocupacoes[celula]`; o espaço é o
+ * total das rotas, qualquer que seja o período. `periodo` é o mínimo múltiplo
+ * comum dos tamanhos das rotas, ou 0 se passar de PERIODO_MAXIMO.
+ */
+typedef struct {
+  int quantidade;
+  int *inicio_rotas;
+  int *rotas;
+  int *inicio_ocupacoes;
+  int (*ocupacoes)[2];
+  int periodo;
+} Patrulhas;
+
+/**
+ * Monta as rotas de todos os inimigos ('%') do labirinto. O arquivo de rotas
+ * tem uma linha por inimigo, com a linha e a coluna dele e as direções da
+ * rota em letras (A, B, E, D, < e >, como nas soluções); linhas vazias ou
+ * começadas por '#' são ignoradas. Uma rota que volta à célula de partida se
+ * repete como um circuito; as outras vão e voltam. Um inimigo fora do arquivo
+ * anda até ALCANCE_PATRULHA células em linha reta, dentro do andar, na
+ * direção com mais espaço, e volta.
+ *
+ * @param patrulhas Recebe as rotas, que devem ser liberadas com `liberar_patrulhas`.
+ * @param labirinto A instância do labirinto.
+ * @param rotas O caminho do arquivo de rotas, ou NULL para usar só as rotas padrão.
+ */
+void criar_patrulhas(Patrulhas *patrulhas, const Labirinto *labirinto, const char *rotas);
+
+/**
+ * A* no espaço-tempo: cada estado é uma célula num passo, e de um passo para o
+ * outro o jogador anda para uma vizinha ou espera (ESPERAR). Um estado é
+ * descartado se um inimigo estiver na célula naquele passo ou se o jogador
+ * cruzar com um inimigo no caminho. Como as patrulhas se repetem a cada
+ * `periodo` passos, o tempo de um estado é guardado módulo o período, e
+ * voltar a uma célula na mesma fase fecha um ciclo; sem período, a busca
+ * para num horizonte de FOLGA_HORIZONTE vezes a distância sem inimigos mais
+ * PERIODO_MAXIMO passos. Os estados ficam numa tabela de dispersão, então a
+ * memória cresce com os estados visitados, e não com células vezes passos.
+ *
+ * @param patrulhas As rotas dos inimigos.
+ * @param labirinto A instância do labirinto.
+ * @param campo O campo de distâncias com penalidade 0, usado como heurística.
+ * @param origem A posição de partida, no passo 0.
+ * @param caminho Recebe os passos até a saída, com ESPERAR nas esperas, ou NULL.
+ * @param expandidos Recebe quantos estados foram expandidos.
+ * @return A quantidade de passos até a saída, ou -1 se não houver como escapar das patrulhas.
+ */
+int planejar_no_tempo(const Patrulhas *patrulhas, const Labirinto *labirinto, const CampoDistancia *campo, int origem[2], Caminho *caminho,
+                      long long *expandidos);
+
+/**
+ * Libera as rotas e a tabela de ocupação.
+ *
+ * @param patrulhas As patrulhas.
+ */
+void liberar_patrulhas(Patrulhas *patrulhas);
+
+/**
+ * Planeja, sem interface, a fuga do jogador entre inimigos que patrulham e
+ * imprime o caminho. Os inimigos não lutam nesse modo: eles só podem ser
+ * evitados.
+ *
+ * @param labirinto A instância do labirinto, já carregada.
+ * @param opcoes As opções da linha de comando (o arquivo de rotas).
+ */
+void executar_patrulhas(Labirinto *labirinto, const Opcoes *opcoes);
+
+#endif
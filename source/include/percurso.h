@@ -0,0 +1,121 @@
+/*
+ * percurso.h - Protótipos do percurso pelos alvos
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERCURSO_H
+#define PERCURSO_H
+
+#include "typedefs.h"
+
+#define HELD_KARP_MAXIMO 16
+#define ALVOS_MAXIMO 1024
+
+/**
+ * Os pontos de um percurso e as distâncias entre eles. Os pontos são a
+ * partida (0), os alvos (1 a pontos - 2) e a saída mais próxima (pontos - 1);
+ * `celulas` só tem a partida e os alvos. `distancias[i * pontos + j]` é o
+ * custo de ir do ponto i ao j, e a linha da saída não é usada. `saidas`
+ * guarda a saída mais próxima de cada ponto e `custos`, o custo de entrar em
+ * cada um.
+ */
+typedef struct {
+  int pontos;
+  int *celulas;
+  int *distancias;
+  int *saidas;
+  int *custos;
+} Percurso;
+
+/**
+ * Lê os alvos de um arquivo, com a linha e a coluna de um alvo por linha
+ * (linhas vazias ou começadas por '#' são ignoradas), ou usa todos os
+ * inimigos do labirinto se não houver arquivo, e prepara o percurso a partir
+ * da partida principal. Alvos repetidos contam uma vez só.
+ *
+ * @param percurso Recebe os pontos, que devem ser liberados com `liberar_percurso`.
+ * @param labirinto A instância do labirinto.
+ * @param alvos O caminho do arquivo de alvos, ou NULL para usar os inimigos.
+ */
+void criar_percurso(Percurso *percurso, const Labirinto *labirinto, const char *alvos);
+
+/**
+ * Preenche a matriz de distâncias com um Dijkstra por ponto de origem, que
+ * para assim que chega a todos os alvos e a uma saída. As origens são
+ * divididas entre as threads por um contador atômico.
+ *
+ * @param percurso O percurso.
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param threads A quantidade de threads.
+ * @return Boolean, falso se algum alvo ou a saída for inalcançável.
+ */
+int medir_percurso(Percurso *percurso, const Labirinto *labirinto, int penalidade, int threads);
+
+/**
+ * Acha a ordem exata de visita aos alvos com a programação dinâmica de
+ * Held-Karp, em O(2^n * n^2) para n alvos; só serve até HELD_KARP_MAXIMO.
+ *
+ * @param percurso O percurso, já medido.
+ * @param ordem Recebe os pontos na ordem da visita, da partida à saída.
+ * @return O custo do percurso.
+ */
+long long ordenar_held_karp(const Percurso *percurso, int *ordem);
+
+/**
+ * Acha uma boa ordem de visita para muitos alvos: começa pelo vizinho mais
+ * próximo e melhora com 2-opt (inverter um trecho) e Or-opt (mudar um trecho
+ * de até três alvos de lugar) até nenhum dos dois ajudar. A partida e a
+ * saída ficam nas pontas.
+ *
+ * @param percurso O percurso, já medido.
+ * @param ordem Recebe os pontos na ordem da visita, da partida à saída.
+ * @return O custo do percurso.
+ */
+long long ordenar_2_opt(const Percurso *percurso, int *ordem);
+
+/**
+ * Junta os menores caminhos entre os pontos consecutivos da ordem, buscados
+ * com A*, num caminho só.
+ *
+ * @param percurso O percurso, já medido.
+ * @param labirinto A instância do labirinto.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param ordem Os pontos na ordem da visita.
+ * @param caminho Recebe o caminho completo.
+ */
+void montar_percurso(const Percurso *percurso, const Labirinto *labirinto, int penalidade, const int *ordem, Caminho *caminho);
+
+/**
+ * Libera os pontos e as distâncias do percurso.
+ *
+ * @param percurso O percurso.
+ */
+void liberar_percurso(Percurso *percurso);
+
+/**
+ * Resolve o percurso sem interface: passa por todos os alvos e termina numa
+ * saída, com o menor custo, e imprime a ordem e o caminho.
+ *
+ * @param labirinto A instância do labirinto, já carregada.
+ * @param opcoes As opções da linha de comando (alvos, penalidade e threads).
+ */
+void executar_percurso(Labirinto *labirinto, const Opcoes *opcoes);
+
+#endif
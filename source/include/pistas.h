@@ -0,0 +1,94 @@
+/*
+ * pistas.h - Protótipos das simulações em pistas paralelas
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PISTAS_H
+#define PISTAS_H
+
+#include "monte_carlo.h"
+#include <stdint.h>
+
+#define PISTAS 16
+
+/**
+ * Um valor por pista, com as operações aritméticas feitas nas pistas todas de
+ * uma vez (extensão de vetores do GCC). O gerador precisa de 64 bits; o resto
+ * cabe em 32, o dobro de pistas por instrução.
+ */
+typedef uint32_t Vetor __attribute__((vector_size(PISTAS * sizeof(uint32_t))));
+typedef uint64_t Vetor64 __attribute__((vector_size(PISTAS * sizeof(uint64_t))));
+
+/**
+ * Várias simulações de tentativa e erro lado a lado, uma por pista, com o
+ * estado guardado como estrutura de vetores. Um passo de todas as pistas é
+ * feito sem desvios; os eventos raros (chegar na saída, passar do limite de
+ * tentativas) são tratados depois, pista a pista.
+ *
+ * `vizinhancas` é o labirinto compactado para as pistas: um byte por célula,
+ * com os vizinhos passáveis nos bits 0 a 3 e os que têm inimigo nos bits 4 a
+ * 7, na ordem de Direcoes. `marcas` guarda em que vida cada pista visitou
+ * cada célula, com as marcas das pistas de uma mesma célula lado a lado: as
+ * pistas partem todas do mesmo ponto e dividem as mesmas linhas de cache.
+ */
+typedef struct {
+  const MapaSimulacao *mapa;
+  uint8_t *vizinhancas;
+  uint16_t *marcas;
+
+  Vetor64 estado[4];
+  Vetor64 passos;
+  Vetor posicao;
+  Vetor vida;
+  Vetor inimigos_derrotados;
+  Vetor em_combate;
+  Vetor ativa;
+  Vetor tentativas;
+  Vetor mortes_em_combate;
+  int simulacao[PISTAS];
+} Pistas;
+
+/**
+ * Prepara as pistas para um mapa.
+ *
+ * @param pistas As pistas.
+ * @param mapa O mapa das simulações.
+ */
+void criar_pistas(Pistas *pistas, const MapaSimulacao *mapa);
+
+/**
+ * Roda as simulações [inicio, fim). A simulação i usa o fluxo i da semente,
+ * como em `simular`, então o resultado é idêntico ao da versão escalar.
+ *
+ * @param pistas As pistas.
+ * @param semente A semente das simulações.
+ * @param inicio A primeira simulação.
+ * @param fim Uma depois da última simulação.
+ * @param simulacoes Recebe o resultado de cada simulação, indexado pelo seu número.
+ */
+void simular_em_pistas(Pistas *pistas, uint64_t semente, int inicio, int fim, Simulacao *simulacoes);
+
+/**
+ * Libera a memória das pistas.
+ *
+ * @param pistas As pistas.
+ */
+void liberar_pistas(Pistas *pistas);
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * poda.h - Protótipos do preenchimento de becos sem saída
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PODA_H
+#define PODA_H
+
+#include "typedefs.h"
+#include <stdint.h>
+
+/**
+ * Preenche os becos sem saída do labirinto inicial. Uma célula passável com
+ * no máximo um vizinho passável (que não seja o jogador nem uma saída) é
+ * preenchida, o que pode transformar o vizinho num beco também; uma lista de
+ * trabalho segue essa reação em cadeia em tempo linear. As células que sobram
+ * são as únicas que podem estar num caminho sem repetição até uma saída; num
+ * labirinto perfeito, sobra só a solução.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param com_inimigos Se verdadeiro, células com inimigos também são passáveis.
+ * @param mascara Vetor de linhas * colunas posições que recebe 1 nas células
+ * passáveis que sobraram e 0 nas demais.
+ * @return A quantidade de células preenchidas.
+ */
+int preencher_becos(const Labirinto *labirinto, int com_inimigos, uint8_t *mascara);
+
+#endif
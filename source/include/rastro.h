@@ -0,0 +1,133 @@
+/*
+ * rastro.h - Protótipos da gravação e reprodução de rastros
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RASTRO_H
+#define RASTRO_H
+
+#include "typedefs.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define ASSINATURA_RASTRO "LBRT"
+#define VERSAO_RASTRO 2
+#define QUADROS_ENTRE_CHAVES 256
+
+/**
+ * Cada evento é um byte: os 3 bits de baixo dizem o tipo, os 3 do meio como
+ * a posição muda em relação ao evento anterior e os 2 de cima a variante.
+ * Nos eventos de controle, os 5 bits de cima guardam o código do controle.
+ */
+typedef enum {
+  EVENTO_CONTROLE,
+  EVENTO_VISITA,     // A busca marcou a célula com '-'
+  EVENTO_RETROCESSO, // A busca voltou pela célula: variante 0 '{', 1 '}' e 2 '/'
+  EVENTO_CAMINHO,    // A célula faz parte do caminho final, montado no marco
+  EVENTO_JOGADOR,    // O jogador andou até a célula
+  EVENTO_COMBATE,    // Variante 0 vitória, 1 derrota
+  EVENTO_MORTE       // Variante 0 em combate ('+'), 1 sem saída ('?')
+} TipoEvento;
+
+/**
+ * O "marco" é a cópia guardada em `trilha.matriz`, para onde o labirinto
+ * volta quando é restaurado fora da tentativa e erro.
+ */
+typedef enum {
+  CONTROLE_QUADRO,            // Um quadro desenhado, seguido do intervalo desde o anterior em milissegundos
+  CONTROLE_INICIO,            // Começo de uma resolução, seguido das tentativas do jogador
+  CONTROLE_RESTAURAR_INICIAL, // O labirinto e o jogador voltam ao estado inicial
+  CONTROLE_RESTAURAR_MARCO,   // O labirinto volta ao marco e o jogador ao início
+  CONTROLE_MARCAR_ATUAL,      // O marco recebe o labirinto atual
+  CONTROLE_MARCAR_INICIAL,    // O marco recebe o labirinto inicial
+  CONTROLE_MOSTRAR_MARCO,     // O labirinto recebe o marco, sem mexer no jogador
+  CONTROLE_MOSTRAR_INICIAL    // O labirinto recebe o labirinto inicial, sem mexer no jogador
+} CodigoControle;
+
+/**
+ * A gravação de um rastro. O cabeçalho, com o labirinto inicial, só é escrito
+ * no primeiro evento, quando o labirinto já foi carregado.
+ */
+typedef struct Rastro {
+  FILE *arquivo;
+  int cabecalho_escrito;
+  int ultima_posicao[2];
+  double ultimo_quadro;
+} Rastro;
+
+/**
+ * Abre um arquivo para gravar o rastro das resoluções.
+ *
+ * @param nome O caminho do arquivo, que é sobrescrito.
+ * @return O rastro, que deve ser fechado com `fechar_rastro`.
+ */
+Rastro *abrir_rastro(const char *nome);
+
+/**
+ * Grava o que falta no arquivo, fecha e libera o rastro.
+ *
+ * @param rastro O rastro.
+ */
+void fechar_rastro(Rastro *rastro);
+
+/**
+ * Marca o começo de uma resolução. Também zera o relógio dos quadros, para o
+ * tempo parado no menu não entrar na reprodução.
+ *
+ * @param rastro O rastro, ou NULL se não houver gravação.
+ * @param labirinto A instância do labirinto.
+ */
+void gravar_inicio(Rastro *rastro, const Labirinto *labirinto);
+
+/**
+ * Grava um evento numa célula.
+ *
+ * @param rastro O rastro, ou NULL se não houver gravação.
+ * @param tipo O tipo do evento, que não pode ser EVENTO_CONTROLE.
+ * @param variante A variante do evento, de 0 a 3.
+ * @param posicao A célula do evento.
+ */
+void gravar_evento(Rastro *rastro, TipoEvento tipo, int variante, const int posicao[2]);
+
+/**
+ * Grava um evento de controle sem parâmetros.
+ *
+ * @param rastro O rastro, ou NULL se não houver gravação.
+ * @param codigo O código do controle.
+ */
+void gravar_controle(Rastro *rastro, CodigoControle codigo);
+
+/**
+ * Grava um quadro desenhado e o tempo passado desde o anterior.
+ *
+ * @param rastro O rastro, ou NULL se não houver gravação.
+ */
+void gravar_quadro(Rastro *rastro);
+
+/**
+ * Reproduz um rastro gravado, sem refazer a busca. Durante a reprodução,
+ * espaço pausa, + e - mudam a velocidade, as setas para os lados andam um
+ * quadro, as setas para cima e para baixo andam QUADROS_ENTRE_CHAVES quadros
+ * e q sai.
+ *
+ * @param opcoes As opções da linha de comando: o arquivo, a velocidade e o quadro inicial.
+ */
+void reproduzir_rastro(const Opcoes *opcoes);
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * resolvedor.h - Protótipos das consultas sem interface
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOLVEDOR_H
+#define RESOLVEDOR_H
+
+#include "bitmapa.h"
+#include "campo.h"
+#include "gargalos.h"
+#include "grafo.h"
+#include "hierarquia.h"
+#include "typedefs.h"
+
+typedef enum {
+  ALGORITMO_BFS,
+  ALGORITMO_A_STAR,
+  ALGORITMO_ARA,
+  ALGORITMO_CAMPO,
+  ALGORITMO_PARALELO,
+  ALGORITMO_JUNCOES,
+  ALGORITMO_HIERARQUICO,
+  ALGORITMO_GARGALOS
+} Algoritmo;
+
+/**
+ * Os nomes dos algoritmos, na ordem do enum.
+ */
+extern const char *nomes_algoritmos[];
+
+/**
+ * Um labirinto carregado junto com as estruturas que não mudam entre uma
+ * consulta e outra: os bitmapas e os gargalos a partir do jogador das duas
+ * classes de células passáveis e, para as duas penalidades mais usadas, os
+ * campos de distância até a saída, os grafos de junções e as hierarquias do
+ * HPA*. Depois de preparado, ele só é lido, então várias threads podem
+ * consultá-lo juntas.
+ */
+typedef struct {
+  Labirinto labirinto;
+  Bitmapa bitmapas[2];
+  CampoDistancia campos[2];
+  GrafoJuncoes grafos[2];
+  Hierarquia hierarquias[2];
+  Gargalos gargalos[2];
+} LabirintoPreparado;
+
+/**
+ * Carrega um labirinto e calcula as estruturas usadas pelas consultas.
+ *
+ * @param preparado O labirinto que será preparado.
+ * @param nome O caminho do arquivo do labirinto.
+ */
+void preparar_labirinto(LabirintoPreparado *preparado, const char *nome);
+
+/**
+ * Calcula só a estrutura que `resolver_consulta` vai usar com esse algoritmo
+ * e essa penalidade, para quem resolve cada labirinto uma única vez.
+ *
+ * @param preparado O labirinto preparado, com `labirinto` já carregado e o
+ * resto zerado.
+ * @param algoritmo O algoritmo da consulta.
+ * @param penalidade A penalidade da consulta.
+ */
+void preparar_para_consulta(LabirintoPreparado *preparado, Algoritmo algoritmo, int penalidade);
+
+/**
+ * Libera as estruturas calculadas para o labirinto, sem mexer nele.
+ *
+ * @param preparado O labirinto preparado.
+ */
+void liberar_estruturas(LabirintoPreparado *preparado);
+
+/**
+ * Libera o labirinto e as estruturas calculadas para ele.
+ *
+ * @param preparado O labirinto preparado.
+ */
+void liberar_labirinto_preparado(LabirintoPreparado *preparado);
+
+/**
+ * Converte o nome de um algoritmo ("bfs", "a_star", "ara", "campo",
+ * "paralelo", "juncoes", "hierarquico" ou "gargalos") no valor do enum.
+ *
+ * @param nome O nome do algoritmo.
+ * @param algoritmo Recebe o algoritmo correspondente.
+ * @return Boolean, falso se o nome não for conhecido.
+ */
+int ler_algoritmo(const char *nome, Algoritmo *algoritmo);
+
+/**
+ * Resolve uma consulta sem interface. Com várias saídas, todos os algoritmos
+ * levam à mais próxima.
+ *
+ * A busca em largura não tem pesos: ela só usa a penalidade para saber se
+ * inimigos são passáveis e para somar o custo do caminho encontrado. Os
+ * gargalos preparados só servem para consultas que partem do jogador; de
+ * outra origem, eles são calculados na hora.
+ *
+ * @param preparado O labirinto preparado.
+ * @param algoritmo O algoritmo usado.
+ * @param origem A posição de partida, que deve ser passável.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param opcoes As opções da linha de comando (threads e prazo).
+ * @param caminho Recebe o caminho encontrado.
+ * @return O custo do caminho, ou -1 se a saída for inalcançável.
+ */
+int resolver_consulta(const LabirintoPreparado *preparado, Algoritmo algoritmo, int origem[2], int penalidade, const Opcoes *opcoes,
+                      Caminho *caminho);
+
+/**
+ * Aloca um vetor de caminhos vazios, um por partida.
+ *
+ * @param quantidade A quantidade de caminhos.
+ * @return O vetor, que deve ser liberado com `free` depois de cada caminho.
+ */
+Caminho *alocar_caminhos(int quantidade);
+
+/**
+ * Resolve o labirinto de um arquivo a partir de cada partida ('@'), na ordem
+ * do arquivo; o labirinto é preparado uma vez só para todas. Com
+ * `opcoes->cache`, a chave da consulta é calculada direto do texto do
+ * arquivo e, se a solução já estiver no cache, ela é devolvida sem carregar
+ * nem preparar o labirinto; senão o labirinto é resolvido e a solução
+ * guardada. Labirintos com mais de uma partida ou saída não usam o cache.
+ *
+ * @param nome O caminho do arquivo do labirinto.
+ * @param algoritmo O algoritmo usado.
+ * @param penalidade O custo extra de entrar numa célula com inimigo, ou SEM_INIMIGOS.
+ * @param opcoes As opções da linha de comando (threads, prazo e cache).
+ * @param caminhos Recebe um caminho por partida, com custo -1 quando a saída
+ * é inalcançável dela. Cada caminho deve ser liberado com `liberar_caminho` e
+ * o vetor, com `free`.
+ * @return A quantidade de partidas.
+ */
+int resolver_arquivo(const char *nome, Algoritmo algoritmo, int penalidade, const Opcoes *opcoes, Caminho **caminhos);
+
+/**
+ * Escreve as direções de um caminho como letras: A (acima), B (abaixo),
+ * E (esquerda), D (direita), < (subir a escada) e > (descer a escada).
+ *
+ * @param arquivo O arquivo de saída.
+ * @param caminho O caminho.
+ */
+void escrever_direcoes(FILE *arquivo, const Caminho *caminho);
+
+/**
+ * As mesmas letras de `escrever_direcoes`, numa string.
+ *
+ * @param caminho O caminho.
+ * @return A string, que deve ser liberada com `free`.
+ */
+char *direcoes_em_texto(const Caminho *caminho);
+
+/**
+ * Resolve o primeiro labirinto da linha de comando com o algoritmo de
+ * `--resolver` e escreve a resposta no formato do servidor, uma linha por
+ * partida: "ok custo passos direções" ou "erro sem caminho".
+ *
+ * @param opcoes As opções da linha de comando.
+ */
+void executar_resolucao(const Opcoes *opcoes);
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * servidor.h - Protótipos do servidor de caminhos
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "typedefs.h"
+
+#define MAXIMO_CONEXOES 256
+#define PEDIDOS_POR_CONEXAO 64
+#define TAMANHO_LINHA_PEDIDO 512
+
+/**
+ * Carrega os labirintos uma única vez e atende pedidos de caminho por um
+ * socket Unix até receber SIGINT ou SIGTERM. Cada linha recebida é um pedido
+ * no formato "<labirinto> <algoritmo> [<linha> <coluna> [<penalidade>|sem]]",
+ * respondido com "ok <custo> <passos> <direções>" ou "erro <mensagem>". O
+ * pedido "listar" devolve os labirintos carregados.
+ *
+ * A thread principal espera por todas as conexões com poll e entrega cada
+ * linha completa às `opcoes->threads` threads, então nenhuma delas fica presa
+ * a um cliente. Cada conexão tem até PEDIDOS_POR_CONEXAO pedidos em
+ * andamento, respondidos na ordem em que chegaram.
+ *
+ * @param opcoes As opções da linha de comando: o caminho do socket, os
+ * arquivos dos labirintos, a quantidade de threads e o prazo do ARA*.
+ */
+void executar_servidor(const Opcoes *opcoes);
+
+#endif
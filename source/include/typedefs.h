@@ -27,7 +27,13 @@
 #define INICIO L"\033[H\033[J"
 #define ABAIXO_TITULO L"\033[6;0H"
 
-typedef enum { ACIMA, ABAIXO, ESQUERDA, DIREITA } Direcoes;
+#define TAMANHO_MAXIMO_MENU 20
+#define TAMANHO_MAXIMO 2048
+#define PENALIDADE_INIMIGO 10
+#define ANDARES_MAXIMO 16
+
+// SUBIR e DESCER só existem em labirintos com mais de um andar, e só entre escadas
+typedef enum { ACIMA, ABAIXO, ESQUERDA, DIREITA, SUBIR, DESCER } Direcoes;
 
 typedef enum {
   PAREDE        = '#',
@@ -37,7 +43,8 @@ typedef enum {
   INIMIGO       = '%',
   JOGADOR       = '@',
   SAIDA         = '$',
-  TRILHA        = '-'
+  TRILHA        = '-',
+  ESCADA        = 'H'
 } Celulas;
 
 typedef struct {
@@ -55,6 +62,12 @@ typedef struct {
   Vertice **grafo;
 } Trilha;
 
+typedef struct {
+  int *direcoes;
+  int tamanho;
+  int custo;
+} Caminho;
+
 typedef struct {
   int posicao[2];
   int posicao_inicial[2];
@@ -62,25 +75,83 @@ typedef struct {
   int tentativas;
 } Jogador;
 
+// Os andares ficam um embaixo do outro na mesma matriz, separados por uma
+// linha de paredes: `tamanho[0]` conta todas as linhas e `linhas_andar` as de
+// um andar só. Cada andar é um bloco contíguo, e a mesma célula no andar de
+// cima fica `linhas_andar + 1` linhas abaixo.
 typedef struct {
   char nome[50];
   FILE *arquivo;
   int modo;
   int tamanho[2];
+  int andares;
+  int linhas_andar;
+  int andar_visivel;
   char **matriz;
   char **matriz_inicial;
   int menu;
+  int podar_becos;
   Trilha trilha;
   Jogador jogador;
   int posicao_saida[2];
+  int (*saidas)[2];
+  int quantidade_saidas;
+  int (*partidas)[2];
+  int quantidade_partidas;
+  struct CampoDistancia *campo;
+  struct Rastro *rastro;
 } Labirinto;
 
+typedef struct {
+  const char *arquivo;
+  char **arquivos;
+  int quantidade_arquivos;
+  int benchmark;
+  int podar_becos;
+  int threads;
+  int simulacoes;
+  int pistas;
+  unsigned long long semente;
+  double prazo;
+  const char *servidor;
+  const char *gravar;
+  const char *reproduzir;
+  double velocidade;
+  int passo;
+  int estatisticas;
+  int estatisticas_json;
+  int contadores_hw;
+  const char *cronologia;
+  const char *algoritmo;
+  int penalidade;
+  const char *cache;
+  const char *lote;
+  int analisar;
+  int multidao;
+  int agentes;
+  int mudancas;
+  int patrulhas;
+  const char *rotas;
+  int percurso;
+  const char *alvos;
+} Opcoes;
+
 #define max(a, b) (((a) > (b)) ? (a) : (b))
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 
 #define parede(x) ((x) == PAREDE)
 #define inimigo(x) ((x) == INIMIGO)
 #define trilha(x) ((x) == TRILHA)
+#define escada(x) ((x) == ESCADA)
+#define passavel(x, com_inimigos) ((x) && !parede(x) && ((com_inimigos) || !inimigo(x)))
+
+// Custo de entrar numa célula, ou -1 se ela não for passável. Com penalidade
+// SEM_INIMIGOS as células com inimigo são tratadas como paredes.
+#define SEM_INIMIGOS -1
+#define custo_passo(x, penalidade) (passavel(x, (penalidade) >= 0) ? 1 + (inimigo(x) ? (penalidade) : 0) : -1)
+
+// Quantas linhas a matriz precisa para os andares e as paredes entre eles
+#define linhas_empilhadas(linhas, andares) ((andares) * ((linhas) + 1) - 1)
 
 
 #endif
\ No newline at end of file
@@ -29,6 +29,14 @@
 #include <stdlib.h>
 #include <wchar.h>
 
+#define MAXIMO_SAIDAS_ESTIMADAS 16
+
+/**
+ * Deslocamentos de linha e coluna de cada direção, na ordem do enum Direcoes.
+ */
+extern const int deslocamento_linha[4];
+extern const int deslocamento_coluna[4];
+
 /**
  * Imprime uma mensagem de erro e encerra o programa.
  *
@@ -205,4 +213,129 @@ void mensagem(Labirinto *labirinto, wchar_t *mensagem);
  */
 int checar_coordenada(int tamanho[2], int coordenada[2]);
 
+/**
+ * Quantas direções se pode andar no labirinto: as quatro do andar e, se ele
+ * tiver mais de um andar, subir e descer.
+ *
+ * @param labirinto A instância do labirinto.
+ * @return 4 ou 6.
+ */
+static inline int direcoes_do_labirinto(const Labirinto *labirinto) {
+  return labirinto->andares > 1 ? 6 : 4;
+}
+
+/**
+ * Em que andar fica uma linha da matriz, contando de 0.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param linha A linha na matriz.
+ * @return O andar.
+ */
+static inline int andar_da_linha(const Labirinto *labirinto, int linha) {
+  return labirinto->andares > 1 ? linha / (labirinto->linhas_andar + 1) : 0;
+}
+
+/**
+ * Quantas linhas do labirinto aparecem na tela: as de um andar só.
+ *
+ * @param labirinto A instância do labirinto.
+ * @return A quantidade de linhas desenhadas.
+ */
+static inline int linhas_na_tela(const Labirinto *labirinto) {
+  return labirinto->andares > 1 ? labirinto->linhas_andar : labirinto->tamanho[0];
+}
+
+/**
+ * Acha a vizinha de uma célula numa direção. Subir e descer só levam de uma
+ * escada a outra escada na mesma posição do andar vizinho; as paredes entre
+ * os andares já impedem as outras direções de passar de um andar a outro.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param linha A linha da célula.
+ * @param coluna A coluna da célula.
+ * @param direcao A direção, entre 0 e `direcoes_do_labirinto`.
+ * @param vizinha Recebe a posição da vizinha.
+ * @return Boolean, falso se não houver vizinha nessa direção.
+ */
+static inline int vizinha_na_direcao(const Labirinto *labirinto, int linha, int coluna, int direcao, int vizinha[2]) {
+  if (direcao < SUBIR) {
+    vizinha[0] = linha + deslocamento_linha[direcao];
+    vizinha[1] = coluna + deslocamento_coluna[direcao];
+    return checar_coordenada((int *)labirinto->tamanho, vizinha);
+  }
+
+  vizinha[0] = linha + (direcao == SUBIR ? 1 : -1) * (labirinto->linhas_andar + 1);
+  vizinha[1] = coluna;
+  return checar_coordenada((int *)labirinto->tamanho, vizinha) && escada(labirinto->matriz_inicial[linha][coluna]) &&
+         escada(labirinto->matriz_inicial[vizinha[0]][vizinha[1]]);
+}
+
+/**
+ * Anda uma posição uma vez na direção, sem conferir se o passo é válido.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param posicao A posição, que é atualizada.
+ * @param direcao A direção do passo.
+ */
+static inline void avancar_posicao(const Labirinto *labirinto, int posicao[2], int direcao) {
+  if (direcao < SUBIR) {
+    posicao[0] += deslocamento_linha[direcao];
+    posicao[1] += deslocamento_coluna[direcao];
+  } else {
+    posicao[0] += (direcao == SUBIR ? 1 : -1) * (labirinto->linhas_andar + 1);
+  }
+}
+
+/**
+ * A distância de manhattan com os andares: a do andar mais um passo por
+ * andar de diferença. Como cada escada custa pelo menos um passo, ela nunca
+ * passa do custo real e serve de heurística para o A*.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param ponto_atual O ponto atual na matriz do labirinto.
+ * @param destino O ponto de destino na matriz do labirinto.
+ * @return A distância entre os dois pontos.
+ */
+static inline int distancia_no_labirinto(const Labirinto *labirinto, const int ponto_atual[2], const int destino[2]) {
+  if (labirinto->andares <= 1) {
+    return abs(ponto_atual[0] - destino[0]) + abs(ponto_atual[1] - destino[1]);
+  }
+
+  const int passo = labirinto->linhas_andar + 1;
+  return abs(ponto_atual[0] % passo - destino[0] % passo) + abs(ponto_atual[1] - destino[1]) + abs(ponto_atual[0] / passo - destino[0] / passo);
+}
+
+/**
+ * A menor `distancia_no_labirinto` até uma das saídas. Com mais de
+ * MAXIMO_SAIDAS_ESTIMADAS saídas, medir todas a cada célula custaria mais do
+ * que a estimativa economiza, e ela passa a ser 0.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param ponto_atual O ponto atual na matriz do labirinto.
+ * @return A distância até a saída mais próxima.
+ */
+static inline int distancia_ate_saidas(const Labirinto *labirinto, const int ponto_atual[2]) {
+  if (labirinto->quantidade_saidas > MAXIMO_SAIDAS_ESTIMADAS) {
+    return 0;
+  }
+
+  int menor = 0;
+  for (int i = 0; i < labirinto->quantidade_saidas; ++i) {
+    const int distancia = distancia_no_labirinto(labirinto, ponto_atual, labirinto->saidas[i]);
+    menor               = i == 0 ? distancia : min(menor, distancia);
+  }
+  return menor;
+}
+
+/**
+ * Diz se a posição é uma das saídas do labirinto.
+ *
+ * @param labirinto A instância do labirinto.
+ * @param posicao A posição na matriz do labirinto.
+ * @return 1 se a posição for uma saída, 0 caso contrário.
+ */
+static inline int na_saida(const Labirinto *labirinto, const int posicao[2]) {
+  return labirinto->matriz_inicial[posicao[0]][posicao[1]] == SAIDA;
+}
+
 #endif
\ No newline at end of file
@@ -19,7 +19,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "include/cronologia.h"
 #include "include/io.h"
+#include "include/mem.h"
 #include "include/os.h"
 #include "include/util.h"
 
@@ -32,25 +34,183 @@ FILE *abrir_arquivo(const char *nome) {
   return arquivo;
 }
 
+int ler_dimensoes(const char *texto, int *linhas, int *colunas, int *andares) {
+  char cabecalho[32];
+  const size_t tamanho = strcspn(texto, "\n");
+
+  *linhas  = *colunas = 0;
+  *andares = 1;
+  if (tamanho >= sizeof cabecalho) {
+    return 0;
+  }
+
+  // O cabeçalho é copiado para que o sscanf não passe da primeira linha
+  memcpy(cabecalho, texto, tamanho);
+  cabecalho[tamanho] = '\0';
+
+  const int lidos = sscanf(cabecalho, "%d %d %d", linhas, colunas, andares);
+  return lidos >= 2 && *linhas >= 2 && *colunas >= 2 && *linhas <= TAMANHO_MAXIMO && *colunas <= TAMANHO_MAXIMO && *andares >= 1 &&
+         *andares <= ANDARES_MAXIMO;
+}
+
 void ler_arquivo(Labirinto *labirinto) {
+  TRECHO("ler_arquivo");
   int *tamanho = labirinto->tamanho;
-  char primeira_linha[10];
+  char primeira_linha[32];
+  int linhas, andares;
 
   if (fgets(primeira_linha, sizeof primeira_linha, labirinto->arquivo) == NULL)
     erro(L"Erro ao ler o tamanho do labirinto.");
 
-  if (sscanf(primeira_linha, "%d %d", &tamanho[0], &tamanho[1]) != 2)
-    erro(L"Tamanho do labirinto inválido.");
+  const int valido = ler_dimensoes(primeira_linha, &linhas, &tamanho[1], &andares);
 
-  if (tamanho[0] < 2 || tamanho[1] < 2 || tamanho[0] > 20 || tamanho[1] > 20)
+  // O limite do menu vale para cada andar, já que só um andar é desenhado por vez
+  if (labirinto->menu && (linhas < 2 || tamanho[1] < 2 || linhas > TAMANHO_MAXIMO_MENU || tamanho[1] > TAMANHO_MAXIMO_MENU))
     erro(L"Tamanho do labirinto inválido. O labirinto deve ter entre 2 e 20 "
          L"linhas e colunas.");
 
+  // Fora do menu o labirinto não é desenhado, então aceitamos tamanhos maiores
+  if (!valido)
+    erro(L"Tamanho do labirinto inválido.");
+
+  tamanho[0]                = linhas_empilhadas(linhas, andares);
+  labirinto->andares        = andares;
+  labirinto->linhas_andar   = linhas;
+  labirinto->andar_visivel  = 0;
   labirinto->matriz         = alocar_matriz(tamanho[0], tamanho[1]);
   labirinto->matriz_inicial = alocar_matriz(tamanho[0], tamanho[1]);
   labirinto->trilha.matriz  = alocar_matriz(tamanho[0], tamanho[1]);
 }
 
+void carregar_labirinto(Labirinto *labirinto, const char *nome) {
+  TRECHO("carregar_labirinto");
+  labirinto->arquivo = abrir_arquivo(nome);
+  strncpy(labirinto->nome, nome, sizeof labirinto->nome - 1);
+  labirinto->nome[sizeof(labirinto->nome) - 1] = '\0';
+  ler_arquivo(labirinto);
+  preencher_matriz(labirinto);
+}
+
+char *ler_conteudo_arquivo(const char *nome, size_t *tamanho) {
+  FILE *arquivo = fopen(nome, "rb");
+  if (arquivo == NULL) {
+    return NULL;
+  }
+
+  char *conteudo = NULL;
+  if (fseek(arquivo, 0, SEEK_END) == 0) {
+    const long bytes = ftell(arquivo);
+    conteudo         = bytes >= 0 ? malloc(bytes + 1) : NULL;
+
+    if (conteudo != NULL && (fseek(arquivo, 0, SEEK_SET) != 0 || fread(conteudo, 1, bytes, arquivo) != (size_t)bytes)) {
+      free(conteudo);
+      conteudo = NULL;
+    } else if (conteudo != NULL) {
+      conteudo[bytes] = '\0';
+      *tamanho        = bytes;
+    }
+  }
+
+  fclose(arquivo);
+  return conteudo;
+}
+
+/**
+ * Anota a posição de cada célula com o caractere, na ordem do texto.
+ *
+ * @param lista Recebe as posições, com espaço para todas.
+ */
+static void listar_posicoes(const char *celulas, long total, int colunas, char caractere, int (*lista)[2]) {
+  const char *atual = memchr(celulas, caractere, total);
+  for (int i = 0; atual != NULL; ++i) {
+    lista[i][0] = (atual - celulas) / colunas;
+    lista[i][1] = (atual - celulas) % colunas;
+    atual       = memchr(atual + 1, caractere, celulas + total - atual - 1);
+  }
+}
+
+const char *ler_labirinto_de_texto(Labirinto *labirinto, const char *texto, size_t tamanho, Arena *arena) {
+  const char *fim = texto + tamanho;
+  int linhas_andar, colunas, andares;
+
+  if (!ler_dimensoes(texto, &linhas_andar, &colunas, &andares)) {
+    return linhas_andar == 0 ? "tamanho do labirinto ausente" : "tamanho do labirinto inválido";
+  }
+
+  const char *atual = memchr(texto, '\n', fim - texto);
+  if (atual == NULL) {
+    return "labirinto sem células";
+  }
+
+  // Uma única alocação para as linhas e as células
+  const int linhas     = linhas_empilhadas(linhas_andar, andares);
+  char **matriz        = alocar_na_arena(arena, linhas * sizeof(char *) + (size_t)linhas * colunas);
+  char *celulas        = (char *)(matriz + linhas);
+  long celula          = 0;
+  const long total     = (long)linhas * colunas;
+  const long por_andar = (long)linhas_andar * colunas;
+  long fim_andar       = por_andar;
+
+  for (int i = 0; i < linhas; ++i) {
+    matriz[i] = celulas + (size_t)i * colunas;
+  }
+
+  // As linhas entre os andares já nascem paredes e são puladas na leitura
+  if (andares > 1) {
+    memset(celulas, PAREDE, total);
+  }
+
+  int partidas = 0, saidas = 0;
+
+  for (++atual; atual < fim; ++atual) {
+    const char caractere = *atual;
+    if (caractere == ' ' || caractere == '\n' || caractere == '\r') {
+      continue;
+    }
+    if (celula == total) {
+      return "células demais para o tamanho";
+    }
+
+    partidas += caractere == JOGADOR;
+    saidas += caractere == SAIDA;
+    celulas[celula++] = caractere;
+
+    if (celula == fim_andar && celula < total) {
+      celula += colunas;
+      fim_andar += por_andar + colunas;
+    }
+  }
+
+  if (celula != total) {
+    return "células de menos para o tamanho";
+  }
+  if (partidas == 0) {
+    return "labirinto sem jogador";
+  }
+  if (saidas == 0) {
+    return "labirinto sem saída";
+  }
+
+  // Só agora se sabe quantas posições há, e o memchr as acha sem pesar na leitura
+  labirinto->partidas            = alocar_na_arena(arena, partidas * sizeof(int[2]));
+  labirinto->saidas              = alocar_na_arena(arena, saidas * sizeof(int[2]));
+  labirinto->quantidade_partidas = partidas;
+  labirinto->quantidade_saidas   = saidas;
+  listar_posicoes(celulas, total, colunas, JOGADOR, labirinto->partidas);
+  listar_posicoes(celulas, total, colunas, SAIDA, labirinto->saidas);
+  copiar_matriz(labirinto->partidas[0], labirinto->jogador.posicao_inicial, sizeof(int[2]));
+  copiar_matriz(labirinto->saidas[0], labirinto->posicao_saida, sizeof(int[2]));
+
+  labirinto->tamanho[0]     = linhas;
+  labirinto->tamanho[1]     = colunas;
+  labirinto->andares        = andares;
+  labirinto->linhas_andar   = linhas_andar;
+  labirinto->matriz_inicial = matriz;
+  labirinto->matriz         = matriz;
+  copiar_matriz(labirinto->jogador.posicao_inicial, labirinto->jogador.posicao, sizeof(int[2]));
+  return NULL;
+}
+
 // TODO Tirar o scanf, está quebrando o principio de responsabilidade única
 void salvar_arquivo(const Labirinto *labirinto) {
   char nome_arquivo[100];
@@ -58,14 +218,23 @@ void salvar_arquivo(const Labirinto *labirinto) {
   wprintf(ABAIXO_TITULO L"\nDigite o nome do arquivo: ");
   scanf("%99s", nome_arquivo);
 
+  // O trecho começa depois do nome, para não contar o tempo digitando
+  TRECHO("salvar_arquivo");
   FILE *arquivo = fopen(nome_arquivo, "w");
   if (!arquivo)
     erro(L"Erro ao salvar o arquivo.");
 
-  fprintf(arquivo, "%d %d\n", labirinto->tamanho[0], labirinto->tamanho[1]);
+  if (labirinto->andares > 1)
+    fprintf(arquivo, "%d %d %d\n", labirinto->linhas_andar, labirinto->tamanho[1], labirinto->andares);
+  else
+    fprintf(arquivo, "%d %d\n", labirinto->tamanho[0], labirinto->tamanho[1]);
 
   for (int i = 0; i < labirinto->tamanho[0]; i++)
     for (int j = 0; j < labirinto->tamanho[1]; j++) {
+      // As paredes entre os andares não existem no arquivo
+      if (labirinto->andares > 1 && i % (labirinto->linhas_andar + 1) == labirinto->linhas_andar)
+        break;
+
       fputc(labirinto->matriz[i][j] == '/' || labirinto->matriz[i][j] == '{' ? CAMINHO_LIVRE :
             labirinto->matriz[i][j] == '}'                                   ? INIMIGO :
                                                                                labirinto->matriz[i][j],
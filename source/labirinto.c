@@ -20,6 +20,11 @@
  */
 
 #include "include/labirinto.h"
+#include "include/analise.h"
+#include "include/cronologia.h"
+#include "include/estatisticas.h"
+#include "include/poda.h"
+#include "include/rastro.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -28,6 +33,7 @@
 
 char *encontrar_adjacencias(char **matriz, int *tamanho, int linha, int coluna) {
   char *adjacentes = calloc(4, sizeof(char));
+  contar(alocacoes);
 
   if (adjacentes == NULL) {
     erro(L"Falha ao alocar memória para adjacentes.");
@@ -44,11 +50,33 @@ char *encontrar_adjacencias(char **matriz, int *tamanho, int linha, int coluna)
   return adjacentes;
 }
 
+/**
+ * Acrescenta uma posição a uma lista que dobra de tamanho quando enche.
+ *
+ * @param lista A lista, NULL quando ainda vazia.
+ * @param quantidade A quantidade de posições na lista.
+ */
+static void acrescentar_posicao(int (**lista)[2], int *quantidade, int linha, int coluna) {
+  // A capacidade é sempre a próxima potência de dois
+  if ((*quantidade & (*quantidade - 1)) == 0) {
+    int (*nova)[2] = realloc(*lista, max(1, *quantidade * 2) * sizeof(int[2]));
+    if (nova == NULL) {
+      erro(L"Falha ao alocar memória para as posições.");
+    }
+    *lista = nova;
+  }
+
+  (*lista)[*quantidade][0] = linha;
+  (*lista)[*quantidade][1] = coluna;
+  (*quantidade)++;
+}
+
 /**
  * Preenche a matriz com os caracteres do arquivo do labirinto, também carrega
- * as posições do jogador e da saída.
+ * as posições de todas as partidas e saídas.
  */
 void preencher_matriz(Labirinto *labirinto) {
+  TRECHO("preencher_matriz");
   const int *tamanho = labirinto->tamanho;
 
   char **linhas   = alocar_matriz(tamanho[0], tamanho[1] * 2 + 1);
@@ -57,13 +85,24 @@ void preencher_matriz(Labirinto *labirinto) {
   labirinto->trilha.stack = malloc(tamanho[0] * tamanho[1] * sizeof(int));
   labirinto->trilha.grafo = malloc(tamanho[0] * sizeof(Vertice *));
 
+  labirinto->partidas            = labirinto->saidas = NULL;
+  labirinto->quantidade_partidas = labirinto->quantidade_saidas = 0;
+
   for (int i = 0; i < tamanho[0]; ++i) {
+    labirinto->trilha.grafo[i] = calloc(tamanho[1], sizeof(Vertice));
+
+    // A linha entre dois andares não vem do arquivo, é só parede
+    if (labirinto->andares > 1 && i % (labirinto->linhas_andar + 1) == labirinto->linhas_andar) {
+      memset(labirinto->matriz[i], PAREDE, tamanho[1]);
+      memset(labirinto->matriz_inicial[i], PAREDE, tamanho[1]);
+      memset(labirinto->trilha.matriz[i], PAREDE, tamanho[1]);
+      continue;
+    }
+
     if (!fgets(linhas[i], tamanho[1] * 2 + 1, labirinto->arquivo)) {
       erro(L"Erro ao ler linha do arquivo.");
     }
 
-    labirinto->trilha.grafo[i] = calloc(tamanho[1], sizeof(Vertice));
-
     int coluna = 0;
     for (int j = 0; j < tamanho[1] * 2 && linhas[i][j] != '\0'; ++j) {
       if (linhas[i][j] != '\n' && linhas[i][j] != ' ') {
@@ -73,20 +112,28 @@ void preencher_matriz(Labirinto *labirinto) {
         labirinto->matriz_inicial[i][coluna]  = caractere;
         labirinto->trilha.matriz[i][coluna++] = caractere;
 
-        if (caractere == JOGADOR || caractere == SAIDA) {
-          int *vetor = caractere == JOGADOR ? labirinto->jogador.posicao_inicial : labirinto->posicao_saida;
-          vetor[0]   = i;
-          vetor[1]   = coluna - 1;
+        if (caractere == JOGADOR) {
+          acrescentar_posicao(&labirinto->partidas, &labirinto->quantidade_partidas, i, coluna - 1);
+        } else if (caractere == SAIDA) {
+          acrescentar_posicao(&labirinto->saidas, &labirinto->quantidade_saidas, i, coluna - 1);
         }
       }
     }
   }
 
+  if (labirinto->quantidade_partidas > 0) {
+    copiar_matriz(labirinto->partidas[0], labirinto->jogador.posicao_inicial, sizeof(int[2]));
+  }
+  if (labirinto->quantidade_saidas > 0) {
+    copiar_matriz(labirinto->saidas[0], labirinto->posicao_saida, sizeof(int[2]));
+  }
+
   limpar_matriz(linhas, tamanho[0]);
 }
 
 void matar_jogador(Labirinto *labirinto, char causa) {
   labirinto->matriz[labirinto->jogador.posicao[0]][labirinto->jogador.posicao[1]] = causa;
+  gravar_evento(labirinto->rastro, EVENTO_MORTE, causa == '+' ? 0 : 1, labirinto->jogador.posicao);
   imprimir_labirinto(labirinto);
   pausar(1);
   labirinto->jogador.tentativas++;
@@ -94,10 +141,10 @@ void matar_jogador(Labirinto *labirinto, char causa) {
 }
 
 void mover_jogador(Labirinto *labirinto, Direcoes direcao) {
-  int *pos_jogador   = labirinto->jogador.posicao;
-  int *pos_adjacente = nova_posicao(pos_jogador[0], pos_jogador[1], direcao);
+  int *pos_jogador = labirinto->jogador.posicao;
+  int pos_adjacente[2];
 
-  if (pos_adjacente[0] < 0 || pos_adjacente[0] >= labirinto->tamanho[0] || pos_adjacente[1] < 0 || pos_adjacente[1] >= labirinto->tamanho[1]) {
+  if (!vizinha_na_direcao(labirinto, pos_jogador[0], pos_jogador[1], direcao, pos_adjacente)) {
     return;
   }
 
@@ -106,20 +153,24 @@ void mover_jogador(Labirinto *labirinto, Direcoes direcao) {
   labirinto->matriz[pos_jogador[0]][pos_jogador[1]] = (labirinto->matriz_inicial[pos_jogador[0]][pos_jogador[1]] == INIMIGO) ? '!' : CAMINHO;
   copiar_matriz(pos_adjacente, pos_jogador, sizeof(int[2]));
   labirinto->matriz[pos_adjacente[0]][pos_adjacente[1]] = (caractere_adjacente == SAIDA) ? 'V' : JOGADOR;
+  labirinto->andar_visivel                              = andar_da_linha(labirinto, pos_adjacente[0]);
+  gravar_evento(labirinto->rastro, EVENTO_JOGADOR, 0, pos_adjacente);
 
   if (labirinto->matriz_inicial[pos_adjacente[0]][pos_adjacente[1]] == INIMIGO) {
     pausar(0.5);
     if ((rand() % 100) > (50 + labirinto->jogador.inimigos_derrotados * 10)) {
+      gravar_evento(labirinto->rastro, EVENTO_COMBATE, 1, pos_adjacente);
       mensagem(labirinto, L"Jogador morto em combate :(");
       matar_jogador(labirinto, '+');
     } else {
+      gravar_evento(labirinto->rastro, EVENTO_COMBATE, 0, pos_adjacente);
       labirinto->jogador.inimigos_derrotados++;
     }
   }
-  free(pos_adjacente);
 }
 
 void restaurar_labirinto(Labirinto *labirinto) {
+  contar(restauracoes);
   limpar_lateral(labirinto);
 
   copiar_matriz(labirinto->jogador.posicao_inicial, labirinto->jogador.posicao, 2 * sizeof(int));
@@ -129,33 +180,45 @@ void restaurar_labirinto(Labirinto *labirinto) {
 
   copiar_matriz_bidimensional(labirinto->modo ? labirinto->matriz_inicial : labirinto->trilha.matriz, labirinto->matriz,
                               labirinto->tamanho[0], labirinto->tamanho[1]);
+  gravar_controle(labirinto->rastro, labirinto->modo ? CONTROLE_RESTAURAR_INICIAL : CONTROLE_RESTAURAR_MARCO);
 
   copiar_matriz(labirinto->jogador.posicao_inicial, labirinto->trilha.posicao, 2 * sizeof(int));
+  labirinto->andar_visivel = andar_da_linha(labirinto, labirinto->jogador.posicao_inicial[0]);
 
   fflush(stdout);
 }
 
 int encontrar_direcoes(Labirinto *labirinto, char *permitidos, int *direcoes, int posicao[2]) {
   int direcoes_possiveis = 0;
-  char *adjacencias      = encontrar_adjacencias(labirinto->matriz, labirinto->tamanho, posicao[0], posicao[1]);
 
-  for (int i = 0; i < 4; ++i) {
-    if (adjacencias[i] && strchr(permitidos, adjacencias[i])) {
+  for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+    int vizinha[2];
+    if (!vizinha_na_direcao(labirinto, posicao[0], posicao[1], i, vizinha)) {
+      continue;
+    }
+
+    // Uma escada que a busca ainda não marcou vale como caminho livre
+    const char caractere = escada(labirinto->matriz[vizinha[0]][vizinha[1]]) ? CAMINHO_LIVRE : labirinto->matriz[vizinha[0]][vizinha[1]];
+    if (caractere && strchr(permitidos, caractere)) {
       direcoes[direcoes_possiveis++] = i;
     }
   }
 
-  free(adjacencias);
   return direcoes_possiveis;
 }
 
 void resolver_tentativa_e_erro(Labirinto *labirinto) {
+  TRECHO("resolver_tentativa_e_erro");
   labirinto->modo               = 1;
   labirinto->jogador.tentativas = 0;
+  iniciar_execucao("tentativa");
+  entrar_fase(FASE_BUSCA);
+  gravar_inicio(labirinto->rastro, labirinto);
   restaurar_labirinto(labirinto);
 
   int resolvido = 0;
-  int *direcoes = malloc(4 * sizeof(int));
+  int *direcoes = malloc(6 * sizeof(int));
+  contar(alocacoes);
 
   while (!resolvido) {
     int *pos_jogador = labirinto->jogador.posicao;
@@ -169,28 +232,35 @@ void resolver_tentativa_e_erro(Labirinto *labirinto) {
     }
 
     mover_jogador(labirinto, direcoes[rand() % direcoes_possiveis]);
+    contar(nos_expandidos);
     atualizar_interface(labirinto);
-    if (comparar_coordenadas(pos_jogador, labirinto->posicao_saida)) {
+    if (na_saida(labirinto, pos_jogador)) {
       resolvido = 1;
     }
     pausar(0.1);
   }
   free(direcoes);
+  terminar_execucao();
 }
 
 void mover_trilha(Labirinto *labirinto, int direcao) {
   int *pos_trilha = labirinto->trilha.posicao;
+  int novo_pos[2] = { pos_trilha[0], pos_trilha[1] };
 
-  int *novo_pos = nova_posicao(pos_trilha[0], pos_trilha[1], direcao);
+  avancar_posicao(labirinto, novo_pos, direcao);
 
   char caractere_adjacente = labirinto->matriz[novo_pos[0]][novo_pos[1]];
   if (caractere_adjacente != SAIDA && caractere_adjacente != INIMIGO) {
     labirinto->matriz[novo_pos[0]][novo_pos[1]] = '-';
+    gravar_evento(labirinto->rastro, EVENTO_VISITA, 0, novo_pos);
   }
 
   copiar_matriz(novo_pos, pos_trilha, sizeof(int[2]));
   labirinto->trilha.stack[labirinto->trilha.tamanho++] = direcao;
-  free(novo_pos);
+  labirinto->andar_visivel                             = andar_da_linha(labirinto, novo_pos[0]);
+  contar(nos_expandidos);
+  contar(insercoes);
+  registrar_maximo(maior_fronteira, labirinto->trilha.tamanho);
 }
 
 void retroceder_trilha(Labirinto *labirinto, int ignorando_inimigos) {
@@ -200,44 +270,100 @@ void retroceder_trilha(Labirinto *labirinto, int ignorando_inimigos) {
 
   int direcao_anterior = labirinto->trilha.stack[--labirinto->trilha.tamanho];
   int direcao          = inverter_posicao(direcao_anterior);
+  contar(retrocessos);
+  contar(remocoes);
+
+  int *pos_trilha     = labirinto->trilha.posicao;
+  int pos_anterior[2] = { pos_trilha[0], pos_trilha[1] };
 
-  int *pos_trilha   = labirinto->trilha.posicao;
-  int *pos_anterior = nova_posicao(pos_trilha[0], pos_trilha[1], direcao);
+  avancar_posicao(labirinto, pos_anterior, direcao);
 
   char caractere = labirinto->matriz_inicial[pos_trilha[0]][pos_trilha[1]];
 
-  labirinto->matriz[pos_trilha[0]][pos_trilha[1]] = (caractere == INIMIGO && ignorando_inimigos) ? '}' : (caractere == SAIDA ? '/' : '{');
+  const int variante = (caractere == INIMIGO && ignorando_inimigos) ? 1 : (caractere == SAIDA ? 2 : 0);
+
+  labirinto->matriz[pos_trilha[0]][pos_trilha[1]] = "{}/"[variante];
+  gravar_evento(labirinto->rastro, EVENTO_RETROCESSO, variante, pos_trilha);
 
   copiar_matriz(pos_anterior, pos_trilha, sizeof(int[2]));
-  free(pos_anterior);
+  labirinto->andar_visivel = andar_da_linha(labirinto, pos_anterior[0]);
 }
 
 void resolver_diretamente(Labirinto *labirinto) {
+  TRECHO("resolver_diretamente");
   labirinto->modo               = 0;
   labirinto->jogador.tentativas = 0;
 
   int ignorando_inimigos = 0;
+  iniciar_execucao("profundidade");
+  entrar_fase(FASE_PREPARO);
+  gravar_inicio(labirinto->rastro, labirinto);
   restaurar_labirinto(labirinto);
 
   copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
 
   copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->trilha.matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+  gravar_controle(labirinto->rastro, CONTROLE_MOSTRAR_INICIAL);
+  gravar_controle(labirinto->rastro, CONTROLE_MARCAR_INICIAL);
 
   int resolvido   = 0;
   int achou_saida = 0;
 
-  int *direcoes = malloc(4 * sizeof(int));
+  int *direcoes = malloc(6 * sizeof(int));
+  contar(alocacoes);
 
   int *pos_trilha = labirinto->trilha.posicao;
-  int *pos_saida  = labirinto->posicao_saida;
 
+  // Antes de animar a busca, a análise diz de uma vez se dá pra chegar na
+  // saída sem lutar, lutando ou de jeito nenhum, então a busca já começa na
+  // classe certa e um labirinto sem solução é recusado sem busca nenhuma.
+  const Trecho verificacao = comecar_trecho("analisar_labirinto");
+  AnaliseLabirinto analise;
+  analisar_labirinto(&analise, labirinto);
+  terminar_trecho(verificacao);
+
+  if (!analise.saida_alcancavel[CLASSE_SEM_INIMIGOS]) {
+    ignorando_inimigos = 1;
+
+    if (!analise.saida_alcancavel[CLASSE_COM_INIMIGOS]) {
+      mensagem(labirinto, L"Sem movimentos válidos!");
+      pausar(5);
+      resolvido = 1;
+    }
+  }
+
+  // Os becos preenchidos entram como células já exploradas, então a busca em
+  // profundidade nunca desce neles e quase não precisa retroceder
+  if (labirinto->podar_becos && !resolvido) {
+    TRECHO("preencher_becos");
+    uint8_t *mascara = malloc(labirinto->tamanho[0] * labirinto->tamanho[1] * sizeof(uint8_t));
+    contar(alocacoes);
+    if (mascara == NULL) {
+      erro(L"Falha ao alocar memória para a máscara.");
+    }
+
+    preencher_becos(labirinto, ignorando_inimigos, mascara);
+    for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+      for (int j = 0; j < labirinto->tamanho[1]; ++j) {
+        if (!mascara[i * labirinto->tamanho[1] + j] && passavel(labirinto->matriz_inicial[i][j], ignorando_inimigos)) {
+          labirinto->matriz[i][j] = '{';
+          gravar_evento(labirinto->rastro, EVENTO_RETROCESSO, 0, (int[2]){ i, j });
+        }
+      }
+    }
+    free(mascara);
+  }
+
+  entrar_fase(FASE_BUSCA);
   while (!resolvido) {
     atualizar_interface(labirinto);
 
-    if (!achou_saida && comparar_coordenadas(pos_trilha, pos_saida)) {
+    if (!achou_saida && na_saida(labirinto, pos_trilha)) {
       achou_saida = 1;
       mensagem(labirinto, L"Saída encontrada! Movendo o jogador...");
+      entrar_fase(FASE_CAMINHO);
       copiar_matriz_bidimensional(labirinto->matriz, labirinto->trilha.matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+      gravar_controle(labirinto->rastro, CONTROLE_MARCAR_ATUAL);
     }
 
     int direcoes_possiveis;
@@ -245,7 +371,7 @@ void resolver_diretamente(Labirinto *labirinto) {
     if (achou_saida) {
       int *pos_jogador = labirinto->jogador.posicao;
 
-      if (comparar_coordenadas(pos_jogador, pos_saida)) {
+      if (na_saida(labirinto, pos_jogador)) {
         resolvido = 1;
         continue;
       }
@@ -283,12 +409,18 @@ void resolver_diretamente(Labirinto *labirinto) {
     mover_trilha(labirinto, direcoes[0]);
   }
   free(direcoes);
+  terminar_execucao();
 }
 
 void resolver_a_star(Labirinto *labirinto) {
+  TRECHO("resolver_a_star");
+  iniciar_execucao("a_estrela");
+  entrar_fase(FASE_PREPARO);
+  gravar_inicio(labirinto->rastro, labirinto);
   restaurar_labirinto(labirinto);
 
   copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+  gravar_controle(labirinto->rastro, CONTROLE_MOSTRAR_INICIAL);
 
   copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->trilha.matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
 
@@ -300,15 +432,19 @@ void resolver_a_star(Labirinto *labirinto) {
   const int colunas = labirinto->tamanho[1];
 
   Vertice *stack = calloc(linhas * colunas, sizeof(Vertice));
+  contar(alocacoes);
 
   Vertice vertice_inicial = { .posicao = { labirinto->trilha.posicao[0], labirinto->trilha.posicao[1] },
                               .origem  = { -1, -1 },
-                              .custo   = dist_manhattan(labirinto->trilha.posicao, labirinto->posicao_saida) };
+                              .custo   = distancia_ate_saidas(labirinto, labirinto->trilha.posicao) };
 
   stack[labirinto->trilha.tamanho++] = vertice_inicial;
+  contar(insercoes);
+  registrar_maximo(maior_fronteira, labirinto->trilha.tamanho);
 
   char *caminhos = "-$";
 
+  entrar_fase(FASE_BUSCA);
   while (labirinto->trilha.tamanho > 0) {
     atualizar_interface(labirinto);
 
@@ -322,21 +458,28 @@ void resolver_a_star(Labirinto *labirinto) {
 
     Vertice vertice_topo = stack[menor_custo];
     stack[menor_custo]   = stack[--labirinto->trilha.tamanho];
+    contar(remocoes);
 
     if (labirinto->trilha.matriz[vertice_topo.posicao[0]][vertice_topo.posicao[1]]) {
       continue;
     }
 
     labirinto->trilha.matriz[vertice_topo.posicao[0]][vertice_topo.posicao[1]] = 1;
+    labirinto->andar_visivel                                                   = andar_da_linha(labirinto, vertice_topo.posicao[0]);
+    contar(nos_expandidos);
 
-    if (comparar_coordenadas(vertice_topo.posicao, labirinto->posicao_saida)) {
+    if (na_saida(labirinto, vertice_topo.posicao)) {
       int posicao_atual[2] = { vertice_topo.origem[0], vertice_topo.origem[1] };
+      const Trecho caminho = comecar_trecho("reconstruir_caminho");
+      entrar_fase(FASE_CAMINHO);
 
       copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->trilha.matriz, linhas, colunas);
+      gravar_controle(labirinto->rastro, CONTROLE_MARCAR_INICIAL);
 
       while (!comparar_coordenadas(posicao_atual, labirinto->trilha.posicao)) {
         if (labirinto->matriz_inicial[posicao_atual[0]][posicao_atual[1]] != INIMIGO) {
           labirinto->trilha.matriz[posicao_atual[0]][posicao_atual[1]] = '-';
+          gravar_evento(labirinto->rastro, EVENTO_CAMINHO, 0, posicao_atual);
         }
 
         atualizar_interface(labirinto);
@@ -346,11 +489,14 @@ void resolver_a_star(Labirinto *labirinto) {
       }
 
       copiar_matriz_bidimensional(labirinto->trilha.matriz, labirinto->matriz, linhas, colunas);
+      gravar_controle(labirinto->rastro, CONTROLE_MOSTRAR_MARCO);
+      terminar_trecho(caminho);
 
-      int *direcoes          = malloc(4 * sizeof(int));
+      int *direcoes          = malloc(6 * sizeof(int));
+      contar(alocacoes);
       int direcoes_possiveis = 0;
 
-      while (!comparar_coordenadas(labirinto->jogador.posicao, labirinto->posicao_saida)) {
+      while (!na_saida(labirinto, labirinto->jogador.posicao)) {
         direcoes_possiveis = encontrar_direcoes(labirinto, caminhos, direcoes, labirinto->jogador.posicao);
 
         if (!direcoes_possiveis) {
@@ -372,33 +518,35 @@ void resolver_a_star(Labirinto *labirinto) {
       break;
     }
 
-    for (int i = 0; i < 4; ++i) {
-      int *pos_adjacente = nova_posicao(vertice_topo.posicao[0], vertice_topo.posicao[1], i);
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      int pos_adjacente[2];
 
-      if (!checar_coordenada(labirinto->tamanho, pos_adjacente) || parede(labirinto->matriz[pos_adjacente[0]][pos_adjacente[1]]) ||
-          labirinto->trilha.matriz[pos_adjacente[0]][pos_adjacente[1]]) {
-        free(pos_adjacente);
+      if (!vizinha_na_direcao(labirinto, vertice_topo.posicao[0], vertice_topo.posicao[1], i, pos_adjacente) ||
+          parede(labirinto->matriz[pos_adjacente[0]][pos_adjacente[1]]) || labirinto->trilha.matriz[pos_adjacente[0]][pos_adjacente[1]]) {
         continue;
       }
 
       char caractere = labirinto->matriz[pos_adjacente[0]][pos_adjacente[1]];
-      int peso       = vertice_topo.peso + 1 + (inimigo(caractere) ? 10 : 0);
+      int peso       = vertice_topo.peso + 1 + (inimigo(caractere) ? PENALIDADE_INIMIGO : 0);
 
       Vertice vertice_adjacente = { .peso    = peso,
-                                    .custo   = peso + dist_manhattan(pos_adjacente, labirinto->posicao_saida),
+                                    .custo   = peso + distancia_ate_saidas(labirinto, pos_adjacente),
                                     .posicao = { pos_adjacente[0], pos_adjacente[1] },
                                     .origem  = { vertice_topo.posicao[0], vertice_topo.posicao[1] } };
 
       stack[labirinto->trilha.tamanho++] = vertice_adjacente;
+      contar(insercoes);
+      registrar_maximo(maior_fronteira, labirinto->trilha.tamanho);
 
       if (!comparar_coordenadas(vertice_adjacente.origem, vertice_inicial.origem) && !inimigo(caractere)) {
         labirinto->matriz[pos_adjacente[0]][pos_adjacente[1]] = '-';
+        gravar_evento(labirinto->rastro, EVENTO_VISITA, 0, pos_adjacente);
       }
 
       labirinto->trilha.grafo[pos_adjacente[0]][pos_adjacente[1]] = vertice_adjacente;
-      free(pos_adjacente);
     }
     pausar(0.05);
   }
   free(stack);
+  terminar_execucao();
 }
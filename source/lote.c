@@ -0,0 +1,618 @@
+/*
+ * lote.c - Resolução em lote de muitos labirintos com roubo de trabalho
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/lote.h"
+#include "include/cache.h"
+#include "include/cronologia.h"
+#include "include/io.h"
+#include "include/mem.h"
+#include "include/os.h"
+#include "include/resolvedor.h"
+#include "include/util.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Um texto que cresce conforme é escrito.
+ */
+typedef struct {
+  char *dados;
+  size_t tamanho;
+  size_t capacidade;
+} Texto;
+
+/**
+ * Um labirinto da entrada. Os que vêm de arquivos só têm o `nome`, e a
+ * thread que os pegar lê o arquivo; os da entrada padrão já chegam com o
+ * `texto`. O `resultado` é a linha JSON, escrita pela thread, que depois
+ * marca a tarefa como `pronta`.
+ */
+typedef struct {
+  char *nome;
+  char *texto;
+  size_t tamanho;
+  long indice;
+  char *resultado;
+  int falhou;
+  _Atomic int pronta;
+} Tarefa;
+
+typedef enum { ENTRADA_DIRETORIO, ENTRADA_LISTA, ENTRADA_FLUXO } TipoEntrada;
+
+/**
+ * De onde vêm os labirintos. No fluxo, `cabecalho` guarda o cabeçalho válido
+ * que a leitura achou depois de um inválido, e que abre o próximo labirinto.
+ */
+typedef struct {
+  TipoEntrada tipo;
+  char **arquivos;
+  int quantidade_arquivos;
+  int proximo_arquivo;
+  FILE *arquivo;
+  Texto cabecalho;
+} Entrada;
+
+/**
+ * A parte de uma faixa de tarefas que ainda não foi pega, com o começo nos 32
+ * bits de baixo e o fim nos de cima, para a dona (que pega do começo) e os
+ * ladrões (que pegam do fim) disputarem a faixa numa única troca atômica. Os
+ * limites são índices da entrada módulo 2^32, e a tarefa de um índice fica na
+ * vaga dele módulo JANELA_TAREFAS. Cada faixa ocupa a sua própria linha de
+ * cache.
+ */
+typedef struct {
+  _Alignas(64) _Atomic uint64_t limites;
+} Faixa;
+
+struct Lote;
+
+typedef struct {
+  struct Lote *lote;
+  int indice;
+  pthread_t thread;
+  Arena arena;
+  long roubados;
+} TrabalhadorLote;
+
+/**
+ * O estado compartilhado do lote. `tarefas` é a janela circular; `trava`
+ * protege as contagens, e as condições avisam as threads de trabalho de que
+ * há tarefas lidas (ou de que a entrada acabou) e a thread principal de que
+ * a tarefa `aguardada`, a mais antiga ainda não escrita, ficou pronta.
+ */
+typedef struct Lote {
+  const Opcoes *opcoes;
+  Algoritmo algoritmo;
+  Tarefa *tarefas;
+  Faixa *faixas;
+  TrabalhadorLote *trabalhadores;
+  int threads;
+  pthread_mutex_t trava;
+  pthread_cond_t chegaram;
+  pthread_cond_t concluiu;
+  long publicadas;
+  long distribuidas;
+  long aguardada;
+  int fim_da_entrada;
+} Lote;
+
+static void reservar(Texto *texto, size_t extra) {
+  if (texto->tamanho + extra + 1 <= texto->capacidade) {
+    return;
+  }
+
+  texto->capacidade = max(texto->capacidade * 2, texto->tamanho + extra + 1);
+  texto->dados      = realloc(texto->dados, texto->capacidade);
+  if (texto->dados == NULL) {
+    erro(L"Falha ao alocar memória para o lote.");
+  }
+}
+
+static void acrescentar_caractere(Texto *texto, char caractere) {
+  reservar(texto, 1);
+  texto->dados[texto->tamanho++] = caractere;
+  texto->dados[texto->tamanho]   = '\0';
+}
+
+/**
+ * Formata direto no espaço livre do texto; se não couber, o texto cresce para
+ * o tamanho que o vsnprintf informou e a formatação é refeita.
+ */
+static void acrescentar(Texto *texto, const char *formato, ...) {
+  va_list argumentos;
+
+  reservar(texto, strlen(formato));
+  for (;;) {
+    const size_t livre = texto->capacidade - texto->tamanho;
+
+    va_start(argumentos, formato);
+    const int tamanho = vsnprintf(texto->dados + texto->tamanho, livre, formato, argumentos);
+    va_end(argumentos);
+
+    if (tamanho < 0) {
+      erro(L"Falha ao formatar o resultado do lote.");
+    }
+    if ((size_t)tamanho < livre) {
+      texto->tamanho += tamanho;
+      return;
+    }
+    reservar(texto, tamanho);
+  }
+}
+
+static void acrescentar_string_json(Texto *texto, const char *string) {
+  acrescentar_caractere(texto, '"');
+  for (; *string; ++string) {
+    const unsigned char caractere = *string;
+    if (caractere == '"' || caractere == '\\') {
+      acrescentar(texto, "\\%c", caractere);
+    } else if (caractere < 0x20) {
+      acrescentar(texto, "\\u%04x", caractere);
+    } else {
+      acrescentar_caractere(texto, caractere);
+    }
+  }
+  acrescentar_caractere(texto, '"');
+}
+
+/**
+ * Acrescenta ao texto uma linha do fluxo, terminada em '\n'.
+ *
+ * @return 0 se o fluxo já tinha acabado.
+ */
+static int ler_linha(FILE *fluxo, Texto *texto) {
+  int caractere = fgetc(fluxo);
+
+  if (caractere == EOF) {
+    return 0;
+  }
+  for (; caractere != EOF && caractere != '\n'; caractere = fgetc(fluxo)) {
+    acrescentar_caractere(texto, caractere);
+  }
+  acrescentar_caractere(texto, '\n');
+  return 1;
+}
+
+static int em_branco(const char *linha) {
+  return linha[strspn(linha, " \r\n")] == '\0';
+}
+
+/**
+ * Lê o próximo labirinto de uma sequência concatenada: o cabeçalho e as
+ * linhas de células que ele declara, uma por linha de cada andar, sem contar
+ * linhas em branco. A última termina na quebra de linha ou na última célula,
+ * já que um arquivo sem quebra de linha no fim emenda nela o cabeçalho do
+ * próximo labirinto.
+ *
+ * Um cabeçalho inválido vira uma tarefa só com ele, que sai como erro, e a
+ * leitura pula até o próximo cabeçalho válido.
+ */
+static int ler_do_fluxo(Entrada *entrada, Tarefa *tarefa) {
+  FILE *fluxo = entrada->arquivo;
+  Texto texto = entrada->cabecalho;
+
+  entrada->cabecalho = (Texto){ 0 };
+  while (texto.dados == NULL || em_branco(texto.dados)) {
+    texto.tamanho = 0;
+    if (!ler_linha(fluxo, &texto)) {
+      free(texto.dados);
+      return 0;
+    }
+  }
+
+  int linhas, colunas, andares;
+  if (!ler_dimensoes(texto.dados, &linhas, &colunas, &andares)) {
+    Texto *proximo = &entrada->cabecalho;
+
+    while (proximo->tamanho = 0, ler_linha(fluxo, proximo)) {
+      if (ler_dimensoes(proximo->dados, &linhas, &colunas, &andares)) {
+        break;
+      }
+    }
+    if (proximo->tamanho == 0) {
+      free(proximo->dados);
+      *proximo = (Texto){ 0 };
+    }
+  } else {
+    const int total = andares * linhas;
+
+    for (int linha = 0; linha < total;) {
+      int celulas = 0, caractere;
+
+      while ((caractere = fgetc(fluxo)) != EOF && caractere != '\n') {
+        acrescentar_caractere(&texto, caractere);
+        celulas += caractere != ' ' && caractere != '\r';
+        if (linha == total - 1 && celulas == colunas) {
+          break;
+        }
+      }
+      acrescentar_caractere(&texto, '\n');
+
+      if (caractere == EOF) {
+        break;
+      }
+      linha += celulas > 0;
+    }
+  }
+
+  tarefa->texto   = texto.dados;
+  tarefa->tamanho = texto.tamanho;
+  return 1;
+}
+
+/**
+ * Lê a próxima linha não vazia da lista de arquivos.
+ */
+static char *ler_da_lista(FILE *lista) {
+  char linha[4096];
+
+  while (fgets(linha, sizeof linha, lista)) {
+    linha[strcspn(linha, "\r\n")] = '\0';
+    if (linha[0] != '\0') {
+      char *nome = malloc(strlen(linha) + 1);
+      if (nome == NULL) {
+        erro(L"Falha ao alocar memória para o lote.");
+      }
+      return strcpy(nome, linha);
+    }
+  }
+
+  return NULL;
+}
+
+static void abrir_entrada(Entrada *entrada, const char *caminho) {
+  *entrada = (Entrada){ 0 };
+
+  if (strcmp(caminho, "-") == 0) {
+    entrada->tipo    = ENTRADA_FLUXO;
+    entrada->arquivo = stdin;
+  } else if ((entrada->arquivos = listar_diretorio(caminho, &entrada->quantidade_arquivos)) != NULL) {
+    entrada->tipo = ENTRADA_DIRETORIO;
+  } else if ((entrada->arquivo = fopen(caminho, "r")) != NULL) {
+    entrada->tipo = ENTRADA_LISTA;
+  } else {
+    erro(L"A entrada do lote não é um diretório, uma lista de arquivos nem \"-\".");
+  }
+}
+
+static void fechar_entrada(Entrada *entrada) {
+  if (entrada->tipo == ENTRADA_LISTA) {
+    fclose(entrada->arquivo);
+  }
+
+  // Os nomes que não chegaram a virar tarefas ainda são da entrada
+  for (int i = entrada->proximo_arquivo; i < entrada->quantidade_arquivos; ++i) {
+    free(entrada->arquivos[i]);
+  }
+  free(entrada->arquivos);
+  free(entrada->cabecalho.dados);
+}
+
+/**
+ * Lê o próximo labirinto da entrada para a tarefa.
+ *
+ * @return 0 quando a entrada acabou.
+ */
+static int ler_tarefa(Entrada *entrada, Tarefa *tarefa) {
+  if (entrada->tipo == ENTRADA_DIRETORIO) {
+    if (entrada->proximo_arquivo == entrada->quantidade_arquivos) {
+      return 0;
+    }
+    tarefa->nome = entrada->arquivos[entrada->proximo_arquivo++];
+    return 1;
+  }
+  if (entrada->tipo == ENTRADA_LISTA) {
+    return (tarefa->nome = ler_da_lista(entrada->arquivo)) != NULL;
+  }
+  return ler_do_fluxo(entrada, tarefa);
+}
+
+/**
+ * Acrescenta às linhas da tarefa o registro JSON de uma partida, terminado
+ * em '\n'. `partida` é -1 quando o erro é do labirinto, antes de haver
+ * partidas.
+ */
+static void escrever_resultado(Texto *linhas, const Lote *lote, Tarefa *tarefa, int partida, const char *falha, const Caminho *caminho,
+                               int do_cache, double segundos) {
+  acrescentar(linhas, "{\"indice\":%ld,\"labirinto\":", tarefa->indice);
+  if (tarefa->nome) {
+    acrescentar_string_json(linhas, tarefa->nome);
+  } else {
+    acrescentar(linhas, "\"-#%ld\"", tarefa->indice);
+  }
+  if (partida >= 0) {
+    acrescentar(linhas, ",\"partida\":%d", partida);
+  }
+  acrescentar(linhas, ",\"algoritmo\":\"%s\"", nomes_algoritmos[lote->algoritmo]);
+
+  if (falha != NULL) {
+    acrescentar(linhas, ",\"erro\":");
+    acrescentar_string_json(linhas, falha);
+  } else {
+    char *direcoes = direcoes_em_texto(caminho);
+    acrescentar(linhas, ",\"custo\":%d,\"passos\":%d,\"direcoes\":\"%s\"", caminho->custo, caminho->tamanho, direcoes);
+    free(direcoes);
+  }
+
+  acrescentar(linhas, ",\"cache\":%s,\"ms\":%.3f}\n", do_cache ? "true" : "false", segundos * 1e3);
+  tarefa->falhou += falha != NULL;
+}
+
+/**
+ * Resolve o labirinto da tarefa a partir de cada partida, na ordem do
+ * arquivo, como `resolver_arquivo`: o labirinto é preparado uma vez só, e
+ * cada partida vira um registro. O tempo de cada registro é o do labirinto
+ * inteiro.
+ */
+static void resolver_tarefa(TrabalhadorLote *trabalhador, Tarefa *tarefa) {
+  TRECHO("resolver_tarefa");
+  const Lote *lote     = trabalhador->lote;
+  const Opcoes *opcoes = lote->opcoes;
+  const double inicio  = tempo_monotonico();
+  Caminho *caminhos    = NULL;
+  const char *falha    = NULL;
+  int partidas         = 0;
+  int do_cache         = 0;
+  ChaveCache chave;
+
+  esvaziar_arena(&trabalhador->arena);
+
+  if (tarefa->texto == NULL) {
+    tarefa->texto = ler_conteudo_arquivo(tarefa->nome, &tarefa->tamanho);
+  }
+
+  if (tarefa->texto == NULL) {
+    falha = "arquivo não pôde ser lido";
+  } else {
+    const int com_cache = opcoes->cache != NULL && calcular_chave_cache(&chave, tarefa->texto, tarefa->tamanho, lote->algoritmo,
+                                                                        opcoes->penalidade, opcoes->prazo);
+    Caminho guardado = { 0 };
+    do_cache         = com_cache && buscar_no_cache(opcoes->cache, &chave, &guardado);
+
+    if (do_cache) {
+      partidas    = 1;
+      caminhos    = alocar_caminhos(1);
+      caminhos[0] = guardado;
+    } else {
+      LabirintoPreparado preparado = { 0 };
+      falha                        = ler_labirinto_de_texto(&preparado.labirinto, tarefa->texto, tarefa->tamanho, &trabalhador->arena);
+
+      if (falha == NULL) {
+        preparar_para_consulta(&preparado, lote->algoritmo, opcoes->penalidade);
+        partidas = preparado.labirinto.quantidade_partidas;
+        caminhos = alocar_caminhos(partidas);
+
+        for (int i = 0; i < partidas; ++i) {
+          caminhos[i].custo =
+            resolver_consulta(&preparado, lote->algoritmo, preparado.labirinto.partidas[i], opcoes->penalidade, opcoes, &caminhos[i]);
+        }
+        liberar_estruturas(&preparado);
+
+        // Só labirintos com uma partida e uma saída têm chave no cache
+        if (com_cache) {
+          guardar_no_cache(opcoes->cache, &chave, caminhos[0].custo, &caminhos[0]);
+        }
+      }
+    }
+  }
+
+  const double segundos = tempo_monotonico() - inicio;
+  Texto linhas          = { 0 };
+
+  if (falha != NULL) {
+    escrever_resultado(&linhas, lote, tarefa, -1, falha, NULL, do_cache, segundos);
+  }
+  for (int i = 0; i < partidas; ++i) {
+    escrever_resultado(&linhas, lote, tarefa, i, caminhos[i].custo < 0 ? "sem caminho" : NULL, &caminhos[i], do_cache, segundos);
+    liberar_caminho(&caminhos[i]);
+  }
+  tarefa->resultado = linhas.dados;
+
+  free(caminhos);
+  free(tarefa->texto);
+  tarefa->texto = NULL;
+}
+
+// Os limites dão a volta em 2^32, então a faixa está vazia quando a
+// diferença entre eles, com sinal, não é positiva
+static int pegar_do_comeco(Faixa *faixa) {
+  uint64_t limites = atomic_load(&faixa->limites);
+
+  for (;;) {
+    const uint32_t comeco = (uint32_t)limites, fim = limites >> 32;
+    if ((int32_t)(fim - comeco) <= 0) {
+      return -1;
+    }
+    if (atomic_compare_exchange_weak(&faixa->limites, &limites, (uint64_t)fim << 32 | (uint32_t)(comeco + 1))) {
+      return comeco % JANELA_TAREFAS;
+    }
+  }
+}
+
+static int roubar_do_fim(Faixa *faixa) {
+  uint64_t limites = atomic_load(&faixa->limites);
+
+  for (;;) {
+    const uint32_t comeco = (uint32_t)limites, fim = limites >> 32;
+    if ((int32_t)(fim - comeco) <= 0) {
+      return -1;
+    }
+    if (atomic_compare_exchange_weak(&faixa->limites, &limites, (uint64_t)(uint32_t)(fim - 1) << 32 | comeco)) {
+      return (fim - 1) % JANELA_TAREFAS;
+    }
+  }
+}
+
+/**
+ * Espera haver tarefas lidas e ainda não distribuídas e põe na faixa da
+ * thread a parte que lhe cabe delas, dividindo-as entre todas as threads.
+ *
+ * @return 0 se a entrada acabou e todas as tarefas já foram distribuídas.
+ */
+static int pegar_faixa(Lote *lote, Faixa *faixa) {
+  pthread_mutex_lock(&lote->trava);
+  while (lote->distribuidas == lote->publicadas && !lote->fim_da_entrada) {
+    pthread_cond_wait(&lote->chegaram, &lote->trava);
+  }
+
+  const long comeco    = lote->distribuidas;
+  const long pendentes = lote->publicadas - comeco;
+  const long fim       = comeco + (pendentes > 0 ? max(1, pendentes / lote->threads) : 0);
+  lote->distribuidas   = fim;
+  pthread_mutex_unlock(&lote->trava);
+
+  if (comeco == fim) {
+    return 0;
+  }
+  atomic_store(&faixa->limites, (uint64_t)(uint32_t)fim << 32 | (uint32_t)comeco);
+  return 1;
+}
+
+static void *trabalhar_no_lote(void *argumento) {
+  TrabalhadorLote *trabalhador = argumento;
+  Lote *lote                   = trabalhador->lote;
+  Faixa *faixa                 = &lote->faixas[trabalhador->indice];
+
+  for (;;) {
+    int vaga = pegar_do_comeco(faixa);
+
+    for (int i = 1; vaga < 0 && i < lote->threads; ++i) {
+      vaga = roubar_do_fim(&lote->faixas[(trabalhador->indice + i) % lote->threads]);
+      trabalhador->roubados += vaga >= 0;
+    }
+
+    // Só sem nada para roubar a thread pega uma faixa nova
+    if (vaga < 0) {
+      if (!pegar_faixa(lote, faixa)) {
+        return NULL;
+      }
+      continue;
+    }
+
+    resolver_tarefa(trabalhador, &lote->tarefas[vaga]);
+
+    pthread_mutex_lock(&lote->trava);
+    lote->tarefas[vaga].pronta = 1;
+    if (lote->tarefas[vaga].indice == lote->aguardada) {
+      pthread_cond_signal(&lote->concluiu);
+    }
+    pthread_mutex_unlock(&lote->trava);
+  }
+}
+
+void executar_lote(const Opcoes *opcoes) {
+  Lote lote = { .opcoes = opcoes, .algoritmo = ALGORITMO_A_STAR, .threads = opcoes->threads, .aguardada = -1 };
+
+  if (opcoes->algoritmo != NULL && !ler_algoritmo(opcoes->algoritmo, &lote.algoritmo)) {
+    erro(L"Algoritmo desconhecido.");
+  }
+
+  lote.tarefas       = calloc(JANELA_TAREFAS, sizeof(Tarefa));
+  lote.faixas        = aligned_alloc(_Alignof(Faixa), lote.threads * sizeof(Faixa));
+  lote.trabalhadores = calloc(lote.threads, sizeof(TrabalhadorLote));
+  if (lote.tarefas == NULL || lote.faixas == NULL || lote.trabalhadores == NULL) {
+    erro(L"Falha ao alocar memória para o lote.");
+  }
+
+  Entrada entrada;
+  abrir_entrada(&entrada, opcoes->lote);
+
+  // As linhas já são UTF-8, e uma localidade que não fosse UTF-8 as truncaria
+  usar_saida_em_bytes();
+
+  pthread_mutex_init(&lote.trava, NULL);
+  pthread_cond_init(&lote.chegaram, NULL);
+  pthread_cond_init(&lote.concluiu, NULL);
+
+  // As threads vivem o lote inteiro, e a principal só lê a entrada e escreve os resultados
+  const double inicio = tempo_monotonico();
+  for (int i = 0; i < lote.threads; ++i) {
+    atomic_init(&lote.faixas[i].limites, 0);
+    lote.trabalhadores[i].lote   = &lote;
+    lote.trabalhadores[i].indice = i;
+    pthread_create(&lote.trabalhadores[i].thread, NULL, trabalhar_no_lote, &lote.trabalhadores[i]);
+  }
+
+  long lidas = 0, escritas = 0, falhas = 0, roubados = 0;
+  int acabou = 0;
+
+  while (!acabou || escritas < lidas) {
+    // Lê enquanto houver vaga na janela e libera as tarefas para as threads
+    // em grupos de TAREFAS_POR_PUBLICACAO, para não acordá-las a cada uma
+    while (!acabou && lidas - escritas < JANELA_TAREFAS) {
+      Tarefa *tarefa = &lote.tarefas[lidas % JANELA_TAREFAS];
+      *tarefa        = (Tarefa){ .indice = lidas };
+      acabou         = !ler_tarefa(&entrada, tarefa);
+      lidas += !acabou;
+
+      if (acabou || lidas - escritas == JANELA_TAREFAS || lidas - lote.publicadas >= TAREFAS_POR_PUBLICACAO) {
+        pthread_mutex_lock(&lote.trava);
+        lote.publicadas     = lidas;
+        lote.fim_da_entrada = acabou;
+        pthread_cond_broadcast(&lote.chegaram);
+        pthread_mutex_unlock(&lote.trava);
+      }
+    }
+
+    // Com a janela cheia ou a entrada no fim, espera a tarefa mais antiga
+    pthread_mutex_lock(&lote.trava);
+    lote.aguardada = escritas;
+    while (escritas < lidas && !lote.tarefas[escritas % JANELA_TAREFAS].pronta) {
+      pthread_cond_wait(&lote.concluiu, &lote.trava);
+    }
+    pthread_mutex_unlock(&lote.trava);
+
+    for (; escritas < lidas && lote.tarefas[escritas % JANELA_TAREFAS].pronta; ++escritas) {
+      Tarefa *tarefa = &lote.tarefas[escritas % JANELA_TAREFAS];
+      fputs(tarefa->resultado, stdout);
+      falhas += tarefa->falhou;
+      free(tarefa->resultado);
+      free(tarefa->nome);
+    }
+  }
+  fflush(stdout);
+
+  for (int i = 0; i < lote.threads; ++i) {
+    pthread_join(lote.trabalhadores[i].thread, NULL);
+  }
+
+  const double segundos = tempo_monotonico() - inicio;
+  for (int i = 0; i < lote.threads; ++i) {
+    roubados += lote.trabalhadores[i].roubados;
+    liberar_arena(&lote.trabalhadores[i].arena);
+  }
+
+  fwprintf(stderr, L"%ld labirintos em %.3f s (%.0f por segundo) com %d threads, %ld resultados com erro, %ld roubados.\n",
+           lidas, segundos, lidas / max(segundos, 1e-9), lote.threads, falhas, roubados);
+
+  pthread_mutex_destroy(&lote.trava);
+  pthread_cond_destroy(&lote.chegaram);
+  pthread_cond_destroy(&lote.concluiu);
+  fechar_entrada(&entrada);
+  free(lote.tarefas);
+  free(lote.faixas);
+  free(lote.trabalhadores);
+}
@@ -19,25 +19,230 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "include/analise.h"
+#include "include/benchmark.h"
+#include "include/cronologia.h"
+#include "include/estatisticas.h"
+#include "include/io.h"
+#include "include/lote.h"
+#include "include/monte_carlo.h"
+#include "include/multidao.h"
 #include "include/os.h"
+#include "include/patrulhas.h"
+#include "include/percurso.h"
+#include "include/rastro.h"
+#include "include/resolvedor.h"
+#include "include/servidor.h"
 #include "include/typedefs.h"
 #include "include/ui.h"
 #include "include/util.h"
 
 #include <signal.h>
 #include <string.h>
+#include <time.h>
 
-int main(int argc, char **argv) {
-  signal(SIGINT, terminar_programa);
-  configurar_idioma();
+/**
+ * Lê as opções da linha de comando. Os argumentos sem "--" são arquivos de
+ * labirinto; o menu e o benchmark usam só o primeiro.
+ */
+static void ler_opcoes(int argc, char **argv, Opcoes *opcoes) {
+  opcoes->threads    = numero_de_processadores();
+  opcoes->prazo      = 0.1;
+  opcoes->semente    = time(NULL);
+  opcoes->penalidade = PENALIDADE_INIMIGO;
+  opcoes->arquivos   = malloc(argc * sizeof(char *));
+
+  if (opcoes->arquivos == NULL) {
+    erro(L"Falha ao alocar memória para as opções.");
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--benchmark") == 0) {
+      opcoes->benchmark = 1;
+    } else if (strcmp(argv[i], "--podar") == 0) {
+      opcoes->podar_becos = 1;
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      const int threads = atoi(argv[++i]);
+      opcoes->threads   = max(1, threads);
+    } else if (strcmp(argv[i], "--prazo") == 0 && i + 1 < argc) {
+      opcoes->prazo = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--monte-carlo") == 0 && i + 1 < argc) {
+      const int simulacoes = atoi(argv[++i]);
+      opcoes->simulacoes   = max(1, simulacoes);
+    } else if (strcmp(argv[i], "--pistas") == 0) {
+      opcoes->pistas = 1;
+    } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+      opcoes->semente = strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--servidor") == 0 && i + 1 < argc) {
+      opcoes->servidor = argv[++i];
+    } else if (strcmp(argv[i], "--gravar") == 0 && i + 1 < argc) {
+      opcoes->gravar = argv[++i];
+    } else if (strcmp(argv[i], "--reproduzir") == 0 && i + 1 < argc) {
+      opcoes->reproduzir = argv[++i];
+    } else if (strcmp(argv[i], "--velocidade") == 0 && i + 1 < argc) {
+      opcoes->velocidade = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--passo") == 0 && i + 1 < argc) {
+      opcoes->passo = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--resolver") == 0 && i + 1 < argc) {
+      opcoes->algoritmo = argv[++i];
+    } else if (strcmp(argv[i], "--custo") == 0 && i + 1 < argc) {
+      ++i;
+      opcoes->penalidade = strcmp(argv[i], "sem") == 0 ? SEM_INIMIGOS : max(0, atoi(argv[i]));
+    } else if (strcmp(argv[i], "--multidao") == 0) {
+      opcoes->multidao = 1;
+    } else if (strcmp(argv[i], "--agentes") == 0 && i + 1 < argc) {
+      const int agentes = atoi(argv[++i]);
+      opcoes->agentes   = max(0, agentes);
+    } else if (strcmp(argv[i], "--mudancas") == 0 && i + 1 < argc) {
+      const int mudancas = atoi(argv[++i]);
+      opcoes->mudancas   = max(0, mudancas);
+    } else if (strcmp(argv[i], "--patrulhas") == 0) {
+      opcoes->patrulhas = 1;
+    } else if (strcmp(argv[i], "--rotas") == 0 && i + 1 < argc) {
+      opcoes->rotas = argv[++i];
+    } else if (strcmp(argv[i], "--percurso") == 0) {
+      opcoes->percurso = 1;
+    } else if (strcmp(argv[i], "--alvos") == 0 && i + 1 < argc) {
+      opcoes->alvos = argv[++i];
+    } else if (strcmp(argv[i], "--analisar") == 0) {
+      opcoes->analisar = 1;
+    } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+      opcoes->lote = argv[++i];
+    } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+      opcoes->cache = argv[++i];
+    } else if (strcmp(argv[i], "--cronologia") == 0 && i + 1 < argc) {
+      opcoes->cronologia = argv[++i];
+    } else if (strcmp(argv[i], "--perf") == 0) {
+      opcoes->contadores_hw = 1;
+    } else if (strcmp(argv[i], "--stats") == 0) {
+      opcoes->estatisticas = 1;
+      if (i + 1 < argc && (strcmp(argv[i + 1], "json") == 0 || strcmp(argv[i + 1], "tabela") == 0)) {
+        opcoes->estatisticas_json = strcmp(argv[++i], "json") == 0;
+      }
+    } else {
+      opcoes->arquivos[opcoes->quantidade_arquivos++] = argv[i];
+    }
+  }
+
+  opcoes->arquivo = opcoes->quantidade_arquivos ? opcoes->arquivos[0] : NULL;
+}
+
+/**
+ * Executa o modo escolhido na linha de comando; sem nenhum, abre o menu.
+ */
+static void executar_modo(const Opcoes *opcoes) {
   Labirinto labirinto_atual = { 0 };
 
-  if (argc >= 2) {
-    labirinto_atual.arquivo = abrir_arquivo(argv[1]);
-    strncpy(labirinto_atual.nome, argv[1], sizeof labirinto_atual.nome - 1);
+  if (opcoes->cronologia) {
+    iniciar_cronologia(opcoes->cronologia);
+  }
+
+  if (opcoes->servidor) {
+    executar_servidor(opcoes);
+    return;
+  }
+
+  if (opcoes->lote) {
+    executar_lote(opcoes);
+    return;
+  }
+
+  if (opcoes->algoritmo) {
+    executar_resolucao(opcoes);
+    return;
+  }
+
+  if (opcoes->reproduzir) {
+    reproduzir_rastro(opcoes);
+    return;
+  }
+
+  if (opcoes->simulacoes) {
+    if (opcoes->arquivo == NULL) {
+      erro(L"Informe o labirinto para as simulações.");
+    }
+    carregar_labirinto(&labirinto_atual, opcoes->arquivo);
+    executar_monte_carlo(&labirinto_atual, opcoes);
+    fechar_labirinto(&labirinto_atual);
+    return;
+  }
+
+  if (opcoes->multidao) {
+    if (opcoes->arquivo == NULL) {
+      erro(L"Informe o labirinto para a multidão.");
+    }
+    carregar_labirinto(&labirinto_atual, opcoes->arquivo);
+    executar_multidao(&labirinto_atual, opcoes);
+    fechar_labirinto(&labirinto_atual);
+    return;
+  }
+
+  if (opcoes->patrulhas) {
+    if (opcoes->arquivo == NULL) {
+      erro(L"Informe o labirinto para as patrulhas.");
+    }
+    carregar_labirinto(&labirinto_atual, opcoes->arquivo);
+    executar_patrulhas(&labirinto_atual, opcoes);
+    fechar_labirinto(&labirinto_atual);
+    return;
+  }
+
+  if (opcoes->percurso) {
+    if (opcoes->arquivo == NULL) {
+      erro(L"Informe o labirinto para o percurso.");
+    }
+    carregar_labirinto(&labirinto_atual, opcoes->arquivo);
+    executar_percurso(&labirinto_atual, opcoes);
+    fechar_labirinto(&labirinto_atual);
+    return;
+  }
+
+  if (opcoes->analisar) {
+    if (opcoes->arquivo == NULL) {
+      erro(L"Informe o labirinto para a análise.");
+    }
+    AnaliseLabirinto analise;
+    carregar_labirinto(&labirinto_atual, opcoes->arquivo);
+    analisar_labirinto(&analise, &labirinto_atual);
+    analisar_gargalos(&analise, &labirinto_atual);
+    imprimir_analise(&analise);
+    fechar_labirinto(&labirinto_atual);
+    return;
+  }
+
+  if (opcoes->benchmark) {
+    if (opcoes->arquivo == NULL) {
+      erro(L"Informe o labirinto para o benchmark.");
+    }
+    carregar_labirinto(&labirinto_atual, opcoes->arquivo);
+    executar_benchmark(&labirinto_atual, opcoes);
+    fechar_labirinto(&labirinto_atual);
+    return;
+  }
+
+  if (opcoes->estatisticas) {
+    relatar_estatisticas_ao_sair(opcoes->estatisticas_json ? RELATORIO_JSON : RELATORIO_TABELA, opcoes->contadores_hw);
+  }
+
+  labirinto_atual.podar_becos = opcoes->podar_becos;
+  labirinto_atual.rastro      = opcoes->gravar ? abrir_rastro(opcoes->gravar) : NULL;
+
+  if (opcoes->arquivo != NULL) {
+    labirinto_atual.arquivo = abrir_arquivo(opcoes->arquivo);
+    strncpy(labirinto_atual.nome, opcoes->arquivo, sizeof labirinto_atual.nome - 1);
     labirinto_atual.nome[sizeof(labirinto_atual.nome) - 1] = '\0';
   }
 
   imprimir_tela(&labirinto_atual);
+}
+
+int main(int argc, char **argv) {
+  signal(SIGINT, terminar_programa);
+  configurar_idioma();
+  Opcoes opcoes = { 0 };
+
+  ler_opcoes(argc, argv, &opcoes);
+  executar_modo(&opcoes);
+  free(opcoes.arquivos);
   return 0;
 }
@@ -20,6 +20,8 @@
  */
 
 #include "include/mem.h"
+#include "include/campo.h"
+#include "include/rastro.h"
 
 void limpar_matriz(char **matriz, int linhas) {
   for (int i = 0; i < linhas; ++i)
@@ -54,6 +56,12 @@ void copiar_matriz_bidimensional(char **origem, char **destino, int linhas, int
     copiar_matriz(origem[i], destino[i], colunas * sizeof(char));
 }
 
+void liberar_caminho(Caminho *caminho) {
+  free(caminho->direcoes);
+  caminho->direcoes = NULL;
+  caminho->tamanho  = 0;
+}
+
 void fechar_labirinto(Labirinto *labirinto) {
   const int linhas = labirinto->tamanho[0];
   fclose(labirinto->arquivo);
@@ -62,4 +70,63 @@ void fechar_labirinto(Labirinto *labirinto) {
   limpar_matriz(labirinto->trilha.matriz, linhas);
   limpar_matriz((char **)labirinto->trilha.grafo, linhas);
   free(labirinto->trilha.stack);
-}
\ No newline at end of file
+  free(labirinto->partidas);
+  free(labirinto->saidas);
+  labirinto->partidas = labirinto->saidas = NULL;
+
+  if (labirinto->campo != NULL) {
+    liberar_campo(labirinto->campo);
+    free(labirinto->campo);
+  }
+
+  if (labirinto->rastro != NULL) {
+    fechar_rastro(labirinto->rastro);
+    labirinto->rastro = NULL;
+  }
+}
+
+void *alocar_na_arena(Arena *arena, size_t tamanho) {
+  tamanho = (tamanho + 15) & ~(size_t)15;
+
+  BlocoArena *bloco = arena->bloco;
+  if (bloco == NULL || bloco->capacidade - bloco->usado < tamanho) {
+    const size_t capacidade = max(max(tamanho, BLOCO_MINIMO_ARENA), bloco ? bloco->capacidade * 2 : 0);
+
+    BlocoArena *novo = malloc(sizeof(BlocoArena) + capacidade);
+    if (novo == NULL) {
+      erro(L"Falha ao alocar memória para a arena.");
+    }
+
+    novo->anterior   = bloco;
+    novo->capacidade = capacidade;
+    novo->usado      = 0;
+    arena->bloco     = bloco = novo;
+  }
+
+  void *memoria = bloco->dados + bloco->usado;
+  bloco->usado += tamanho;
+  return memoria;
+}
+
+void esvaziar_arena(Arena *arena) {
+  if (arena->bloco == NULL) {
+    return;
+  }
+
+  // O bloco mais novo é sempre o maior
+  BlocoArena *anterior = arena->bloco->anterior;
+  while (anterior != NULL) {
+    BlocoArena *proximo = anterior->anterior;
+    free(anterior);
+    anterior = proximo;
+  }
+
+  arena->bloco->anterior = NULL;
+  arena->bloco->usado    = 0;
+}
+
+void liberar_arena(Arena *arena) {
+  esvaziar_arena(arena);
+  free(arena->bloco);
+  arena->bloco = NULL;
+}
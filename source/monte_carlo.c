@@ -0,0 +1,249 @@
+/*
+ * monte_carlo.c - Simulações de Monte Carlo da tentativa e erro
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/monte_carlo.h"
+#include "include/aleatorio.h"
+#include "include/cronologia.h"
+#include "include/os.h"
+#include "include/pistas.h"
+#include "include/util.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+typedef struct {
+  const MapaSimulacao *mapa;
+  const Opcoes *opcoes;
+  Simulacao *simulacoes;
+  atomic_int proxima;
+} Trabalho;
+
+static void montar_mapa(MapaSimulacao *mapa, const Labirinto *labirinto) {
+  const int linhas = labirinto->tamanho[0], colunas = labirinto->tamanho[1];
+
+  mapa->largura       = colunas + 2;
+  mapa->total         = (linhas + 2) * mapa->largura;
+  mapa->inicio        = (labirinto->jogador.posicao_inicial[0] + 1) * mapa->largura + labirinto->jogador.posicao_inicial[1] + 1;
+  mapa->saida         = (labirinto->posicao_saida[0] + 1) * mapa->largura + labirinto->posicao_saida[1] + 1;
+  mapa->tipos         = calloc(mapa->total, sizeof(char));
+  const int passos[4] = { -mapa->largura, mapa->largura, -1, 1 };
+
+  if (mapa->tipos == NULL) {
+    erro(L"Falha ao alocar memória para as simulações.");
+  }
+
+  copiar_matriz((void *)passos, mapa->deslocamentos, sizeof(passos));
+
+  // Só entram as células que a tentativa e erro aceita (".%$"); o jogador
+  // nunca volta para a posição inicial
+  for (int i = 0; i < linhas; ++i) {
+    for (int j = 0; j < colunas; ++j) {
+      const char celula                            = labirinto->matriz_inicial[i][j];
+      mapa->tipos[(i + 1) * mapa->largura + j + 1] = inimigo(celula) ? COM_INIMIGO : celula == CAMINHO_LIVRE || celula == SAIDA;
+    }
+  }
+}
+
+/**
+ * Uma simulação completa: vidas seguidas até chegar na saída. Numa vida, o
+ * jogador anda sorteando entre as células vizinhas que ainda não visitou,
+ * morre se ficar sem saída e, ao entrar num inimigo, morre com a mesma chance
+ * de `mover_jogador`. `marcas` guarda em que vida cada célula foi visitada.
+ */
+static void simular(const MapaSimulacao *mapa, Gerador *gerador, unsigned *marcas, unsigned *vida, Simulacao *simulacao) {
+  *simulacao = (Simulacao){ 0 };
+
+  while (simulacao->tentativas < LIMITE_TENTATIVAS) {
+    int posicao = mapa->inicio, inimigos_derrotados = 0, morreu = 0;
+
+    marcas[posicao] = ++*vida;
+
+    while (!morreu) {
+      int opcoes[4], quantidade = 0;
+
+      for (int i = 0; i < 4; ++i) {
+        const int adjacente = posicao + mapa->deslocamentos[i];
+        if (mapa->tipos[adjacente] != BLOQUEADA && marcas[adjacente] != *vida) {
+          opcoes[quantidade++] = adjacente;
+        }
+      }
+
+      if (quantidade == 0) {
+        morreu = 1;
+        break;
+      }
+
+      posicao         = opcoes[sortear(gerador, quantidade)];
+      marcas[posicao] = *vida;
+      simulacao->passos++;
+
+      if (mapa->tipos[posicao] == COM_INIMIGO) {
+        if ((int)sortear(gerador, 100) > 50 + inimigos_derrotados * 10) {
+          simulacao->mortes_em_combate++;
+          morreu = 1;
+        } else {
+          inimigos_derrotados++;
+        }
+      } else if (posicao == mapa->saida) {
+        simulacao->chegou = 1;
+        return;
+      }
+    }
+
+    simulacao->tentativas++;
+  }
+}
+
+static void *trabalhador(void *argumento) {
+  Trabalho *trabalho        = argumento;
+  const MapaSimulacao *mapa = trabalho->mapa;
+  const Opcoes *opcoes      = trabalho->opcoes;
+  unsigned *marcas          = NULL;
+  unsigned vida             = 0;
+  Pistas pistas;
+
+  if (opcoes->pistas) {
+    criar_pistas(&pistas, mapa);
+  } else {
+    marcas = calloc(mapa->total, sizeof(unsigned));
+    if (marcas == NULL) {
+      erro(L"Falha ao alocar memória para as simulações.");
+    }
+  }
+
+  for (;;) {
+    const int inicio = atomic_fetch_add(&trabalho->proxima, SIMULACOES_POR_LOTE);
+    const int fim    = min(inicio + SIMULACOES_POR_LOTE, opcoes->simulacoes);
+
+    if (inicio >= opcoes->simulacoes) {
+      break;
+    }
+
+    TRECHO("simular_lote");
+    if (opcoes->pistas) {
+      simular_em_pistas(&pistas, opcoes->semente, inicio, fim, trabalho->simulacoes);
+    } else {
+      for (int i = inicio; i < fim; ++i) {
+        Gerador gerador;
+        semear_gerador(&gerador, opcoes->semente, i);
+        simular(mapa, &gerador, marcas, &vida, &trabalho->simulacoes[i]);
+      }
+    }
+  }
+
+  if (opcoes->pistas) {
+    liberar_pistas(&pistas);
+  } else {
+    free(marcas);
+  }
+  return NULL;
+}
+
+static int comparar_long_long(const void *a, const void *b) {
+  const long long x = *(const long long *)a, y = *(const long long *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * Imprime média, desvio padrão, mínimo, percentis e máximo. Os valores são
+ * ordenados no lugar.
+ */
+static void imprimir_distribuicao(const wchar_t *nome, long long *valores, int quantidade) {
+  if (quantidade == 0) {
+    wprintf(L"  %-22ls %10ls\n", nome, L"-");
+    return;
+  }
+
+  double soma = 0, soma_quadrados = 0;
+  for (int i = 0; i < quantidade; ++i) {
+    soma += valores[i];
+    soma_quadrados += (double)valores[i] * valores[i];
+  }
+
+  const double media = soma / quantidade;
+  qsort(valores, quantidade, sizeof(long long), comparar_long_long);
+
+  wprintf(L"  %-22ls %10.1f %10.1f %8lld %8lld %8lld %8lld %8lld\n", nome, media, sqrt(fmax(0, soma_quadrados / quantidade - media * media)),
+          valores[0], valores[quantidade / 2], valores[(int)(quantidade * 0.9)], valores[(int)(quantidade * 0.99)], valores[quantidade - 1]);
+}
+
+void executar_monte_carlo(const Labirinto *labirinto, const Opcoes *opcoes) {
+  MapaSimulacao mapa;
+  montar_mapa(&mapa, labirinto);
+
+  Trabalho trabalho = { .mapa = &mapa, .opcoes = opcoes, .simulacoes = malloc(opcoes->simulacoes * sizeof(Simulacao)) };
+  pthread_t *threads = malloc(opcoes->threads * sizeof(pthread_t));
+
+  if (trabalho.simulacoes == NULL || threads == NULL) {
+    erro(L"Falha ao alocar memória para as simulações.");
+  }
+
+  atomic_init(&trabalho.proxima, 0);
+
+  const double inicio = tempo_monotonico();
+  for (int i = 0; i < opcoes->threads; ++i) {
+    pthread_create(&threads[i], NULL, trabalhador, &trabalho);
+  }
+  for (int i = 0; i < opcoes->threads; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+  const double segundos = tempo_monotonico() - inicio;
+
+  long long *passos     = malloc(opcoes->simulacoes * sizeof(long long));
+  long long *tentativas = malloc(opcoes->simulacoes * sizeof(long long));
+  long long vidas = 0, mortes_em_combate = 0, mortes = 0;
+  int chegaram = 0;
+
+  if (passos == NULL || tentativas == NULL) {
+    erro(L"Falha ao alocar memória para as simulações.");
+  }
+
+  for (int i = 0; i < opcoes->simulacoes; ++i) {
+    const Simulacao *simulacao = &trabalho.simulacoes[i];
+
+    vidas += simulacao->tentativas + simulacao->chegou;
+    mortes += simulacao->tentativas;
+    mortes_em_combate += simulacao->mortes_em_combate;
+
+    if (simulacao->chegou) {
+      passos[chegaram]       = simulacao->passos;
+      tentativas[chegaram++] = simulacao->tentativas;
+    }
+  }
+
+  wprintf(L"Labirinto: %s (%dx%d)\n", labirinto->nome, labirinto->tamanho[0], labirinto->tamanho[1]);
+  wprintf(L"  %d simulações, semente %llu, %d threads, %ls: %.3f s (%.0f simulações/s)\n", opcoes->simulacoes, opcoes->semente, opcoes->threads,
+          opcoes->pistas ? L"em pistas" : L"escalar", segundos, opcoes->simulacoes / segundos);
+  wprintf(L"  Chegaram à saída: %d (%.2f%%), desistência após %d mortes\n", chegaram, 100.0 * chegaram / opcoes->simulacoes, LIMITE_TENTATIVAS);
+  wprintf(L"  %-22ls %10ls %10ls %8ls %8ls %8ls %8ls %8ls\n", L"", L"média", L"desvio", L"mín", L"p50", L"p90", L"p99", L"máx");
+  imprimir_distribuicao(L"passos até a saída", passos, chegaram);
+  imprimir_distribuicao(L"tentativas", tentativas, chegaram);
+  wprintf(L"  Sobrevivência: %.2f%% das vidas (%lld mortes em combate, %lld sem saída)\n", vidas ? 100.0 * (vidas - mortes) / vidas : 0,
+          mortes_em_combate, mortes - mortes_em_combate);
+
+  free(passos);
+  free(tentativas);
+  free(trabalho.simulacoes);
+  free(threads);
+  free(mapa.tipos);
+}
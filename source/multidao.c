@@ -0,0 +1,223 @@
+/*
+ * multidao.c - Multidão de agentes guiada pelo campo de distâncias
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/multidao.h"
+#include "include/aleatorio.h"
+#include "include/cronologia.h"
+#include "include/os.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+
+void criar_multidao(Multidao *multidao, const Labirinto *labirinto, int extras, int penalidade, uint64_t semente) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+
+  // As células passáveis são listadas uma vez, para o sorteio não errar o alvo
+  int *passaveis = malloc((size_t)linhas * colunas * sizeof(int));
+  int livres     = 0;
+  if (passaveis == NULL) {
+    erro(L"Falha ao alocar memória para a multidão.");
+  }
+
+  for (int i = 0; i < linhas; ++i) {
+    for (int j = 0; j < colunas; ++j) {
+      if (passavel(labirinto->matriz_inicial[i][j], penalidade >= 0)) {
+        passaveis[livres++] = i * colunas + j;
+      }
+    }
+  }
+
+  extras               = livres > 0 ? extras : 0;
+  multidao->quantidade = labirinto->quantidade_partidas + extras;
+  multidao->andando    = multidao->quantidade;
+  multidao->celulas    = malloc(max(1, multidao->quantidade) * sizeof(int));
+  multidao->custos     = calloc(max(1, multidao->quantidade), sizeof(int));
+  multidao->estados    = calloc(max(1, multidao->quantidade), sizeof(uint8_t));
+
+  if (multidao->celulas == NULL || multidao->custos == NULL || multidao->estados == NULL) {
+    erro(L"Falha ao alocar memória para a multidão.");
+  }
+
+  for (int i = 0; i < labirinto->quantidade_partidas; ++i) {
+    multidao->celulas[i] = labirinto->partidas[i][0] * colunas + labirinto->partidas[i][1];
+  }
+
+  Gerador gerador;
+  semear_gerador(&gerador, semente, 0);
+  for (int i = 0; i < extras; ++i) {
+    multidao->celulas[labirinto->quantidade_partidas + i] = passaveis[sortear(&gerador, livres)];
+  }
+
+  free(passaveis);
+}
+
+int avancar_multidao(Multidao *multidao, const CampoDistancia *campo) {
+  const int deslocamentos[6] = { -campo->colunas, campo->colunas, -1, 1, campo->passo_andar, -campo->passo_andar };
+  const int *distancias      = campo->distancias;
+  int andaram                = 0;
+
+  for (int i = 0; i < multidao->quantidade; ++i) {
+    if (multidao->estados[i] != AGENTE_ANDANDO) {
+      continue;
+    }
+
+    const int celula  = multidao->celulas[i];
+    const int direcao = campo->proximo[celula];
+
+    if (distancias[celula] == 0) {
+      multidao->estados[i] = AGENTE_CHEGOU;
+      multidao->andando--;
+      continue;
+    }
+    if (direcao == SEM_DIRECAO) {
+      continue;
+    }
+
+    // A diferença das distâncias é o custo de entrar na próxima célula
+    const int destino    = celula + deslocamentos[direcao];
+    multidao->celulas[i] = destino;
+    multidao->custos[i] += distancias[celula] - distancias[destino];
+    andaram++;
+
+    if (distancias[destino] == 0) {
+      multidao->estados[i] = AGENTE_CHEGOU;
+      multidao->andando--;
+    }
+  }
+
+  return andaram;
+}
+
+void liberar_multidao(Multidao *multidao) {
+  free(multidao->celulas);
+  free(multidao->custos);
+  free(multidao->estados);
+}
+
+void executar_multidao(Labirinto *labirinto, const Opcoes *opcoes) {
+  const int linhas     = labirinto->tamanho[0];
+  const int colunas    = labirinto->tamanho[1];
+  const int mudancas   = opcoes->mudancas;
+  const long long fim  = (long long)RODADAS_POR_CELULA * linhas * colunas;
+  char **matriz        = labirinto->matriz_inicial;
+  int (*alteradas)[2]  = malloc(max(1, 2 * mudancas) * sizeof(int[2]));
+  int (*bloqueadas)[2] = malloc(max(1, mudancas) * sizeof(int[2]));
+  char *originais      = malloc(max(1, mudancas));
+
+  if (alteradas == NULL || bloqueadas == NULL || originais == NULL) {
+    erro(L"Falha ao alocar memória para a multidão.");
+  }
+
+  Multidao multidao;
+  criar_multidao(&multidao, labirinto, opcoes->agentes, opcoes->penalidade, opcoes->semente);
+
+  CampoDistancia campo;
+  double inicio = tempo_monotonico();
+  calcular_campo(&campo, labirinto, opcoes->penalidade);
+  const double tempo_campo = tempo_monotonico() - inicio;
+
+  Gerador gerador;
+  semear_gerador(&gerador, opcoes->semente, 1);
+
+  long long rodadas = 0, passos = 0, agentes_movidos = 0, refeitas = 0;
+  double tempo_rodadas = 0, tempo_atualizacoes = 0;
+  int quantidade_bloqueadas = 0, rodadas_paradas = 0;
+
+  while (multidao.andando > 0 && rodadas < fim) {
+    rodadas++;
+
+    // As paredes da rodada anterior somem e outras aparecem; saídas e
+    // paredes de verdade nunca são sorteadas
+    if (mudancas > 0) {
+      int quantidade = 0;
+      for (int i = 0; i < quantidade_bloqueadas; ++i) {
+        matriz[bloqueadas[i][0]][bloqueadas[i][1]] = originais[i];
+        alteradas[quantidade][0]                   = bloqueadas[i][0];
+        alteradas[quantidade++][1]                 = bloqueadas[i][1];
+      }
+
+      quantidade_bloqueadas = 0;
+      for (int i = 0; i < mudancas; ++i) {
+        const int linha = sortear(&gerador, linhas), coluna = sortear(&gerador, colunas);
+        if (parede(matriz[linha][coluna]) || matriz[linha][coluna] == SAIDA) {
+          continue;
+        }
+
+        originais[quantidade_bloqueadas]     = matriz[linha][coluna];
+        bloqueadas[quantidade_bloqueadas][0] = alteradas[quantidade][0] = linha;
+        bloqueadas[quantidade_bloqueadas][1] = alteradas[quantidade][1] = coluna;
+        matriz[linha][coluna]                = PAREDE;
+        quantidade_bloqueadas++;
+        quantidade++;
+      }
+
+      const Trecho trecho = comecar_trecho("atualizar_campo");
+      inicio              = tempo_monotonico();
+      refeitas += atualizar_campo(&campo, labirinto, alteradas, quantidade);
+      tempo_atualizacoes += tempo_monotonico() - inicio;
+      terminar_trecho(trecho);
+    }
+
+    const Trecho trecho = comecar_trecho("avancar_multidao");
+    inicio              = tempo_monotonico();
+    agentes_movidos += multidao.andando;
+    const int andaram = avancar_multidao(&multidao, &campo);
+    tempo_rodadas += tempo_monotonico() - inicio;
+    passos += andaram;
+    terminar_trecho(trecho);
+
+    // Sem mudanças, ninguém mais vai andar; com elas, os bloqueios duram uma
+    // rodada, então só para quem ficou parado por várias seguidas
+    rodadas_paradas = andaram ? 0 : rodadas_paradas + 1;
+    if (rodadas_paradas >= (mudancas ? RODADAS_SEM_PASSOS : 1)) {
+      break;
+    }
+  }
+
+  for (int i = 0; i < quantidade_bloqueadas; ++i) {
+    matriz[bloqueadas[i][0]][bloqueadas[i][1]] = originais[i];
+  }
+
+  long long custo_total = 0;
+  for (int i = 0; i < multidao.quantidade; ++i) {
+    custo_total += multidao.estados[i] == AGENTE_CHEGOU ? multidao.custos[i] : 0;
+  }
+  const int chegaram = multidao.quantidade - multidao.andando;
+
+  wprintf(L"Labirinto: %s (%dx%d)\n", labirinto->nome, linhas, colunas);
+  wprintf(L"  %d agentes (%d nas partidas), semente %llu, campo inicial em %.3f ms\n", multidao.quantidade, labirinto->quantidade_partidas,
+          opcoes->semente, tempo_campo * 1e3);
+  wprintf(L"  Chegaram à saída: %d (%.2f%%) em %lld rodadas, custo médio %.1f\n", chegaram,
+          multidao.quantidade ? 100.0 * chegaram / multidao.quantidade : 0, rodadas, chegaram ? (double)custo_total / chegaram : 0);
+  wprintf(L"  Rodadas: %.3f ms cada, %.1f milhões de agentes por segundo, %lld passos\n", rodadas ? tempo_rodadas * 1e3 / rodadas : 0,
+          tempo_rodadas > 0 ? agentes_movidos / tempo_rodadas / 1e6 : 0, passos);
+  if (mudancas > 0) {
+    wprintf(L"  Campo: %.3f ms por atualização, %.1f células refeitas por rodada (de %d)\n", tempo_atualizacoes * 1e3 / rodadas,
+            (double)refeitas / rodadas, linhas * colunas);
+  }
+
+  liberar_campo(&campo);
+  liberar_multidao(&multidao);
+  free(alteradas);
+  free(bloqueadas);
+  free(originais);
+}
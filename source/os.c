@@ -20,10 +20,40 @@
  */
 
 #include "include/os.h"
+#include "include/util.h"
 #include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <wchar.h>
 
+static int comparar_caminhos(const void *a, const void *b) {
+  return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * Acrescenta um caminho à lista, juntando o diretório e o nome.
+ */
+static void acrescentar_caminho(char ***caminhos, int *quantidade, int *capacidade, const char *diretorio, const char *nome) {
+  if (*quantidade == *capacidade) {
+    *capacidade = max(16, *capacidade * 2);
+    *caminhos   = realloc(*caminhos, *capacidade * sizeof(char *));
+    if (*caminhos == NULL) {
+      erro(L"Falha ao alocar memória para a lista de arquivos.");
+    }
+  }
+
+  const size_t tamanho = strlen(diretorio) + strlen(nome) + 2;
+  char *completo       = malloc(tamanho);
+  if (completo == NULL) {
+    erro(L"Falha ao alocar memória para a lista de arquivos.");
+  }
+
+  snprintf(completo, tamanho, "%s/%s", diretorio, nome);
+  (*caminhos)[(*quantidade)++] = completo;
+}
+
 #ifdef _WIN32
 #include <conio.h>
 #include <fcntl.h>
@@ -48,10 +78,81 @@ void restaurar_terminal() {
 
 int ler_tecla_pressionada() {
   int caractere = _getch();
-  return (caractere == 224) ? (_getch() == 72 ? ACIMA : ABAIXO) : (caractere == '\r' || caractere == '\n' ? '\n' : -1);
+
+  if (caractere == 224) {
+    switch (_getch()) {
+    case 72: return ACIMA;
+    case 80: return ABAIXO;
+    case 75: return ESQUERDA;
+    case 77: return DIREITA;
+    }
+    return -1;
+  }
+
+  return (caractere == '\r' || caractere == '\n') ? '\n' : caractere;
+}
+
+int esperar_tecla(double segundos) {
+  const DWORD espera = segundos < 0 ? INFINITE : (DWORD)(segundos * 1000);
+  return WaitForSingleObject(entrada_terminal, espera) == WAIT_OBJECT_0 && _kbhit();
+}
+
+double tempo_monotonico() {
+  LARGE_INTEGER frequencia, contador;
+  QueryPerformanceFrequency(&frequencia);
+  QueryPerformanceCounter(&contador);
+  return (double)contador.QuadPart / (double)frequencia.QuadPart;
+}
+
+int numero_de_processadores() {
+  SYSTEM_INFO informacoes;
+  GetSystemInfo(&informacoes);
+  return informacoes.dwNumberOfProcessors;
+}
+
+int criar_diretorio(const char *caminho) {
+  return CreateDirectoryA(caminho, NULL) || GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+int identificador_processo() {
+  return GetCurrentProcessId();
+}
+
+char **listar_diretorio(const char *caminho, int *quantidade) {
+  char padrao[MAX_PATH];
+  WIN32_FIND_DATAA dados;
+
+  snprintf(padrao, sizeof padrao, "%s\\*", caminho);
+  HANDLE busca = FindFirstFileA(padrao, &dados);
+  if (busca == INVALID_HANDLE_VALUE) {
+    return NULL;
+  }
+
+  // Começa com espaço para um caminho, para um diretório vazio não ser confundido com um erro
+  char **caminhos = malloc(sizeof(char *));
+  int capacidade  = 1;
+  *quantidade     = 0;
+
+  if (caminhos == NULL) {
+    erro(L"Falha ao alocar memória para a lista de arquivos.");
+  }
+
+  do {
+    if (dados.cFileName[0] != '.' && !(dados.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+      acrescentar_caminho(&caminhos, quantidade, &capacidade, caminho, dados.cFileName);
+    }
+  } while (FindNextFileA(busca, &dados));
+
+  FindClose(busca);
+  qsort(caminhos, *quantidade, sizeof(char *), comparar_caminhos);
+  return caminhos;
 }
 
 #else
+#include <dirent.h>
+#include <errno.h>
+#include <sys/select.h>
+#include <sys/stat.h>
 #include <termios.h>
 #include <unistd.h>
 
@@ -78,9 +179,75 @@ int ler_tecla_pressionada() {
       return ACIMA;
     if (buffer[2] == 66)
       return ABAIXO;
+    if (buffer[2] == 67)
+      return DIREITA;
+    if (buffer[2] == 68)
+      return ESQUERDA;
   }
   return buffer[0];
 }
+
+int esperar_tecla(double segundos) {
+  fd_set entrada;
+  FD_ZERO(&entrada);
+  FD_SET(STDIN_FILENO, &entrada);
+
+  struct timeval espera = { (time_t)segundos, (suseconds_t)((segundos - (time_t)segundos) * 1e6) };
+  return select(STDIN_FILENO + 1, &entrada, NULL, NULL, segundos < 0 ? NULL : &espera) > 0;
+}
+
+double tempo_monotonico() {
+  struct timespec agora;
+  clock_gettime(CLOCK_MONOTONIC, &agora);
+  return agora.tv_sec + agora.tv_nsec / 1e9;
+}
+
+int numero_de_processadores() {
+  long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+  return processadores > 0 ? processadores : 1;
+}
+
+int criar_diretorio(const char *caminho) {
+  return mkdir(caminho, 0755) == 0 || errno == EEXIST;
+}
+
+int identificador_processo() {
+  return getpid();
+}
+
+char **listar_diretorio(const char *caminho, int *quantidade) {
+  DIR *diretorio = opendir(caminho);
+  if (diretorio == NULL) {
+    return NULL;
+  }
+
+  // Começa com espaço para um caminho, para um diretório vazio não ser confundido com um erro
+  char **caminhos = malloc(sizeof(char *));
+  int capacidade  = 1;
+  *quantidade     = 0;
+
+  if (caminhos == NULL) {
+    erro(L"Falha ao alocar memória para a lista de arquivos.");
+  }
+
+  struct dirent *entrada;
+  while ((entrada = readdir(diretorio)) != NULL) {
+    if (entrada->d_name[0] == '.') {
+      continue;
+    }
+
+    acrescentar_caminho(&caminhos, quantidade, &capacidade, caminho, entrada->d_name);
+
+    struct stat informacoes;
+    if (stat(caminhos[*quantidade - 1], &informacoes) != 0 || !S_ISREG(informacoes.st_mode)) {
+      free(caminhos[--*quantidade]);
+    }
+  }
+
+  closedir(diretorio);
+  qsort(caminhos, *quantidade, sizeof(char *), comparar_caminhos);
+  return caminhos;
+}
 #endif
 
 void configurar_idioma() {
@@ -93,4 +260,11 @@ void configurar_idioma() {
   SetConsoleCP(65001);
   SetConsoleOutputCP(65001);
 #endif
+}
+
+void usar_saida_em_bytes() {
+#ifdef _WIN32
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+  fwide(stdout, -1);
 }
\ No newline at end of file
@@ -0,0 +1,519 @@
+/*
+ * patrulhas.c - Inimigos que patrulham e a busca no espaço-tempo
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/patrulhas.h"
+#include "include/cronologia.h"
+#include "include/heap.h"
+#include "include/os.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Acrescenta uma célula ao fim de uma lista que dobra quando enche.
+ */
+static void acrescentar_celula(int **lista, int *quantidade, int *capacidade, int celula) {
+  if (*quantidade == *capacidade) {
+    *capacidade = max(16, *capacidade * 2);
+    *lista      = realloc(*lista, *capacidade * sizeof(int));
+    if (*lista == NULL) {
+      erro(L"Falha ao alocar memória para as patrulhas.");
+    }
+  }
+
+  (*lista)[(*quantidade)++] = celula;
+}
+
+static int comparar_celulas(const void *a, const void *b) {
+  return *(const int *)a - *(const int *)b;
+}
+
+static long long mdc(long long a, long long b) {
+  while (b) {
+    const long long resto = a % b;
+    a                     = b;
+    b                     = resto;
+  }
+  return a;
+}
+
+/**
+ * A rota padrão: o inimigo anda em linha reta, na direção com mais espaço,
+ * até ALCANCE_PATRULHA células, sem pisar em paredes, saídas nem partidas.
+ *
+ * @param pontos Recebe as células da ida, começando na do inimigo.
+ * @return A quantidade de passos da ida.
+ */
+static int tracar_rota_padrao(const Labirinto *labirinto, int linha, int coluna, int *pontos) {
+  char **matriz = labirinto->matriz_inicial;
+  int melhor    = 0, direcao = 0;
+
+  for (int d = 0; d < 4; ++d) {
+    int passos = 0;
+    while (passos < ALCANCE_PATRULHA) {
+      int proxima[2] = { linha + deslocamento_linha[d] * (passos + 1), coluna + deslocamento_coluna[d] * (passos + 1) };
+      if (!checar_coordenada((int *)labirinto->tamanho, proxima)) {
+        break;
+      }
+
+      const char celula = matriz[proxima[0]][proxima[1]];
+      if (parede(celula) || celula == SAIDA || celula == JOGADOR) {
+        break;
+      }
+      passos++;
+    }
+
+    if (passos > melhor) {
+      melhor  = passos;
+      direcao = d;
+    }
+  }
+
+  for (int i = 0; i <= melhor; ++i) {
+    pontos[i] = (linha + deslocamento_linha[direcao] * i) * labirinto->tamanho[1] + coluna + deslocamento_coluna[direcao] * i;
+  }
+  return melhor;
+}
+
+/**
+ * Segue as letras de uma rota do arquivo a partir da célula do inimigo.
+ *
+ * @param pontos Recebe as células visitadas, começando na do inimigo.
+ * @return A quantidade de passos.
+ */
+static int tracar_rota_do_arquivo(const Labirinto *labirinto, int linha, int coluna, const char *letras, int *pontos) {
+  const char *nomes = "ABED<>";
+  int posicao[2]    = { linha, coluna };
+  int passos        = 0;
+
+  pontos[0] = linha * labirinto->tamanho[1] + coluna;
+  for (; letras[passos] != '\0'; ++passos) {
+    const char *letra = strchr(nomes, letras[passos]);
+    if (letra == NULL) {
+      erro(L"O arquivo de rotas tem uma direção desconhecida.");
+    }
+
+    if (!vizinha_na_direcao(labirinto, posicao[0], posicao[1], letra - nomes, posicao) ||
+        parede(labirinto->matriz_inicial[posicao[0]][posicao[1]])) {
+      erro(L"A rota de um inimigo atravessa uma parede ou sai do labirinto.");
+    }
+    pontos[passos + 1] = posicao[0] * labirinto->tamanho[1] + posicao[1];
+  }
+  return passos;
+}
+
+/**
+ * Lê o arquivo de rotas, guardando as letras de cada inimigo citado na
+ * posição dele em `inimigos`.
+ */
+static void ler_rotas(const char *nome, const int *inimigos, int quantidade, int colunas, char **letras) {
+  FILE *arquivo = fopen(nome, "r");
+  char linha[4096];
+
+  if (arquivo == NULL) {
+    erro(L"Não foi possível abrir o arquivo de rotas.");
+  }
+
+  while (fgets(linha, sizeof linha, arquivo)) {
+    linha[strcspn(linha, "\r\n")] = '\0';
+    if (linha[0] == '\0' || linha[0] == '#') {
+      continue;
+    }
+
+    int posicao[2], lidos = 0;
+    if (sscanf(linha, "%d %d %n", &posicao[0], &posicao[1], &lidos) < 2) {
+      erro(L"Linha inválida no arquivo de rotas.");
+    }
+
+    const int celula  = posicao[0] * colunas + posicao[1];
+    const int *achado = bsearch(&celula, inimigos, quantidade, sizeof(int), comparar_celulas);
+    if (achado == NULL) {
+      erro(L"O arquivo de rotas cita uma célula sem inimigo.");
+    }
+
+    char **destino = &letras[achado - inimigos];
+    free(*destino);
+    *destino = malloc(strlen(linha + lidos) + 1);
+    if (*destino == NULL) {
+      erro(L"Falha ao alocar memória para as patrulhas.");
+    }
+    strcpy(*destino, linha + lidos);
+  }
+
+  fclose(arquivo);
+}
+
+void criar_patrulhas(Patrulhas *patrulhas, const Labirinto *labirinto, const char *rotas) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+  const int celulas = linhas * colunas;
+
+  int *inimigos = NULL, quantidade = 0, capacidade = 0;
+  for (int i = 0; i < linhas; ++i) {
+    for (int j = 0; j < colunas; ++j) {
+      if (inimigo(labirinto->matriz_inicial[i][j])) {
+        acrescentar_celula(&inimigos, &quantidade, &capacidade, i * colunas + j);
+      }
+    }
+  }
+
+  char **letras = calloc(max(1, quantidade), sizeof(char *));
+  if (letras == NULL) {
+    erro(L"Falha ao alocar memória para as patrulhas.");
+  }
+  if (rotas != NULL) {
+    ler_rotas(rotas, inimigos, quantidade, colunas, letras);
+  }
+
+  memset(patrulhas, 0, sizeof(Patrulhas));
+  patrulhas->quantidade   = quantidade;
+  patrulhas->inicio_rotas = malloc((quantidade + 1) * sizeof(int));
+  if (patrulhas->inicio_rotas == NULL) {
+    erro(L"Falha ao alocar memória para as patrulhas.");
+  }
+
+  int tamanho_rotas = 0, capacidade_rotas = 0;
+  long long periodo = 1;
+
+  for (int i = 0; i < quantidade; ++i) {
+    const int linha = inimigos[i] / colunas, coluna = inimigos[i] % colunas;
+    int *pontos     = malloc(((letras[i] ? strlen(letras[i]) : ALCANCE_PATRULHA) + 1) * sizeof(int));
+    if (pontos == NULL) {
+      erro(L"Falha ao alocar memória para as patrulhas.");
+    }
+
+    const int passos = letras[i] ? tracar_rota_do_arquivo(labirinto, linha, coluna, letras[i], pontos)
+                                 : tracar_rota_padrao(labirinto, linha, coluna, pontos);
+
+    // Um circuito fechado se repete como está; uma rota aberta vai e volta
+    patrulhas->inicio_rotas[i] = tamanho_rotas;
+    if (passos > 0 && pontos[passos] == pontos[0]) {
+      for (int j = 0; j < passos; ++j) {
+        acrescentar_celula(&patrulhas->rotas, &tamanho_rotas, &capacidade_rotas, pontos[j]);
+      }
+    } else {
+      for (int j = 0; j <= passos; ++j) {
+        acrescentar_celula(&patrulhas->rotas, &tamanho_rotas, &capacidade_rotas, pontos[j]);
+      }
+      for (int j = passos - 1; j > 0; --j) {
+        acrescentar_celula(&patrulhas->rotas, &tamanho_rotas, &capacidade_rotas, pontos[j]);
+      }
+    }
+
+    const int tamanho = tamanho_rotas - patrulhas->inicio_rotas[i];
+    periodo           = periodo ? periodo / mdc(periodo, tamanho) * tamanho : 0;
+    periodo           = periodo > PERIODO_MAXIMO ? 0 : periodo;
+
+    free(pontos);
+    free(letras[i]);
+  }
+  patrulhas->inicio_rotas[quantidade] = tamanho_rotas;
+  patrulhas->periodo                  = periodo;
+
+  // A ocupação é montada como uma lista de adjacência compacta: primeiro
+  // conta quantos momentos caem em cada célula, depois preenche
+  patrulhas->inicio_ocupacoes = calloc(celulas + 1, sizeof(int));
+  patrulhas->ocupacoes        = malloc(max(1, tamanho_rotas) * sizeof(int[2]));
+  if (patrulhas->inicio_ocupacoes == NULL || patrulhas->ocupacoes == NULL) {
+    erro(L"Falha ao alocar memória para as patrulhas.");
+  }
+
+  for (int i = 0; i < tamanho_rotas; ++i) {
+    patrulhas->inicio_ocupacoes[patrulhas->rotas[i] + 1]++;
+  }
+  for (int i = 0; i < celulas; ++i) {
+    patrulhas->inicio_ocupacoes[i + 1] += patrulhas->inicio_ocupacoes[i];
+  }
+
+  int *preenchidas = malloc(celulas * sizeof(int));
+  if (preenchidas == NULL) {
+    erro(L"Falha ao alocar memória para as patrulhas.");
+  }
+  memcpy(preenchidas, patrulhas->inicio_ocupacoes, celulas * sizeof(int));
+
+  for (int i = 0; i < quantidade; ++i) {
+    for (int j = patrulhas->inicio_rotas[i]; j < patrulhas->inicio_rotas[i + 1]; ++j) {
+      const int posicao                = preenchidas[patrulhas->rotas[j]]++;
+      patrulhas->ocupacoes[posicao][0] = i;
+      patrulhas->ocupacoes[posicao][1] = j - patrulhas->inicio_rotas[i];
+    }
+  }
+
+  free(preenchidas);
+  free(letras);
+  free(inimigos);
+}
+
+/**
+ * Checa se algum inimigo está na célula no passo dado.
+ */
+static int ocupada(const Patrulhas *patrulhas, int celula, int tempo) {
+  for (int i = patrulhas->inicio_ocupacoes[celula]; i < patrulhas->inicio_ocupacoes[celula + 1]; ++i) {
+    const int inimigo = patrulhas->ocupacoes[i][0];
+    const int tamanho = patrulhas->inicio_rotas[inimigo + 1] - patrulhas->inicio_rotas[inimigo];
+    if (tempo % tamanho == patrulhas->ocupacoes[i][1]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Checa se o jogador, indo de `de` para `para` entre os passos `tempo` e
+ * `tempo + 1`, trocaria de lugar com um inimigo que faz o caminho oposto.
+ */
+static int cruzaria(const Patrulhas *patrulhas, int de, int para, int tempo) {
+  for (int i = patrulhas->inicio_ocupacoes[para]; i < patrulhas->inicio_ocupacoes[para + 1]; ++i) {
+    const int inimigo = patrulhas->ocupacoes[i][0];
+    const int inicio  = patrulhas->inicio_rotas[inimigo];
+    const int tamanho = patrulhas->inicio_rotas[inimigo + 1] - inicio;
+    const int fase    = patrulhas->ocupacoes[i][1];
+    if (tempo % tamanho == fase && patrulhas->rotas[inicio + (fase + 1) % tamanho] == de) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Um estado da busca no tempo. A chave junta a célula e o passo módulo o
+ * ciclo (celula * ciclo + tempo % ciclo); `tempo` é o passo real.
+ */
+typedef struct {
+  long long chave;
+  int tempo;
+  int pai;
+  uint8_t direcao;
+} EstadoTempo;
+
+/**
+ * Os estados visitados e uma tabela de dispersão com endereçamento aberto
+ * que leva da chave ao índice do estado (mais um, 0 nas posições vazias).
+ */
+typedef struct {
+  EstadoTempo *estados;
+  int quantidade;
+  int capacidade;
+  int *tabela;
+  int mascara;
+} TabelaTempo;
+
+static int posicao_na_tabela(const TabelaTempo *tabela, long long chave) {
+  int posicao = (int)(((uint64_t)chave * 0x9E3779B97F4A7C15ull) >> 32) & tabela->mascara;
+  while (tabela->tabela[posicao] && tabela->estados[tabela->tabela[posicao] - 1].chave != chave) {
+    posicao = (posicao + 1) & tabela->mascara;
+  }
+  return posicao;
+}
+
+/**
+ * Acrescenta um estado, dobrando a tabela quando ela passa da metade.
+ *
+ * @return O índice do estado.
+ */
+static int acrescentar_estado(TabelaTempo *tabela, EstadoTempo estado) {
+  if (tabela->quantidade == tabela->capacidade) {
+    tabela->capacidade *= 2;
+    tabela->estados = realloc(tabela->estados, tabela->capacidade * sizeof(EstadoTempo));
+    if (tabela->estados == NULL) {
+      erro(L"Falha ao alocar memória para a busca no tempo.");
+    }
+  }
+
+  if (2 * (tabela->quantidade + 1) > tabela->mascara + 1) {
+    free(tabela->tabela);
+    tabela->mascara = tabela->mascara * 2 + 1;
+    tabela->tabela  = calloc(tabela->mascara + 1, sizeof(int));
+    if (tabela->tabela == NULL) {
+      erro(L"Falha ao alocar memória para a busca no tempo.");
+    }
+    for (int i = 0; i < tabela->quantidade; ++i) {
+      tabela->tabela[posicao_na_tabela(tabela, tabela->estados[i].chave)] = i + 1;
+    }
+  }
+
+  tabela->estados[tabela->quantidade]                     = estado;
+  tabela->tabela[posicao_na_tabela(tabela, estado.chave)] = tabela->quantidade + 1;
+  return tabela->quantidade++;
+}
+
+int planejar_no_tempo(const Patrulhas *patrulhas, const Labirinto *labirinto, const CampoDistancia *campo, int origem[2], Caminho *caminho,
+                      long long *expandidos) {
+  const int linhas     = labirinto->tamanho[0];
+  const int colunas    = labirinto->tamanho[1];
+  const int inicio     = origem[0] * colunas + origem[1];
+  const int *distancia = campo->distancias;
+  char **matriz        = labirinto->matriz_inicial;
+
+  *expandidos = 0;
+  if (distancia[inicio] == INT_MAX) {
+    return -1;
+  }
+
+  // Sem período, o tempo não dá a volta e a chave guarda o passo inteiro
+  const int horizonte = patrulhas->periodo ? INT_MAX : FOLGA_HORIZONTE * distancia[inicio] + PERIODO_MAXIMO;
+  const int ciclo     = patrulhas->periodo ? patrulhas->periodo : horizonte + 1;
+
+  TabelaTempo tabela = { .capacidade = 1024, .mascara = 2047 };
+  tabela.estados     = malloc(tabela.capacidade * sizeof(EstadoTempo));
+  tabela.tabela      = calloc(tabela.mascara + 1, sizeof(int));
+  if (tabela.estados == NULL || tabela.tabela == NULL) {
+    erro(L"Falha ao alocar memória para a busca no tempo.");
+  }
+
+  Heap abertos;
+  criar_heap(&abertos, linhas + colunas);
+
+  const Trecho trecho = comecar_trecho("planejar_no_tempo");
+  acrescentar_estado(&tabela, (EstadoTempo){ .chave = (long long)inicio * ciclo, .tempo = 0, .pai = -1, .direcao = ESPERAR });
+  inserir_heap(&abertos, (ItemHeap){ .custo = distancia[inicio], .peso = 0, .indice = 0 });
+
+  int chegada = -1;
+
+  while (abertos.tamanho > 0) {
+    ItemHeap topo           = remover_heap(&abertos);
+    const EstadoTempo atual = tabela.estados[topo.indice];
+    const int celula        = (int)(atual.chave / ciclo);
+
+    if (topo.peso > atual.tempo) {
+      continue;
+    }
+
+    (*expandidos)++;
+    if (matriz[celula / colunas][celula % colunas] == SAIDA) {
+      chegada = topo.indice;
+      break;
+    }
+    if (atual.tempo >= horizonte) {
+      continue;
+    }
+
+    // As direções e, por último, ficar parado
+    for (int d = 0; d <= ESPERAR; ++d) {
+      int vizinha[2] = { celula / colunas, celula % colunas };
+      if (d < ESPERAR && !vizinha_na_direcao(labirinto, celula / colunas, celula % colunas, d, vizinha)) {
+        continue;
+      }
+
+      if (parede(matriz[vizinha[0]][vizinha[1]])) {
+        continue;
+      }
+
+      const int indice = vizinha[0] * colunas + vizinha[1];
+      const int tempo  = atual.tempo + 1;
+
+      if (distancia[indice] == INT_MAX || ocupada(patrulhas, indice, tempo) || (d < ESPERAR && cruzaria(patrulhas, celula, indice, atual.tempo))) {
+        continue;
+      }
+
+      const long long chave = (long long)indice * ciclo + tempo % ciclo;
+      const int posicao     = posicao_na_tabela(&tabela, chave);
+      int estado            = tabela.tabela[posicao] - 1;
+
+      if (estado >= 0 && tabela.estados[estado].tempo <= tempo) {
+        continue;
+      }
+
+      const EstadoTempo novo = { .chave = chave, .tempo = tempo, .pai = topo.indice, .direcao = d };
+      if (estado >= 0) {
+        tabela.estados[estado] = novo;
+      } else {
+        estado = acrescentar_estado(&tabela, novo);
+      }
+      inserir_heap(&abertos, (ItemHeap){ .custo = tempo + distancia[indice], .peso = tempo, .indice = estado });
+    }
+  }
+
+  terminar_trecho(trecho);
+
+  const int passos = chegada >= 0 ? tabela.estados[chegada].tempo : -1;
+  if (passos >= 0 && caminho) {
+    caminho->direcoes = malloc(max(1, passos) * sizeof(int));
+    caminho->tamanho  = passos;
+    caminho->custo    = passos;
+    if (caminho->direcoes == NULL) {
+      erro(L"Falha ao alocar memória para o caminho.");
+    }
+
+    for (int i = chegada, j = passos - 1; j >= 0; i = tabela.estados[i].pai, --j) {
+      caminho->direcoes[j] = tabela.estados[i].direcao;
+    }
+  }
+
+  liberar_heap(&abertos);
+  free(tabela.estados);
+  free(tabela.tabela);
+  return passos;
+}
+
+void liberar_patrulhas(Patrulhas *patrulhas) {
+  free(patrulhas->inicio_rotas);
+  free(patrulhas->rotas);
+  free(patrulhas->inicio_ocupacoes);
+  free(patrulhas->ocupacoes);
+  memset(patrulhas, 0, sizeof(Patrulhas));
+}
+
+void executar_patrulhas(Labirinto *labirinto, const Opcoes *opcoes) {
+  static const char letras[] = { 'A', 'B', 'E', 'D', '<', '>', 'P' };
+
+  Patrulhas patrulhas;
+  criar_patrulhas(&patrulhas, labirinto, opcoes->rotas);
+
+  const CampoDistancia *campo = obter_campo(labirinto, 0);
+  const int *inicio           = labirinto->jogador.posicao_inicial;
+  const int sem_inimigos      = campo->distancias[inicio[0] * labirinto->tamanho[1] + inicio[1]];
+
+  Caminho caminho      = { 0 };
+  long long expandidos = 0;
+  const double comeco  = tempo_monotonico();
+  const int passos     = planejar_no_tempo(&patrulhas, labirinto, campo, labirinto->jogador.posicao_inicial, &caminho, &expandidos);
+  const double tempo   = tempo_monotonico() - comeco;
+
+  wprintf(L"Labirinto: %s (%dx%d)\n", labirinto->nome, labirinto->tamanho[0], labirinto->tamanho[1]);
+  if (patrulhas.periodo) {
+    wprintf(L"  %d inimigos patrulhando, as rotas se repetem a cada %d passos\n", patrulhas.quantidade, patrulhas.periodo);
+  } else {
+    wprintf(L"  %d inimigos patrulhando, com período maior que %d passos\n", patrulhas.quantidade, PERIODO_MAXIMO);
+  }
+
+  if (passos < 0) {
+    wprintf(L"  Sem caminho que escape das patrulhas (%lld estados expandidos em %.3f ms)\n", expandidos, tempo * 1e3);
+  } else {
+    int esperas = 0;
+    for (int i = 0; i < caminho.tamanho; ++i) {
+      esperas += caminho.direcoes[i] == ESPERAR;
+    }
+
+    wprintf(L"  Caminho: %d passos, %d esperas (%d sem os inimigos), %lld estados expandidos em %.3f ms\n  ", passos, esperas, sem_inimigos,
+            expandidos, tempo * 1e3);
+    for (int i = 0; i < caminho.tamanho; ++i) {
+      wprintf(L"%c", letras[caminho.direcoes[i]]);
+    }
+    wprintf(L"\n");
+  }
+
+  liberar_caminho(&caminho);
+  liberar_patrulhas(&patrulhas);
+}
@@ -0,0 +1,542 @@
+/*
+ * percurso.c - Percurso pelos alvos até a saída
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/percurso.h"
+#include "include/busca.h"
+#include "include/cronologia.h"
+#include "include/heap.h"
+#include "include/mem.h"
+#include "include/os.h"
+#include "include/util.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int comparar_celulas(const void *a, const void *b) {
+  return *(const int *)a - *(const int *)b;
+}
+
+/**
+ * Acrescenta uma célula ao fim de uma lista que dobra quando enche.
+ */
+static void acrescentar_alvo(int **lista, int *quantidade, int *capacidade, int celula) {
+  if (*quantidade == *capacidade) {
+    *capacidade = max(16, *capacidade * 2);
+    *lista      = realloc(*lista, *capacidade * sizeof(int));
+    if (*lista == NULL) {
+      erro(L"Falha ao alocar memória para o percurso.");
+    }
+  }
+
+  (*lista)[(*quantidade)++] = celula;
+}
+
+/**
+ * Lê as posições dos alvos de um arquivo para a lista.
+ */
+static void ler_alvos(const char *nome, const Labirinto *labirinto, int **lista, int *quantidade, int *capacidade) {
+  FILE *arquivo = fopen(nome, "r");
+  char linha[256];
+
+  if (arquivo == NULL) {
+    erro(L"Não foi possível abrir o arquivo de alvos.");
+  }
+
+  while (fgets(linha, sizeof linha, arquivo)) {
+    linha[strcspn(linha, "\r\n")] = '\0';
+    if (linha[0] == '\0' || linha[0] == '#') {
+      continue;
+    }
+
+    int posicao[2];
+    if (sscanf(linha, "%d %d", &posicao[0], &posicao[1]) != 2) {
+      erro(L"Linha inválida no arquivo de alvos.");
+    }
+    if (!checar_coordenada((int *)labirinto->tamanho, posicao) || parede(labirinto->matriz_inicial[posicao[0]][posicao[1]])) {
+      erro(L"Um alvo está fora do labirinto ou numa parede.");
+    }
+    acrescentar_alvo(lista, quantidade, capacidade, posicao[0] * labirinto->tamanho[1] + posicao[1]);
+  }
+
+  fclose(arquivo);
+}
+
+void criar_percurso(Percurso *percurso, const Labirinto *labirinto, const char *alvos) {
+  const int colunas = labirinto->tamanho[1];
+  const int partida = labirinto->jogador.posicao_inicial[0] * colunas + labirinto->jogador.posicao_inicial[1];
+
+  int *lista = NULL, quantidade = 0, capacidade = 0;
+  if (alvos != NULL) {
+    ler_alvos(alvos, labirinto, &lista, &quantidade, &capacidade);
+  } else {
+    for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+      for (int j = 0; j < colunas; ++j) {
+        if (inimigo(labirinto->matriz_inicial[i][j])) {
+          acrescentar_alvo(&lista, &quantidade, &capacidade, i * colunas + j);
+        }
+      }
+    }
+  }
+
+  // Um alvo repetido, ou na própria partida, não muda o percurso
+  int unicos = 0;
+  if (quantidade > 0) {
+    qsort(lista, quantidade, sizeof(int), comparar_celulas);
+  }
+  for (int i = 0; i < quantidade; ++i) {
+    if (lista[i] != partida && (unicos == 0 || lista[unicos - 1] != lista[i])) {
+      lista[unicos++] = lista[i];
+    }
+  }
+
+  if (unicos > ALVOS_MAXIMO) {
+    erro(L"Alvos demais para o percurso.");
+  }
+
+  percurso->pontos     = unicos + 2;
+  percurso->celulas    = malloc((unicos + 1) * sizeof(int));
+  percurso->distancias = malloc((size_t)percurso->pontos * percurso->pontos * sizeof(int));
+  percurso->saidas     = malloc((unicos + 1) * sizeof(int));
+  percurso->custos     = malloc(percurso->pontos * sizeof(int));
+  if (percurso->celulas == NULL || percurso->distancias == NULL || percurso->saidas == NULL || percurso->custos == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+
+  percurso->celulas[0] = partida;
+  for (int i = 0; i < unicos; ++i) {
+    percurso->celulas[i + 1] = lista[i];
+  }
+  free(lista);
+}
+
+/**
+ * As origens da matriz de distâncias, que as threads pegam em ordem por um
+ * contador atômico. `indices` diz qual ponto está em cada célula, ou -1.
+ */
+typedef struct {
+  const Labirinto *labirinto;
+  Percurso *percurso;
+  int penalidade;
+  int *indices;
+  atomic_int proximo;
+} MedicaoPercurso;
+
+static void *medir_origens(void *argumento) {
+  MedicaoPercurso *medicao   = argumento;
+  const Labirinto *labirinto = medicao->labirinto;
+  Percurso *percurso         = medicao->percurso;
+  const int linhas           = labirinto->tamanho[0];
+  const int colunas          = labirinto->tamanho[1];
+  const int pontos           = percurso->pontos;
+  char **matriz              = labirinto->matriz_inicial;
+
+  int *distancias = malloc((size_t)linhas * colunas * sizeof(int));
+  if (distancias == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+
+  for (int origem = atomic_fetch_add(&medicao->proximo, 1); origem < pontos - 1; origem = atomic_fetch_add(&medicao->proximo, 1)) {
+    TRECHO("medir_origem");
+    int *linha    = &percurso->distancias[origem * pontos];
+    int restantes = pontos;
+
+    for (int i = 0; i < linhas * colunas; ++i) {
+      distancias[i] = INT_MAX;
+    }
+    for (int i = 0; i < pontos; ++i) {
+      linha[i] = INT_MAX;
+    }
+    percurso->saidas[origem] = -1;
+
+    Heap abertos;
+    criar_heap(&abertos, linhas + colunas);
+    distancias[percurso->celulas[origem]] = 0;
+    inserir_heap(&abertos, (ItemHeap){ .custo = 0, .peso = 0, .indice = percurso->celulas[origem] });
+
+    // O Dijkstra para quando todos os pontos e uma saída já saíram da heap
+    while (abertos.tamanho > 0 && restantes > 0) {
+      ItemHeap topo = remover_heap(&abertos);
+
+      if (topo.custo > distancias[topo.indice]) {
+        continue;
+      }
+
+      const int linha_atual = topo.indice / colunas, coluna_atual = topo.indice % colunas;
+      if (medicao->indices[topo.indice] >= 0) {
+        linha[medicao->indices[topo.indice]] = topo.custo;
+        restantes--;
+      }
+      if (matriz[linha_atual][coluna_atual] == SAIDA && percurso->saidas[origem] < 0) {
+        linha[pontos - 1]        = topo.custo;
+        percurso->saidas[origem] = topo.indice;
+        restantes--;
+      }
+
+      for (int d = 0; d < direcoes_do_labirinto(labirinto); ++d) {
+        int vizinha[2];
+        if (!vizinha_na_direcao(labirinto, linha_atual, coluna_atual, d, vizinha)) {
+          continue;
+        }
+
+        const int passo  = custo_passo(matriz[vizinha[0]][vizinha[1]], medicao->penalidade);
+        const int indice = vizinha[0] * colunas + vizinha[1];
+        if (passo < 0 || topo.custo + passo >= distancias[indice]) {
+          continue;
+        }
+
+        distancias[indice] = topo.custo + passo;
+        inserir_heap(&abertos, (ItemHeap){ .custo = distancias[indice], .peso = 0, .indice = indice });
+      }
+    }
+
+    liberar_heap(&abertos);
+  }
+
+  free(distancias);
+  return NULL;
+}
+
+int medir_percurso(Percurso *percurso, const Labirinto *labirinto, int penalidade, int threads) {
+  const int colunas = labirinto->tamanho[1];
+  const int celulas = labirinto->tamanho[0] * colunas;
+  const int pontos  = percurso->pontos;
+
+  MedicaoPercurso medicao = { .labirinto = labirinto, .percurso = percurso, .penalidade = penalidade };
+  medicao.indices         = malloc((size_t)celulas * sizeof(int));
+  if (medicao.indices == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+  atomic_init(&medicao.proximo, 0);
+
+  memset(medicao.indices, 0xff, (size_t)celulas * sizeof(int));
+  for (int i = 0; i < pontos - 1; ++i) {
+    const int celula        = percurso->celulas[i];
+    medicao.indices[celula] = i;
+    percurso->custos[i]     = custo_passo(labirinto->matriz_inicial[celula / colunas][celula % colunas], penalidade);
+  }
+  percurso->custos[pontos - 1] = custo_passo(SAIDA, penalidade);
+
+  const int quantidade_threads = min(max(1, threads), pontos - 1);
+  pthread_t *ids               = malloc(quantidade_threads * sizeof(pthread_t));
+  if (ids == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+
+  // A thread atual também mede, então só as outras são criadas
+  for (int i = 1; i < quantidade_threads; ++i) {
+    if (pthread_create(&ids[i], NULL, medir_origens, &medicao) != 0) {
+      erro(L"Falha ao criar as threads do percurso.");
+    }
+  }
+  medir_origens(&medicao);
+  for (int i = 1; i < quantidade_threads; ++i) {
+    pthread_join(ids[i], NULL);
+  }
+
+  // O labirinto não tem direção, então quem a partida alcança alcança todos
+  int alcancaveis = 1;
+  for (int i = 0; i < pontos; ++i) {
+    alcancaveis &= percurso->distancias[i] != INT_MAX;
+  }
+
+  free(ids);
+  free(medicao.indices);
+  return alcancaveis;
+}
+
+long long ordenar_held_karp(const Percurso *percurso, int *ordem) {
+  const int pontos      = percurso->pontos;
+  const int alvos       = pontos - 2;
+  const int saida       = pontos - 1;
+  const int *distancias = percurso->distancias;
+
+  if (alvos == 0) {
+    ordem[0] = 0;
+    ordem[1] = saida;
+    return distancias[saida];
+  }
+
+  // custos[mascara * alvos + j]: o menor custo de sair da partida, visitar os
+  // alvos da máscara e parar no alvo j, que está nela
+  const int mascaras  = 1 << alvos;
+  long long *custos   = malloc((size_t)mascaras * alvos * sizeof(long long));
+  uint8_t *anteriores = malloc((size_t)mascaras * alvos);
+  if (custos == NULL || anteriores == NULL) {
+    erro(L"Falha ao alocar memória para o Held-Karp.");
+  }
+
+  for (int mascara = 1; mascara < mascaras; ++mascara) {
+    for (int j = 0; j < alvos; ++j) {
+      const int estado = mascara * alvos + j;
+      custos[estado]   = LLONG_MAX;
+      if (!(mascara & (1 << j))) {
+        continue;
+      }
+
+      const int sem_j = mascara & ~(1 << j);
+      if (sem_j == 0) {
+        custos[estado] = distancias[j + 1];
+        continue;
+      }
+
+      for (int i = 0; i < alvos; ++i) {
+        if (!(sem_j & (1 << i))) {
+          continue;
+        }
+
+        const long long custo = custos[sem_j * alvos + i] + distancias[(i + 1) * pontos + j + 1];
+        if (custo < custos[estado]) {
+          custos[estado]     = custo;
+          anteriores[estado] = i;
+        }
+      }
+    }
+  }
+
+  long long melhor = LLONG_MAX;
+  int ultimo       = 0;
+  for (int j = 0; j < alvos; ++j) {
+    const long long custo = custos[(mascaras - 1) * alvos + j] + distancias[(j + 1) * pontos + saida];
+    if (custo < melhor) {
+      melhor = custo;
+      ultimo = j;
+    }
+  }
+
+  ordem[0]     = 0;
+  ordem[saida] = saida;
+  for (int mascara = mascaras - 1, posicao = alvos; posicao > 0; --posicao) {
+    const int antes = anteriores[mascara * alvos + ultimo];
+    ordem[posicao]  = ultimo + 1;
+    mascara         = mascara & ~(1 << ultimo);
+    ultimo          = antes;
+  }
+
+  free(custos);
+  free(anteriores);
+  return melhor;
+}
+
+/**
+ * O custo de uma aresta sem o custo de entrar no ponto de chegada, que é o
+ * mesmo nos dois sentidos: o menor caminho de ida, ao contrário, é o menor de
+ * volta. Como todo ponto é visitado uma vez, esse custo fica de fora das
+ * comparações entre ordens. `b` pode ser a saída; `a` não.
+ */
+static long long aresta(const Percurso *percurso, int a, int b) {
+  return percurso->distancias[a * percurso->pontos + b] - percurso->custos[b];
+}
+
+/**
+ * Move o trecho de `tamanho` pontos que começa em `inicio` para logo depois
+ * da posição `destino`, que fica fora do trecho.
+ */
+static void mover_trecho(int *ordem, int inicio, int tamanho, int destino) {
+  int trecho[3];
+  memcpy(trecho, ordem + inicio, tamanho * sizeof(int));
+
+  if (destino < inicio) {
+    memmove(ordem + destino + 1 + tamanho, ordem + destino + 1, (inicio - destino - 1) * sizeof(int));
+    memcpy(ordem + destino + 1, trecho, tamanho * sizeof(int));
+  } else {
+    memmove(ordem + inicio, ordem + inicio + tamanho, (destino - inicio - tamanho + 1) * sizeof(int));
+    memcpy(ordem + destino - tamanho + 1, trecho, tamanho * sizeof(int));
+  }
+}
+
+long long ordenar_2_opt(const Percurso *percurso, int *ordem) {
+  const int pontos = percurso->pontos;
+  const int alvos  = pontos - 2;
+  const int saida  = pontos - 1;
+
+  uint8_t *visitados = calloc(pontos, sizeof(uint8_t));
+  if (visitados == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+
+  // O vizinho mais próximo dá a ordem inicial
+  ordem[0]     = 0;
+  ordem[saida] = saida;
+  for (int posicao = 1; posicao <= alvos; ++posicao) {
+    int melhor = -1;
+    for (int j = 1; j <= alvos; ++j) {
+      if (!visitados[j] && (melhor < 0 || aresta(percurso, ordem[posicao - 1], j) < aresta(percurso, ordem[posicao - 1], melhor))) {
+        melhor = j;
+      }
+    }
+    visitados[melhor] = 1;
+    ordem[posicao]    = melhor;
+  }
+
+  for (int melhorou = 1; melhorou;) {
+    melhorou = 0;
+
+    // 2-opt: inverter ordem[i..j] troca só as duas arestas das pontas
+    for (int i = 1; i < alvos; ++i) {
+      for (int j = i + 1; j <= alvos; ++j) {
+        const long long diferenca = aresta(percurso, ordem[i - 1], ordem[j]) + aresta(percurso, ordem[i], ordem[j + 1]) -
+                                    aresta(percurso, ordem[i - 1], ordem[i]) - aresta(percurso, ordem[j], ordem[j + 1]);
+        if (diferenca < 0) {
+          for (int a = i, b = j; a < b; ++a, --b) {
+            const int troca = ordem[a];
+            ordem[a]        = ordem[b];
+            ordem[b]        = troca;
+          }
+          melhorou = 1;
+        }
+      }
+    }
+
+    // Or-opt: tirar um trecho de até três alvos e encaixá-lo entre outros dois
+    for (int tamanho = 1; tamanho <= 3; ++tamanho) {
+      for (int i = 1; i + tamanho - 1 <= alvos; ++i) {
+        const int primeiro    = ordem[i], ultimo = ordem[i + tamanho - 1];
+        const long long ganho = aresta(percurso, ordem[i - 1], primeiro) + aresta(percurso, ultimo, ordem[i + tamanho]) -
+                                aresta(percurso, ordem[i - 1], ordem[i + tamanho]);
+
+        for (int p = 0; p < saida; ++p) {
+          if (p >= i - 1 && p < i + tamanho) {
+            continue;
+          }
+
+          const long long custo = aresta(percurso, ordem[p], primeiro) + aresta(percurso, ultimo, ordem[p + 1]) -
+                                  aresta(percurso, ordem[p], ordem[p + 1]);
+          if (custo < ganho) {
+            mover_trecho(ordem, i, tamanho, p);
+            melhorou = 1;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  long long custo = 0;
+  for (int i = 0; i < saida; ++i) {
+    custo += percurso->distancias[ordem[i] * pontos + ordem[i + 1]];
+  }
+
+  free(visitados);
+  return custo;
+}
+
+void montar_percurso(const Percurso *percurso, const Labirinto *labirinto, int penalidade, const int *ordem, Caminho *caminho) {
+  const int colunas = labirinto->tamanho[1];
+  const int trechos = percurso->pontos - 1;
+
+  Caminho *partes = calloc(trechos, sizeof(Caminho));
+  if (partes == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+
+  int passos = 0, custo = 0;
+  for (int i = 0; i < trechos; ++i) {
+    const int de   = percurso->celulas[ordem[i]];
+    const int para = ordem[i + 1] == trechos ? percurso->saidas[ordem[i]] : percurso->celulas[ordem[i + 1]];
+    int origem[2]  = { de / colunas, de % colunas };
+    int destino[2] = { para / colunas, para % colunas };
+
+    custo += buscar_a_star(labirinto, origem, destino, penalidade, &partes[i]);
+    passos += partes[i].tamanho;
+  }
+
+  caminho->direcoes = malloc(max(1, passos) * sizeof(int));
+  caminho->tamanho  = 0;
+  caminho->custo    = custo;
+  if (caminho->direcoes == NULL) {
+    erro(L"Falha ao alocar memória para o caminho.");
+  }
+
+  for (int i = 0; i < trechos; ++i) {
+    memcpy(caminho->direcoes + caminho->tamanho, partes[i].direcoes, partes[i].tamanho * sizeof(int));
+    caminho->tamanho += partes[i].tamanho;
+    liberar_caminho(&partes[i]);
+  }
+  free(partes);
+}
+
+void liberar_percurso(Percurso *percurso) {
+  free(percurso->celulas);
+  free(percurso->distancias);
+  free(percurso->saidas);
+  free(percurso->custos);
+  memset(percurso, 0, sizeof(Percurso));
+}
+
+void executar_percurso(Labirinto *labirinto, const Opcoes *opcoes) {
+  static const char letras[] = { 'A', 'B', 'E', 'D', '<', '>' };
+  const int colunas          = labirinto->tamanho[1];
+
+  Percurso percurso;
+  criar_percurso(&percurso, labirinto, opcoes->alvos);
+
+  const int alvos = percurso.pontos - 2;
+  double inicio   = tempo_monotonico();
+
+  const Trecho medicao      = comecar_trecho("medir_percurso");
+  const int alcancaveis     = medir_percurso(&percurso, labirinto, opcoes->penalidade, opcoes->threads);
+  const double tempo_matriz = tempo_monotonico() - inicio;
+  terminar_trecho(medicao);
+
+  wprintf(L"Labirinto: %s (%dx%d)\n", labirinto->nome, labirinto->tamanho[0], colunas);
+  wprintf(L"  %d alvos, distâncias entre eles em %.3f ms com %d threads\n", alvos, tempo_matriz * 1e3, opcoes->threads);
+
+  if (!alcancaveis) {
+    wprintf(L"  Algum alvo ou a saída é inalcançável a partir da partida\n");
+    liberar_percurso(&percurso);
+    return;
+  }
+
+  int *ordem = malloc(percurso.pontos * sizeof(int));
+  if (ordem == NULL) {
+    erro(L"Falha ao alocar memória para o percurso.");
+  }
+
+  const Trecho ordenacao   = comecar_trecho("ordenar_percurso");
+  inicio                   = tempo_monotonico();
+  const long long custo    = alvos <= HELD_KARP_MAXIMO ? ordenar_held_karp(&percurso, ordem) : ordenar_2_opt(&percurso, ordem);
+  const double tempo_ordem = tempo_monotonico() - inicio;
+  terminar_trecho(ordenacao);
+
+  Caminho caminho       = { 0 };
+  const Trecho montagem = comecar_trecho("montar_percurso");
+  montar_percurso(&percurso, labirinto, opcoes->penalidade, ordem, &caminho);
+  terminar_trecho(montagem);
+
+  wprintf(L"  Ordem %ls em %.3f ms: custo %lld, %d passos\n  ", alvos <= HELD_KARP_MAXIMO ? L"exata (Held-Karp)" : L"por 2-opt e Or-opt",
+          tempo_ordem * 1e3, custo, caminho.tamanho);
+  for (int i = 1; i <= alvos; ++i) {
+    wprintf(L"(%d, %d) ", percurso.celulas[ordem[i]] / colunas, percurso.celulas[ordem[i]] % colunas);
+  }
+  wprintf(L"-> (%d, %d)\n  ", percurso.saidas[ordem[alvos]] / colunas, percurso.saidas[ordem[alvos]] % colunas);
+  for (int i = 0; i < caminho.tamanho; ++i) {
+    wprintf(L"%c", letras[caminho.direcoes[i]]);
+  }
+  wprintf(L"\n");
+
+  liberar_caminho(&caminho);
+  liberar_percurso(&percurso);
+  free(ordem);
+}
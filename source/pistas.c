@@ -0,0 +1,250 @@
+/*
+ * pistas.c - Simulações de tentativa e erro em pistas paralelas
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/pistas.h"
+#include "include/aleatorio.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Com ifunc (GCC no Linux), o laço das pistas também é compilado para AVX2 e
+// AVX-512, e a versão usada é escolhida quando o programa é carregado
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define VERSOES_SIMD __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define VERSOES_SIMD
+#endif
+
+#define EVENTO_CHEGADA 1
+#define EVENTO_MORTE 2
+
+// Comparações de valores menores que 2^31 pelo bit de sinal, dando 0 ou 1, que
+// servem de máscara (com o sinal trocado) para `escolher`
+#define menor(a, b) (((a) - (b)) >> 31)
+#define igual(a, b) ((((a) ^ (b)) - 1) >> 31)
+
+// `mascara` é tudo 0 ou tudo 1 em cada pista
+#define escolher(mascara, a, b) ((b) ^ ((mascara) & ((a) ^ (b))))
+
+void criar_pistas(Pistas *pistas, const MapaSimulacao *mapa) {
+  memset(pistas, 0, sizeof(Pistas));
+  pistas->mapa        = mapa;
+  pistas->vizinhancas = calloc(mapa->total, sizeof(uint8_t));
+  pistas->marcas      = calloc((size_t)PISTAS * mapa->total, sizeof(uint16_t));
+
+  if (pistas->vizinhancas == NULL || pistas->marcas == NULL) {
+    erro(L"Falha ao alocar memória para as pistas.");
+  }
+
+  // A moldura fica de fora: só células de dentro são visitadas
+  for (int i = mapa->largura; i < mapa->total - mapa->largura; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      const char tipo = mapa->tipos[i + mapa->deslocamentos[j]];
+      pistas->vizinhancas[i] |= (tipo != BLOQUEADA) << j | (tipo == COM_INIMIGO) << (j + 4);
+    }
+  }
+
+  // Pistas paradas continuam dando passos (descartados), então ficam no início
+  pistas->posicao = pistas->posicao + (uint32_t)mapa->inicio;
+}
+
+void liberar_pistas(Pistas *pistas) {
+  free(pistas->vizinhancas);
+  free(pistas->marcas);
+  pistas->vizinhancas = NULL;
+  pistas->marcas      = NULL;
+}
+
+/**
+ * Começa uma vida nova na pista. As marcas são de 16 bits; quando acabam,
+ * as da pista são zeradas e a contagem recomeça.
+ */
+static void nova_vida(Pistas *pistas, int pista) {
+  uint16_t *marcas = pistas->marcas + pista;
+
+  pistas->vida[pista] = (uint16_t)(pistas->vida[pista] + 1);
+  if (pistas->vida[pista] == 0) {
+    for (int i = 0; i < pistas->mapa->total; ++i) {
+      marcas[(size_t)i * PISTAS] = 0;
+    }
+    pistas->vida[pista] = 1;
+  }
+
+  pistas->posicao[pista]             = pistas->mapa->inicio;
+  pistas->inimigos_derrotados[pista] = 0;
+  pistas->em_combate[pista]          = 0;
+
+  marcas[(size_t)pistas->mapa->inicio * PISTAS] = pistas->vida[pista];
+}
+
+static void carregar_simulacao(Pistas *pistas, int pista, uint64_t semente, int simulacao) {
+  Gerador gerador;
+  semear_gerador(&gerador, semente, simulacao);
+
+  for (int i = 0; i < 4; ++i) {
+    pistas->estado[i][pista] = gerador.estado[i];
+  }
+
+  pistas->simulacao[pista]         = simulacao;
+  pistas->passos[pista]            = 0;
+  pistas->tentativas[pista]        = 0;
+  pistas->mortes_em_combate[pista] = 0;
+  pistas->ativa[pista]             = 1;
+  nova_vida(pistas, pista);
+}
+
+/**
+ * Avança todas as pistas um passo. Só a leitura das vizinhanças e a escrita
+ * das marcas são feitas pista a pista, porque cada pista está num ponto do
+ * mapa; o resto é aritmética sobre vetores, sem desvios.
+ *
+ * Cada passo usa no máximo um número do gerador por pista: o combate é um
+ * passo à parte, logo depois do passo que entrou no inimigo. Assim a
+ * sequência de sorteios é a mesma de `simular`, inclusive quando o sorteio de
+ * Lemire rejeita o número: a pista só repete o sorteio no passo seguinte.
+ */
+static inline __attribute__((always_inline)) void avancar_pistas(Pistas *pistas, Vetor *eventos) {
+  const MapaSimulacao *mapa = pistas->mapa;
+  const uint16_t *marcas    = pistas->marcas;
+  Vetor vizinhos;
+
+  for (int l = 0; l < PISTAS; ++l) {
+    const uint32_t p    = pistas->posicao[l];
+    const uint16_t vida = pistas->vida[l];
+    int visitados       = 0;
+
+    for (int i = 0; i < 4; ++i) {
+      visitados |= (marcas[(p + mapa->deslocamentos[i]) * PISTAS + l] == vida) << i;
+    }
+
+    vizinhos[l] = pistas->vizinhancas[p] & ~visitados;
+  }
+
+  const Vetor p       = pistas->posicao;
+  const Vetor lutando = pistas->em_combate;
+  const Vetor antes_2 = (vizinhos & 1) + (vizinhos >> 1 & 1);
+  const Vetor antes_3 = antes_2 + (vizinhos >> 2 & 1);
+  const Vetor opcoes  = antes_3 + (vizinhos >> 3 & 1);
+  const Vetor preso   = (lutando ^ 1) & igual(opcoes, 0);
+  const Vetor sorteou = pistas->ativa & (preso ^ 1);
+
+  // O sorteio de `sortear`: o limite é 100 no combate e a quantidade de
+  // opções fora dele. Só 3 e 100 têm faixa rejeitada: 2^32 % 3 = 1 e 2^32 % 100 = 96.
+  const Vetor64 limite = __builtin_convertvector(escolher(-lutando, 100, opcoes), Vetor64);
+  const Vetor64 limiar = __builtin_convertvector(escolher(-lutando, 96, igual(opcoes, 3)), Vetor64);
+
+  const Vetor64 s0 = pistas->estado[0], s1 = pistas->estado[1], s2 = pistas->estado[2], s3 = pistas->estado[3];
+  const Vetor64 aleatorio = rotacionar(s1 * 5, 7) * 9;
+  const Vetor64 produto   = (aleatorio >> 32) * limite;
+  const Vetor k           = __builtin_convertvector(produto >> 32, Vetor);
+  const Vetor rejeitado   = __builtin_convertvector(((produto & UINT32_MAX) - limiar) >> 63, Vetor);
+
+  const Vetor64 t2   = s2 ^ s0, t3 = s3 ^ s1;
+  const Vetor64 usou = -__builtin_convertvector(sorteou, Vetor64);
+  pistas->estado[0]  = escolher(usou, s0 ^ t3, s0);
+  pistas->estado[1]  = escolher(usou, s1 ^ t2, s1);
+  pistas->estado[2]  = escolher(usou, t2 ^ (s1 << 17), s2);
+  pistas->estado[3]  = escolher(usou, rotacionar(t3, 45), s3);
+
+  // O k-ésimo vizinho livre, na ordem de Direcoes, é o que tem k livres antes dele
+  const Vetor direcao = menor(vizinhos & 1, k + 1) + menor(antes_2, k + 1) + menor(antes_3, k + 1);
+  Vetor nova = p, inimigo = p ^ p;
+  for (int i = 0; i < 4; ++i) {
+    const Vetor escolhida = -igual(direcao, i);
+    nova += escolhida & (uint32_t)mapa->deslocamentos[i];
+    inimigo |= escolhida & (vizinhos >> (i + 4));
+  }
+
+  const Vetor aceito  = sorteou & (rejeitado ^ 1);
+  const Vetor anda    = aceito & (lutando ^ 1);
+  const Vetor combate = aceito & lutando;
+  const Vetor perdeu  = combate & menor(50 + pistas->inimigos_derrotados * 10, k);
+  const Vetor morreu  = perdeu | (pistas->ativa & preso);
+
+  pistas->passos += __builtin_convertvector(anda, Vetor64);
+  pistas->tentativas += morreu;
+  pistas->mortes_em_combate += perdeu;
+  pistas->inimigos_derrotados = (pistas->inimigos_derrotados + combate) & (morreu - 1);
+  pistas->em_combate          = (lutando & (aceito ^ 1)) | (anda & inimigo & 1);
+
+  // Na morte a pista volta para o início já com a marca da vida seguinte
+  pistas->vida    = (pistas->vida + morreu) & UINT16_MAX;
+  pistas->posicao = escolher(-morreu, (uint32_t)mapa->inicio, escolher(-anda, nova, p));
+
+  const Vetor chegou = anda & (inimigo ^ 1) & igual(nova, (uint32_t)mapa->saida);
+  const Vetor parou  = morreu & (igual(pistas->vida, 0) | (menor(pistas->tentativas, LIMITE_TENTATIVAS) ^ 1));
+  *eventos           = chegou * EVENTO_CHEGADA | parou * EVENTO_MORTE;
+
+  // A posição atual sempre tem a marca da vida atual, então reescrevê-la
+  // quando a pista não anda não muda nada
+  for (int l = 0; l < PISTAS; ++l) {
+    pistas->marcas[(size_t)pistas->posicao[l] * PISTAS + l] = pistas->vida[l];
+  }
+}
+
+VERSOES_SIMD void simular_em_pistas(Pistas *pistas, uint64_t semente, int inicio, int fim, Simulacao *simulacoes) {
+  int proxima = inicio, ativas = 0;
+
+  for (int l = 0; l < PISTAS; ++l) {
+    pistas->ativa[l] = 0;
+    if (proxima < fim) {
+      carregar_simulacao(pistas, l, semente, proxima++);
+      ativas++;
+    }
+  }
+
+  Vetor eventos;
+
+  while (ativas > 0) {
+    avancar_pistas(pistas, &eventos);
+
+    for (int l = 0; l < PISTAS; ++l) {
+      if (!eventos[l]) {
+        continue;
+      }
+
+      const int evento = eventos[l];
+      if ((evento & EVENTO_MORTE) && pistas->vida[l] == 0) {
+        // A vida nova estourou as marcas de 16 bits: zera e recomeça
+        pistas->vida[l] = UINT16_MAX;
+        nova_vida(pistas, l);
+      }
+
+      const int terminou = (evento & EVENTO_CHEGADA) || pistas->tentativas[l] >= LIMITE_TENTATIVAS;
+      if (!terminou) {
+        continue;
+      }
+
+      simulacoes[pistas->simulacao[l]] = (Simulacao){ .passos            = pistas->passos[l],
+                                                      .tentativas        = pistas->tentativas[l],
+                                                      .mortes_em_combate = pistas->mortes_em_combate[l],
+                                                      .chegou            = (evento & EVENTO_CHEGADA) != 0 };
+
+      if (proxima < fim) {
+        carregar_simulacao(pistas, l, semente, proxima++);
+      } else {
+        pistas->ativa[l] = 0;
+        ativas--;
+      }
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ * poda.c - Preenchimento de becos sem saída
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/poda.h"
+#include "include/estatisticas.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+
+int preencher_becos(const Labirinto *labirinto, int com_inimigos, uint8_t *mascara) {
+  const int linhas  = labirinto->tamanho[0];
+  const int colunas = labirinto->tamanho[1];
+  const int jogador = labirinto->jogador.posicao_inicial[0] * colunas + labirinto->jogador.posicao_inicial[1];
+
+  uint8_t *vizinhos = calloc(linhas * colunas, sizeof(uint8_t));
+  int *pendentes    = malloc(linhas * colunas * sizeof(int));
+  somar(alocacoes, 2);
+
+  if (vizinhos == NULL || pendentes == NULL) {
+    erro(L"Falha ao alocar memória para o preenchimento de becos.");
+  }
+
+  for (int i = 0; i < linhas; ++i) {
+    for (int j = 0; j < colunas; ++j) {
+      mascara[i * colunas + j] = passavel(labirinto->matriz_inicial[i][j], com_inimigos);
+    }
+  }
+
+  int quantidade = 0;
+  for (int celula = 0; celula < linhas * colunas; ++celula) {
+    if (!mascara[celula]) {
+      continue;
+    }
+
+    const int linha = celula / colunas, coluna = celula % colunas;
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      int vizinha[2];
+      vizinhos[celula] += vizinha_na_direcao(labirinto, linha, coluna, i, vizinha) && mascara[vizinha[0] * colunas + vizinha[1]];
+    }
+
+    if (vizinhos[celula] <= 1 && celula != jogador && labirinto->matriz_inicial[linha][coluna] != SAIDA) {
+      pendentes[quantidade++] = celula;
+    }
+  }
+
+  // Cada célula entra na lista no máximo uma vez: só quando o seu número de
+  // vizinhos cai para 1, ou já no começo se ela nasceu um beco
+  int preenchidas = 0;
+  while (quantidade > 0) {
+    const int celula = pendentes[--quantidade];
+    const int linha  = celula / colunas, coluna = celula % colunas;
+
+    mascara[celula] = 0;
+    preenchidas++;
+
+    for (int i = 0; i < direcoes_do_labirinto(labirinto); ++i) {
+      int vizinha[2];
+
+      if (!vizinha_na_direcao(labirinto, linha, coluna, i, vizinha) || !mascara[vizinha[0] * colunas + vizinha[1]]) {
+        continue;
+      }
+
+      const int adjacente = vizinha[0] * colunas + vizinha[1];
+
+      if (--vizinhos[adjacente] == 1 && adjacente != jogador && labirinto->matriz_inicial[vizinha[0]][vizinha[1]] != SAIDA) {
+        pendentes[quantidade++] = adjacente;
+      }
+    }
+  }
+
+  free(vizinhos);
+  free(pendentes);
+  return preenchidas;
+}
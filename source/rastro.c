@@ -0,0 +1,561 @@
+/*
+ * rastro.c - Gravação compacta e reprodução das resoluções animadas
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/rastro.h"
+#include "include/mem.h"
+#include "include/os.h"
+#include "include/ui.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define POSICAO_REPETIDA 0
+#define POSICAO_EXPLICITA 5
+
+static const char caracteres_retrocesso[] = { '{', '}', '/' };
+static const char caracteres_morte[]      = { '+', '?' };
+
+static void gravar_varint(FILE *arquivo, unsigned long valor) {
+  while (valor >= 0x80) {
+    fputc((int)(valor & 0x7F) | 0x80, arquivo);
+    valor >>= 7;
+  }
+  fputc((int)valor, arquivo);
+}
+
+// Zigue-zague: 0, -1, 1, -2, 2... viram 0, 1, 2, 3, 4..., para deslocamentos pequenos ocuparem um byte só
+static void gravar_deslocamento(FILE *arquivo, int valor) {
+  gravar_varint(arquivo, ((unsigned long)valor << 1) ^ (unsigned long)(valor < 0 ? -1L : 0L));
+}
+
+Rastro *abrir_rastro(const char *nome) {
+  Rastro *rastro = calloc(1, sizeof(Rastro));
+  if (rastro == NULL) {
+    erro(L"Falha ao alocar memória para o rastro.");
+  }
+
+  rastro->arquivo = fopen(nome, "wb");
+  if (rastro->arquivo == NULL) {
+    erro(L"Não foi possível criar o arquivo do rastro.");
+  }
+
+  return rastro;
+}
+
+void fechar_rastro(Rastro *rastro) {
+  fclose(rastro->arquivo);
+  free(rastro);
+}
+
+static void gravar_cabecalho(Rastro *rastro, const Labirinto *labirinto) {
+  fwrite(ASSINATURA_RASTRO, 1, 4, rastro->arquivo);
+  fputc(VERSAO_RASTRO, rastro->arquivo);
+  gravar_varint(rastro->arquivo, labirinto->tamanho[0]);
+  gravar_varint(rastro->arquivo, labirinto->tamanho[1]);
+  gravar_varint(rastro->arquivo, max(1, labirinto->andares));
+  gravar_varint(rastro->arquivo, labirinto->jogador.posicao_inicial[0]);
+  gravar_varint(rastro->arquivo, labirinto->jogador.posicao_inicial[1]);
+
+  for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+    fwrite(labirinto->matriz_inicial[i], 1, labirinto->tamanho[1], rastro->arquivo);
+  }
+
+  copiar_matriz((void *)labirinto->jogador.posicao_inicial, rastro->ultima_posicao, sizeof(int[2]));
+  rastro->cabecalho_escrito = 1;
+}
+
+void gravar_inicio(Rastro *rastro, const Labirinto *labirinto) {
+  if (rastro == NULL) {
+    return;
+  }
+
+  if (!rastro->cabecalho_escrito) {
+    gravar_cabecalho(rastro, labirinto);
+  }
+
+  fputc(EVENTO_CONTROLE | CONTROLE_INICIO << 3, rastro->arquivo);
+  gravar_varint(rastro->arquivo, labirinto->jogador.tentativas);
+  rastro->ultimo_quadro = tempo_monotonico();
+}
+
+void gravar_evento(Rastro *rastro, TipoEvento tipo, int variante, const int posicao[2]) {
+  if (rastro == NULL || !rastro->cabecalho_escrito) {
+    return;
+  }
+
+  const int delta_linha  = posicao[0] - rastro->ultima_posicao[0];
+  const int delta_coluna = posicao[1] - rastro->ultima_posicao[1];
+
+  // Quase sempre o evento é na mesma célula ou numa vizinha do anterior, e
+  // cabe inteiro em um byte
+  int codigo = delta_linha == 0 && delta_coluna == 0 ? POSICAO_REPETIDA : POSICAO_EXPLICITA;
+  for (int i = 0; i < 4 && codigo == POSICAO_EXPLICITA; ++i) {
+    if (delta_linha == deslocamento_linha[i] && delta_coluna == deslocamento_coluna[i]) {
+      codigo = i + 1;
+    }
+  }
+
+  fputc(tipo | codigo << 3 | variante << 6, rastro->arquivo);
+  if (codigo == POSICAO_EXPLICITA) {
+    gravar_deslocamento(rastro->arquivo, delta_linha);
+    gravar_deslocamento(rastro->arquivo, delta_coluna);
+  }
+
+  copiar_matriz((void *)posicao, rastro->ultima_posicao, sizeof(int[2]));
+}
+
+void gravar_controle(Rastro *rastro, CodigoControle codigo) {
+  if (rastro == NULL || !rastro->cabecalho_escrito) {
+    return;
+  }
+
+  fputc(EVENTO_CONTROLE | codigo << 3, rastro->arquivo);
+}
+
+void gravar_quadro(Rastro *rastro) {
+  if (rastro == NULL || !rastro->cabecalho_escrito) {
+    return;
+  }
+
+  const double agora = tempo_monotonico();
+  fputc(EVENTO_CONTROLE | CONTROLE_QUADRO << 3, rastro->arquivo);
+  gravar_varint(rastro->arquivo, (unsigned long)((agora - rastro->ultimo_quadro) * 1000 + 0.5));
+  rastro->ultimo_quadro = agora;
+
+  // Os quadros vêm no ritmo da animação, então descarregar a cada um não pesa
+  // e deixa o rastro inteiro mesmo se o programa for morto
+  fflush(rastro->arquivo);
+}
+
+/**
+ * Um evento já decodificado. `valor` é o intervalo de um quadro ou as
+ * tentativas de um início.
+ */
+typedef struct {
+  uint8_t tipo;
+  uint8_t variante;
+  int posicao[2];
+  int valor;
+} EventoRastro;
+
+/**
+ * Uma fotografia do estado da reprodução, guardada a cada
+ * QUADROS_ENTRE_CHAVES quadros para que pular para qualquer quadro custe no
+ * máximo esse tanto de eventos.
+ */
+typedef struct {
+  char *matriz;
+  char *marco;
+  Jogador jogador;
+  int andar_visivel;
+} ChaveRastro;
+
+typedef struct {
+  Labirinto labirinto;
+  EventoRastro *eventos;
+  int quantidade_eventos;
+  int *quadros;
+  int quantidade_quadros;
+  ChaveRastro *chaves;
+} Reproducao;
+
+typedef struct {
+  const uint8_t *dados;
+  size_t tamanho;
+  size_t posicao;
+} Leitor;
+
+static int ler_varint(Leitor *leitor, unsigned long *valor) {
+  *valor = 0;
+  for (int deslocamento = 0; leitor->posicao < leitor->tamanho && deslocamento < 63; deslocamento += 7) {
+    const uint8_t byte = leitor->dados[leitor->posicao++];
+    *valor |= (unsigned long)(byte & 0x7F) << deslocamento;
+    if (!(byte & 0x80)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int ler_deslocamento(Leitor *leitor, int *valor) {
+  unsigned long bruto;
+  if (!ler_varint(leitor, &bruto)) {
+    return 0;
+  }
+  *valor = (int)(bruto >> 1) ^ -(int)(bruto & 1);
+  return 1;
+}
+
+static uint8_t *ler_arquivo_inteiro(const char *nome, size_t *tamanho) {
+  FILE *arquivo = fopen(nome, "rb");
+  if (arquivo == NULL) {
+    erro(L"Arquivo do rastro não encontrado.");
+  }
+
+  size_t capacidade = 1 << 16;
+  uint8_t *dados    = malloc(capacidade);
+  *tamanho          = 0;
+
+  for (size_t lidos; dados != NULL && (lidos = fread(dados + *tamanho, 1, capacidade - *tamanho, arquivo)) > 0;) {
+    *tamanho += lidos;
+    if (*tamanho == capacidade) {
+      capacidade *= 2;
+      dados = realloc(dados, capacidade);
+    }
+  }
+
+  if (dados == NULL) {
+    erro(L"Falha ao alocar memória para o rastro.");
+  }
+
+  fclose(arquivo);
+  return dados;
+}
+
+static void ler_cabecalho(Leitor *leitor, Labirinto *labirinto) {
+  unsigned long valores[5];
+
+  if (leitor->tamanho < 5 || memcmp(leitor->dados, ASSINATURA_RASTRO, 4) != 0 || leitor->dados[4] != VERSAO_RASTRO) {
+    erro(L"O arquivo não é um rastro do labirintite.");
+  }
+  leitor->posicao = 5;
+
+  for (int i = 0; i < 5; ++i) {
+    if (!ler_varint(leitor, &valores[i])) {
+      erro(L"Rastro incompleto.");
+    }
+  }
+
+  // As linhas contam os andares e as paredes entre eles
+  if (valores[2] < 1 || valores[2] > ANDARES_MAXIMO || (valores[0] + 1) % valores[2] != 0) {
+    erro(L"Cabeçalho do rastro inválido.");
+  }
+  const unsigned long linhas_andar = (valores[0] + 1) / valores[2] - 1;
+
+  if (linhas_andar < 2 || valores[1] < 2 || linhas_andar > TAMANHO_MAXIMO || valores[1] > TAMANHO_MAXIMO || valores[3] >= valores[0] ||
+      valores[4] >= valores[1] || leitor->tamanho - leitor->posicao < valores[0] * valores[1]) {
+    erro(L"Cabeçalho do rastro inválido.");
+  }
+
+  labirinto->tamanho[0]                 = (int)valores[0];
+  labirinto->tamanho[1]                 = (int)valores[1];
+  labirinto->andares                    = (int)valores[2];
+  labirinto->linhas_andar               = (int)linhas_andar;
+  labirinto->jogador.posicao_inicial[0] = (int)valores[3];
+  labirinto->jogador.posicao_inicial[1] = (int)valores[4];
+
+  labirinto->matriz         = alocar_matriz(labirinto->tamanho[0], labirinto->tamanho[1]);
+  labirinto->matriz_inicial = alocar_matriz(labirinto->tamanho[0], labirinto->tamanho[1]);
+  labirinto->trilha.matriz  = alocar_matriz(labirinto->tamanho[0], labirinto->tamanho[1]);
+
+  for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+    copiar_matriz((void *)(leitor->dados + leitor->posicao), labirinto->matriz_inicial[i], labirinto->tamanho[1]);
+    leitor->posicao += labirinto->tamanho[1];
+  }
+
+  copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+  copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->trilha.matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+  copiar_matriz(labirinto->jogador.posicao_inicial, labirinto->jogador.posicao, sizeof(int[2]));
+}
+
+/**
+ * Decodifica os eventos até o fim do arquivo. Um rastro cortado no meio, como
+ * o de um programa interrompido com Ctrl+C, é lido até o último evento inteiro.
+ */
+static void decodificar_eventos(Leitor *leitor, Reproducao *reproducao) {
+  const Labirinto *labirinto = &reproducao->labirinto;
+  int capacidade             = 1024;
+  int posicao[2]             = { labirinto->jogador.posicao_inicial[0], labirinto->jogador.posicao_inicial[1] };
+
+  reproducao->eventos = malloc(capacidade * sizeof(EventoRastro));
+  reproducao->quadros = malloc(capacidade * sizeof(int));
+
+  while (leitor->posicao < leitor->tamanho) {
+    if (reproducao->quantidade_eventos == capacidade) {
+      capacidade *= 2;
+      reproducao->eventos = realloc(reproducao->eventos, capacidade * sizeof(EventoRastro));
+      reproducao->quadros = realloc(reproducao->quadros, capacidade * sizeof(int));
+    }
+
+    if (reproducao->eventos == NULL || reproducao->quadros == NULL) {
+      erro(L"Falha ao alocar memória para os eventos do rastro.");
+    }
+
+    const uint8_t byte   = leitor->dados[leitor->posicao++];
+    EventoRastro *evento = &reproducao->eventos[reproducao->quantidade_eventos];
+    unsigned long valor  = 0;
+
+    evento->tipo = byte & 7;
+
+    if (evento->tipo == EVENTO_CONTROLE) {
+      evento->variante = byte >> 3;
+      if (evento->variante > CONTROLE_MOSTRAR_INICIAL) {
+        erro(L"Evento de controle desconhecido no rastro.");
+      }
+      if ((evento->variante == CONTROLE_QUADRO || evento->variante == CONTROLE_INICIO) && !ler_varint(leitor, &valor)) {
+        break;
+      }
+      evento->valor = (int)min(valor, (unsigned long)INT32_MAX);
+    } else {
+      const int codigo = (byte >> 3) & 7;
+      evento->variante = byte >> 6;
+
+      if (evento->tipo > EVENTO_MORTE || codigo > POSICAO_EXPLICITA) {
+        erro(L"Evento desconhecido no rastro.");
+      }
+
+      if (codigo == POSICAO_EXPLICITA) {
+        int delta[2];
+        if (!ler_deslocamento(leitor, &delta[0]) || !ler_deslocamento(leitor, &delta[1])) {
+          break;
+        }
+        posicao[0] += delta[0];
+        posicao[1] += delta[1];
+      } else if (codigo != POSICAO_REPETIDA) {
+        posicao[0] += deslocamento_linha[codigo - 1];
+        posicao[1] += deslocamento_coluna[codigo - 1];
+      }
+
+      if (!checar_coordenada((int *)labirinto->tamanho, posicao)) {
+        erro(L"Evento fora do labirinto no rastro.");
+      }
+      copiar_matriz(posicao, evento->posicao, sizeof(int[2]));
+    }
+
+    if (evento->tipo == EVENTO_CONTROLE && evento->variante == CONTROLE_QUADRO) {
+      reproducao->quadros[reproducao->quantidade_quadros++] = reproducao->quantidade_eventos;
+    }
+    reproducao->quantidade_eventos++;
+  }
+}
+
+static void aplicar_evento(Labirinto *labirinto, const EventoRastro *evento) {
+  const int linhas = labirinto->tamanho[0], colunas = labirinto->tamanho[1];
+  const int *p     = evento->posicao;
+  int *jogador     = labirinto->jogador.posicao;
+
+  // A tela acompanha o andar do último evento, como na resolução gravada
+  if (evento->tipo != EVENTO_CONTROLE) {
+    labirinto->andar_visivel = andar_da_linha(labirinto, p[0]);
+  }
+
+  switch (evento->tipo) {
+  case EVENTO_VISITA: labirinto->matriz[p[0]][p[1]] = TRILHA; break;
+  case EVENTO_RETROCESSO: labirinto->matriz[p[0]][p[1]] = caracteres_retrocesso[min(evento->variante, 2)]; break;
+  case EVENTO_CAMINHO: labirinto->trilha.matriz[p[0]][p[1]] = TRILHA; break;
+  case EVENTO_JOGADOR:
+    labirinto->matriz[jogador[0]][jogador[1]] = labirinto->matriz_inicial[jogador[0]][jogador[1]] == INIMIGO ? '!' : CAMINHO;
+    labirinto->matriz[p[0]][p[1]]             = labirinto->matriz[p[0]][p[1]] == SAIDA ? 'V' : JOGADOR;
+    copiar_matriz((void *)p, jogador, sizeof(int[2]));
+    break;
+  case EVENTO_COMBATE: labirinto->jogador.inimigos_derrotados += evento->variante == 0; break;
+  case EVENTO_MORTE:
+    labirinto->matriz[p[0]][p[1]] = caracteres_morte[evento->variante & 1];
+    labirinto->jogador.tentativas++;
+    break;
+  case EVENTO_CONTROLE:
+    switch (evento->variante) {
+    case CONTROLE_INICIO: labirinto->jogador.tentativas = evento->valor; break;
+    case CONTROLE_RESTAURAR_INICIAL:
+    case CONTROLE_RESTAURAR_MARCO:
+      copiar_matriz_bidimensional(evento->variante == CONTROLE_RESTAURAR_INICIAL ? labirinto->matriz_inicial : labirinto->trilha.matriz,
+                                  labirinto->matriz, linhas, colunas);
+      copiar_matriz(labirinto->jogador.posicao_inicial, jogador, sizeof(int[2]));
+      labirinto->jogador.inimigos_derrotados = 0;
+      break;
+    case CONTROLE_MARCAR_ATUAL: copiar_matriz_bidimensional(labirinto->matriz, labirinto->trilha.matriz, linhas, colunas); break;
+    case CONTROLE_MARCAR_INICIAL: copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->trilha.matriz, linhas, colunas); break;
+    case CONTROLE_MOSTRAR_MARCO: copiar_matriz_bidimensional(labirinto->trilha.matriz, labirinto->matriz, linhas, colunas); break;
+    case CONTROLE_MOSTRAR_INICIAL: copiar_matriz_bidimensional(labirinto->matriz_inicial, labirinto->matriz, linhas, colunas); break;
+    }
+    break;
+  }
+}
+
+static void salvar_chave(const Labirinto *labirinto, ChaveRastro *chave) {
+  const int colunas = labirinto->tamanho[1];
+  for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+    copiar_matriz(labirinto->matriz[i], chave->matriz + (size_t)i * colunas, colunas);
+    copiar_matriz(labirinto->trilha.matriz[i], chave->marco + (size_t)i * colunas, colunas);
+  }
+  chave->jogador       = labirinto->jogador;
+  chave->andar_visivel = labirinto->andar_visivel;
+}
+
+static void carregar_chave(Labirinto *labirinto, const ChaveRastro *chave) {
+  const int colunas = labirinto->tamanho[1];
+  for (int i = 0; i < labirinto->tamanho[0]; ++i) {
+    copiar_matriz(chave->matriz + (size_t)i * colunas, labirinto->matriz[i], colunas);
+    copiar_matriz(chave->marco + (size_t)i * colunas, labirinto->trilha.matriz[i], colunas);
+  }
+  labirinto->jogador       = chave->jogador;
+  labirinto->andar_visivel = chave->andar_visivel;
+}
+
+/**
+ * Aplica todos os eventos uma vez, sem desenhar, guardando uma chave a cada
+ * QUADROS_ENTRE_CHAVES quadros. A chave c é o estado logo depois do quadro
+ * c * QUADROS_ENTRE_CHAVES.
+ */
+static void construir_chaves(Reproducao *reproducao) {
+  Labirinto *labirinto      = &reproducao->labirinto;
+  const size_t celulas      = (size_t)labirinto->tamanho[0] * labirinto->tamanho[1];
+  const int quantidade      = (reproducao->quantidade_quadros + QUADROS_ENTRE_CHAVES - 1) / QUADROS_ENTRE_CHAVES;
+  char *memoria             = malloc(max(1, quantidade) * celulas * 2);
+  reproducao->chaves        = malloc(max(1, quantidade) * sizeof(ChaveRastro));
+  const Jogador jogador     = labirinto->jogador;
+  char **const matriz_salva = alocar_matriz(labirinto->tamanho[0], labirinto->tamanho[1]);
+
+  if (memoria == NULL || reproducao->chaves == NULL) {
+    erro(L"Falha ao alocar memória para as chaves do rastro.");
+  }
+
+  copiar_matriz_bidimensional(labirinto->matriz, matriz_salva, labirinto->tamanho[0], labirinto->tamanho[1]);
+
+  for (int c = 0, evento = 0; c < quantidade; ++c) {
+    const int ultimo = reproducao->quadros[c * QUADROS_ENTRE_CHAVES];
+    for (; evento <= ultimo; ++evento) {
+      aplicar_evento(labirinto, &reproducao->eventos[evento]);
+    }
+
+    reproducao->chaves[c].matriz = memoria + c * celulas * 2;
+    reproducao->chaves[c].marco  = memoria + c * celulas * 2 + celulas;
+    salvar_chave(labirinto, &reproducao->chaves[c]);
+  }
+
+  // Volta ao estado antes do primeiro evento; o marco começa igual ao inicial
+  copiar_matriz_bidimensional(matriz_salva, labirinto->matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+  copiar_matriz_bidimensional(matriz_salva, labirinto->trilha.matriz, labirinto->tamanho[0], labirinto->tamanho[1]);
+  labirinto->jogador       = jogador;
+  labirinto->andar_visivel = andar_da_linha(labirinto, jogador.posicao[0]);
+  limpar_matriz(matriz_salva, labirinto->tamanho[0]);
+}
+
+/**
+ * Leva a reprodução para logo depois do quadro pedido, partindo da chave mais
+ * próxima antes dele.
+ */
+static void posicionar_quadro(Reproducao *reproducao, int quadro) {
+  const int chave = quadro / QUADROS_ENTRE_CHAVES;
+  carregar_chave(&reproducao->labirinto, &reproducao->chaves[chave]);
+
+  const int ultimo = reproducao->quadros[quadro];
+  for (int evento = reproducao->quadros[chave * QUADROS_ENTRE_CHAVES] + 1; evento <= ultimo; ++evento) {
+    aplicar_evento(&reproducao->labirinto, &reproducao->eventos[evento]);
+  }
+}
+
+static void avancar_quadro(Reproducao *reproducao, int quadro) {
+  for (int evento = reproducao->quadros[quadro] + 1; evento <= reproducao->quadros[quadro + 1]; ++evento) {
+    aplicar_evento(&reproducao->labirinto, &reproducao->eventos[evento]);
+  }
+}
+
+static void desenhar_quadro(Reproducao *reproducao, int quadro, double velocidade, int pausado) {
+  wchar_t linha[128];
+  swprintf(linha, sizeof(linha) / sizeof(wchar_t), L"Quadro %d de %d, %gx%ls", quadro + 1, reproducao->quantidade_quadros, velocidade,
+           pausado ? L" (pausado)" : L"");
+
+  atualizar_interface(&reproducao->labirinto);
+  mensagem(&reproducao->labirinto, linha);
+}
+
+static void liberar_reproducao(Reproducao *reproducao) {
+  const int linhas = reproducao->labirinto.tamanho[0];
+  limpar_matriz(reproducao->labirinto.matriz, linhas);
+  limpar_matriz(reproducao->labirinto.matriz_inicial, linhas);
+  limpar_matriz(reproducao->labirinto.trilha.matriz, linhas);
+  if (reproducao->chaves != NULL) {
+    free(reproducao->chaves[0].matriz);
+  }
+  free(reproducao->chaves);
+  free(reproducao->eventos);
+  free(reproducao->quadros);
+}
+
+void reproduzir_rastro(const Opcoes *opcoes) {
+  Reproducao reproducao = { 0 };
+  size_t tamanho;
+  uint8_t *dados = ler_arquivo_inteiro(opcoes->reproduzir, &tamanho);
+  Leitor leitor  = { dados, tamanho, 0 };
+
+  ler_cabecalho(&leitor, &reproducao.labirinto);
+  decodificar_eventos(&leitor, &reproducao);
+  free(dados);
+
+  if (reproducao.quantidade_quadros == 0) {
+    erro(L"O rastro não tem nenhum quadro.");
+  }
+
+  construir_chaves(&reproducao);
+
+  double velocidade = opcoes->velocidade > 0 ? opcoes->velocidade : 1;
+  int quadro        = min(max(opcoes->passo, 1), reproducao.quantidade_quadros) - 1;
+  int pausado       = 0;
+
+  imprimir_titulo();
+  configurar_terminal();
+  posicionar_quadro(&reproducao, quadro);
+  desenhar_quadro(&reproducao, quadro, velocidade, pausado);
+
+  for (int sair = 0;;) {
+    const int ultimo_quadro = quadro + 1 >= reproducao.quantidade_quadros;
+    const double espera     = pausado || ultimo_quadro ? -1 : reproducao.eventos[reproducao.quadros[quadro + 1]].valor / 1000.0 / velocidade;
+
+    if (!esperar_tecla(espera)) {
+      avancar_quadro(&reproducao, quadro++);
+      desenhar_quadro(&reproducao, quadro, velocidade, pausado);
+      continue;
+    }
+
+    int destino = quadro;
+    switch (ler_tecla_pressionada()) {
+    case ' ': pausado = !pausado; break;
+    case '+': velocidade = min(velocidade * 2, 1024); break;
+    case '-': velocidade = max(velocidade / 2, 1.0 / 64); break;
+    case DIREITA: destino = quadro + 1, pausado = 1; break;
+    case ESQUERDA: destino = quadro - 1, pausado = 1; break;
+    case ACIMA: destino = quadro + QUADROS_ENTRE_CHAVES; break;
+    case ABAIXO: destino = quadro - QUADROS_ENTRE_CHAVES; break;
+    case 'q': sair = 1; break;
+    }
+
+    if (sair) {
+      break;
+    }
+
+    destino = min(max(destino, 0), reproducao.quantidade_quadros - 1);
+    if (destino == quadro + 1) {
+      avancar_quadro(&reproducao, quadro);
+    } else if (destino != quadro) {
+      posicionar_quadro(&reproducao, destino);
+    }
+
+    quadro = destino;
+    desenhar_quadro(&reproducao, quadro, velocidade, pausado);
+  }
+
+  mover_cursor(max(reproducao.labirinto.tamanho[0], 14) + 2, 1);
+  restaurar_terminal();
+  wprintf(L"\n");
+  liberar_reproducao(&reproducao);
+}
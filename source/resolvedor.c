@@ -0,0 +1,261 @@
+/*
+ * resolvedor.c - Consultas sem interface sobre labirintos já carregados
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/resolvedor.h"
+#include "include/a_star_paralelo.h"
+#include "include/ara_star.h"
+#include "include/busca.h"
+#include "include/cache.h"
+#include "include/cronologia.h"
+#include "include/io.h"
+#include "include/util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+const char *nomes_algoritmos[] = { "bfs", "a_star", "ara", "campo", "paralelo", "juncoes", "hierarquico", "gargalos" };
+
+void preparar_labirinto(LabirintoPreparado *preparado, const char *nome) {
+  memset(preparado, 0, sizeof(LabirintoPreparado));
+  carregar_labirinto(&preparado->labirinto, nome);
+
+  construir_bitmapa(&preparado->bitmapas[0], &preparado->labirinto, 0);
+  construir_bitmapa(&preparado->bitmapas[1], &preparado->labirinto, 1);
+  calcular_campo(&preparado->campos[0], &preparado->labirinto, SEM_INIMIGOS);
+  calcular_campo(&preparado->campos[1], &preparado->labirinto, PENALIDADE_INIMIGO);
+  construir_grafo(&preparado->grafos[0], &preparado->labirinto, SEM_INIMIGOS);
+  construir_grafo(&preparado->grafos[1], &preparado->labirinto, PENALIDADE_INIMIGO);
+  construir_hierarquia(&preparado->hierarquias[0], &preparado->labirinto, SEM_INIMIGOS);
+  construir_hierarquia(&preparado->hierarquias[1], &preparado->labirinto, PENALIDADE_INIMIGO);
+  encontrar_gargalos(&preparado->gargalos[0], &preparado->labirinto, 0, preparado->labirinto.jogador.posicao_inicial);
+  encontrar_gargalos(&preparado->gargalos[1], &preparado->labirinto, 1, preparado->labirinto.jogador.posicao_inicial);
+}
+
+void preparar_para_consulta(LabirintoPreparado *preparado, Algoritmo algoritmo, int penalidade) {
+  const Labirinto *labirinto = &preparado->labirinto;
+  const int i                = penalidade >= 0;
+
+  // Fora das duas penalidades mais usadas, `resolver_consulta` calcula a
+  // estrutura na hora, como faria com um labirinto preparado por inteiro
+  if (algoritmo == ALGORITMO_BFS) {
+    construir_bitmapa(&preparado->bitmapas[i], labirinto, i);
+  } else if (algoritmo == ALGORITMO_GARGALOS) {
+    encontrar_gargalos(&preparado->gargalos[i], labirinto, i, (int *)labirinto->jogador.posicao_inicial);
+  } else if (penalidade != SEM_INIMIGOS && penalidade != PENALIDADE_INIMIGO) {
+    return;
+  } else if (algoritmo == ALGORITMO_CAMPO) {
+    calcular_campo(&preparado->campos[i], labirinto, penalidade);
+  } else if (algoritmo == ALGORITMO_JUNCOES) {
+    construir_grafo(&preparado->grafos[i], labirinto, penalidade);
+  } else if (algoritmo == ALGORITMO_HIERARQUICO) {
+    construir_hierarquia(&preparado->hierarquias[i], labirinto, penalidade);
+  }
+}
+
+void liberar_estruturas(LabirintoPreparado *preparado) {
+  for (int i = 0; i < 2; ++i) {
+    liberar_bitmapa(&preparado->bitmapas[i]);
+    liberar_campo(&preparado->campos[i]);
+    liberar_grafo(&preparado->grafos[i]);
+    liberar_hierarquia(&preparado->hierarquias[i]);
+    liberar_gargalos(&preparado->gargalos[i]);
+  }
+}
+
+void liberar_labirinto_preparado(LabirintoPreparado *preparado) {
+  liberar_estruturas(preparado);
+  fechar_labirinto(&preparado->labirinto);
+}
+
+int ler_algoritmo(const char *nome, Algoritmo *algoritmo) {
+  for (int i = 0; i < (int)(sizeof nomes_algoritmos / sizeof nomes_algoritmos[0]); ++i) {
+    if (strcmp(nome, nomes_algoritmos[i]) == 0) {
+      *algoritmo = i;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int resolver_consulta(const LabirintoPreparado *preparado, Algoritmo algoritmo, int origem[2], int penalidade, const Opcoes *opcoes,
+                      Caminho *caminho) {
+  const Labirinto *labirinto = &preparado->labirinto;
+
+  // Sem destino, as buscas param na primeira saída em que chegarem
+  switch (algoritmo) {
+  case ALGORITMO_BFS:
+    if (buscar_bitparalelo(&preparado->bitmapas[penalidade >= 0], labirinto, origem, NULL, penalidade, caminho) < 0) {
+      return -1;
+    }
+    return caminho->custo;
+  case ALGORITMO_A_STAR: return buscar_a_star(labirinto, origem, NULL, penalidade, caminho);
+  case ALGORITMO_ARA:
+    return buscar_ara_star(labirinto, origem, NULL, penalidade, EPSILON_INICIAL, opcoes->prazo, NULL, NULL, caminho);
+  case ALGORITMO_PARALELO: return buscar_a_star_paralelo(labirinto, origem, NULL, penalidade, opcoes->threads, caminho);
+  case ALGORITMO_CAMPO:
+    if (penalidade == SEM_INIMIGOS || penalidade == PENALIDADE_INIMIGO) {
+      return consultar_campo(&preparado->campos[penalidade >= 0], origem, caminho);
+    } else {
+      CampoDistancia campo;
+      calcular_campo(&campo, labirinto, penalidade);
+      const int custo = consultar_campo(&campo, origem, caminho);
+      liberar_campo(&campo);
+      return custo;
+    }
+  case ALGORITMO_JUNCOES:
+    if (penalidade == SEM_INIMIGOS || penalidade == PENALIDADE_INIMIGO) {
+      return buscar_no_grafo(&preparado->grafos[penalidade >= 0], labirinto, origem, caminho);
+    } else {
+      GrafoJuncoes grafo;
+      construir_grafo(&grafo, labirinto, penalidade);
+      const int custo = buscar_no_grafo(&grafo, labirinto, origem, caminho);
+      liberar_grafo(&grafo);
+      return custo;
+    }
+  case ALGORITMO_HIERARQUICO:
+    if (penalidade == SEM_INIMIGOS || penalidade == PENALIDADE_INIMIGO) {
+      return buscar_hierarquico(&preparado->hierarquias[penalidade >= 0], labirinto, origem, caminho);
+    } else {
+      Hierarquia hierarquia;
+      construir_hierarquia(&hierarquia, labirinto, penalidade);
+      const int custo = buscar_hierarquico(&hierarquia, labirinto, origem, caminho);
+      liberar_hierarquia(&hierarquia);
+      return custo;
+    }
+  case ALGORITMO_GARGALOS: {
+    const Gargalos *gargalos = &preparado->gargalos[penalidade >= 0];
+    if (gargalos->calculados && gargalos->origem[0] == origem[0] && gargalos->origem[1] == origem[1]) {
+      return buscar_por_gargalos(gargalos, labirinto, penalidade, opcoes->threads, caminho);
+    }
+
+    Gargalos da_origem;
+    encontrar_gargalos(&da_origem, labirinto, penalidade >= 0, origem);
+    const int custo = buscar_por_gargalos(&da_origem, labirinto, penalidade, opcoes->threads, caminho);
+    liberar_gargalos(&da_origem);
+    return custo;
+  }
+  }
+
+  return -1;
+}
+
+Caminho *alocar_caminhos(int quantidade) {
+  Caminho *caminhos = calloc(max(1, quantidade), sizeof(Caminho));
+  if (caminhos == NULL) {
+    erro(L"Falha ao alocar memória para os caminhos.");
+  }
+  return caminhos;
+}
+
+int resolver_arquivo(const char *nome, Algoritmo algoritmo, int penalidade, const Opcoes *opcoes, Caminho **caminhos) {
+  ChaveCache chave;
+  Caminho guardado = { 0 };
+  int com_cache    = 0;
+
+  if (opcoes->cache) {
+    const Trecho trecho = comecar_trecho("consultar_cache");
+    size_t tamanho;
+    char *texto = ler_conteudo_arquivo(nome, &tamanho);
+    com_cache   = texto != NULL && calcular_chave_cache(&chave, texto, tamanho, algoritmo, penalidade, opcoes->prazo);
+    free(texto);
+
+    const int encontrado = com_cache && buscar_no_cache(opcoes->cache, &chave, &guardado);
+    terminar_trecho(trecho);
+    if (encontrado) {
+      *caminhos      = alocar_caminhos(1);
+      (*caminhos)[0] = guardado;
+      return 1;
+    }
+  }
+
+  LabirintoPreparado preparado = { 0 };
+  carregar_labirinto(&preparado.labirinto, nome);
+  preparar_para_consulta(&preparado, algoritmo, penalidade);
+
+  const int quantidade = preparado.labirinto.quantidade_partidas;
+  if (quantidade == 0 || preparado.labirinto.quantidade_saidas == 0) {
+    erro(L"O labirinto precisa de um jogador e uma saída.");
+  }
+
+  *caminhos = alocar_caminhos(quantidade);
+  for (int i = 0; i < quantidade; ++i) {
+    int *origem = preparado.labirinto.partidas[i];
+    if (!passavel(preparado.labirinto.matriz_inicial[origem[0]][origem[1]], penalidade >= 0)) {
+      erro(L"A posição do jogador está bloqueada.");
+    }
+    (*caminhos)[i].custo = resolver_consulta(&preparado, algoritmo, origem, penalidade, opcoes, &(*caminhos)[i]);
+  }
+  liberar_labirinto_preparado(&preparado);
+
+  // Só labirintos com uma partida e uma saída têm chave no cache
+  if (com_cache) {
+    guardar_no_cache(opcoes->cache, &chave, (*caminhos)[0].custo, &(*caminhos)[0]);
+  }
+  return quantidade;
+}
+
+static const char letras_direcoes[] = { 'A', 'B', 'E', 'D', '<', '>' };
+
+void escrever_direcoes(FILE *arquivo, const Caminho *caminho) {
+  for (int i = 0; i < caminho->tamanho; ++i) {
+    fputc(letras_direcoes[caminho->direcoes[i]], arquivo);
+  }
+}
+
+char *direcoes_em_texto(const Caminho *caminho) {
+  char *texto = malloc(caminho->tamanho + 1);
+  if (texto == NULL) {
+    erro(L"Falha ao alocar memória para as direções.");
+  }
+
+  for (int i = 0; i < caminho->tamanho; ++i) {
+    texto[i] = letras_direcoes[caminho->direcoes[i]];
+  }
+  texto[caminho->tamanho] = '\0';
+  return texto;
+}
+
+void executar_resolucao(const Opcoes *opcoes) {
+  Algoritmo algoritmo = ALGORITMO_A_STAR;
+
+  if (opcoes->arquivo == NULL) {
+    erro(L"Informe o labirinto para resolver.");
+  }
+  if (!ler_algoritmo(opcoes->algoritmo, &algoritmo)) {
+    erro(L"Algoritmo desconhecido.");
+  }
+
+  Caminho *caminhos  = NULL;
+  const int partidas = resolver_arquivo(opcoes->arquivo, algoritmo, opcoes->penalidade, opcoes, &caminhos);
+
+  for (int i = 0; i < partidas; ++i) {
+    if (caminhos[i].custo < 0) {
+      wprintf(L"erro sem caminho\n");
+    } else {
+      char *texto = direcoes_em_texto(&caminhos[i]);
+      wprintf(L"ok %d %d %s\n", caminhos[i].custo, caminhos[i].tamanho, texto);
+      free(texto);
+    }
+    liberar_caminho(&caminhos[i]);
+  }
+
+  free(caminhos);
+}
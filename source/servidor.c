@@ -0,0 +1,543 @@
+/*
+ * servidor.c - Servidor de caminhos por socket Unix
+ *
+ * Copyright (C) 2025 Iarlo Bruno Damasceno De Sá <iarlo.sa@dcomp.ufs.br>
+ * Copyright (C) 2025 Karlus Dória Da Silva Júnior <karlus@academico.ufs.br>
+ * Copyright (C) 2025 Jaqueline Nascimento <jaquelinenascimento@academico.ufs.br>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "include/servidor.h"
+#include "include/cronologia.h"
+#include "include/resolvedor.h"
+#include "include/util.h"
+
+#ifdef _WIN32
+
+void executar_servidor(const Opcoes *opcoes) {
+  (void)opcoes;
+  erro(L"O modo servidor depende de sockets Unix e não está disponível no Windows.");
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Uma linha recebida. Ela fica na lista da sua conexão, na ordem de chegada,
+ * até a resposta ser enviada, e na fila dos trabalhadores até um deles
+ * montar a resposta em `resposta`.
+ */
+typedef struct Pedido {
+  struct Pedido *proximo;
+  struct Pedido *proximo_na_fila;
+  char texto[TAMANHO_LINHA_PEDIDO + 1];
+  int longo_demais;
+  char *resposta;
+  size_t tamanho_resposta;
+  _Atomic int pronto;
+} Pedido;
+
+/**
+ * Uma conexão aberta. `recebido` guarda o que chegou e ainda não formou uma
+ * linha; `descartando` indica que a linha atual passou do tamanho máximo e
+ * está sendo jogada fora até a quebra de linha. `enviados` conta os bytes já
+ * escritos da resposta do primeiro pedido.
+ */
+typedef struct {
+  int descritor;
+  char recebido[TAMANHO_LINHA_PEDIDO];
+  size_t lidos;
+  int descartando;
+  int terminou;
+  int falhou;
+
+  Pedido *primeiro, *ultimo;
+  int pendentes;
+  size_t enviados;
+} Conexao;
+
+typedef struct {
+  const Opcoes *opcoes;
+  LabirintoPreparado *labirintos;
+  int quantidade;
+
+  Conexao *conexoes;
+
+  pthread_mutex_t trava;
+  pthread_cond_t sinal;
+  Pedido *fila_inicio, *fila_fim;
+  int encerrando;
+
+  // Os trabalhadores escrevem um byte aqui para acordar o poll
+  int aviso[2];
+} Servidor;
+
+static volatile sig_atomic_t parar_servidor = 0;
+
+static void pedir_parada(int sinal) {
+  (void)sinal;
+  parar_servidor = 1;
+}
+
+static const LabirintoPreparado *procurar_labirinto(const Servidor *servidor, const char *nome) {
+  for (int i = 0; i < servidor->quantidade; ++i) {
+    // O nome guardado no labirinto é truncado, então comparamos com o argumento
+    const char *arquivo = servidor->opcoes->arquivos[i];
+    const char *base    = strrchr(arquivo, '/');
+
+    if (strcmp(arquivo, nome) == 0 || (base && strcmp(base + 1, nome) == 0)) {
+      return &servidor->labirintos[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Responde um pedido. Tudo é validado aqui antes de chegar nos resolvedores,
+ * que tratam entradas inválidas encerrando o programa.
+ */
+static void atender_pedido(const Servidor *servidor, char *pedido, FILE *saida) {
+  char *contexto  = NULL;
+  char *nome      = strtok_r(pedido, " \t\r\n", &contexto);
+  char *algoritmo = strtok_r(NULL, " \t\r\n", &contexto);
+  char *linha     = strtok_r(NULL, " \t\r\n", &contexto);
+  char *coluna    = strtok_r(NULL, " \t\r\n", &contexto);
+  char *custo     = strtok_r(NULL, " \t\r\n", &contexto);
+
+  if (nome == NULL) {
+    return;
+  }
+
+  if (strcmp(nome, "listar") == 0) {
+    for (int i = 0; i < servidor->quantidade; ++i) {
+      const Labirinto *labirinto = &servidor->labirintos[i].labirinto;
+      fprintf(saida, "%s %dx%d\n", servidor->opcoes->arquivos[i], labirinto->tamanho[0], labirinto->tamanho[1]);
+    }
+    fprintf(saida, "ok %d\n", servidor->quantidade);
+    return;
+  }
+
+  const LabirintoPreparado *preparado = procurar_labirinto(servidor, nome);
+  Algoritmo escolhido;
+
+  if (preparado == NULL) {
+    fprintf(saida, "erro labirinto desconhecido\n");
+    return;
+  }
+  if (algoritmo == NULL || !ler_algoritmo(algoritmo, &escolhido)) {
+    fprintf(saida, "erro algoritmo desconhecido\n");
+    return;
+  }
+  if ((linha == NULL) != (coluna == NULL)) {
+    fprintf(saida, "erro informe a linha e a coluna\n");
+    return;
+  }
+
+  const Labirinto *labirinto = &preparado->labirinto;
+  int origem[2]              = { labirinto->jogador.posicao_inicial[0], labirinto->jogador.posicao_inicial[1] };
+  int penalidade             = PENALIDADE_INIMIGO;
+
+  if (linha) {
+    origem[0] = atoi(linha);
+    origem[1] = atoi(coluna);
+  }
+  if (custo) {
+    penalidade = strcmp(custo, "sem") == 0 ? SEM_INIMIGOS : max(0, atoi(custo));
+  }
+
+  if (origem[0] < 0 || origem[0] >= labirinto->tamanho[0] || origem[1] < 0 || origem[1] >= labirinto->tamanho[1]) {
+    fprintf(saida, "erro posição fora do labirinto\n");
+    return;
+  }
+  if (!passavel(labirinto->matriz_inicial[origem[0]][origem[1]], penalidade >= 0)) {
+    fprintf(saida, "erro posição bloqueada\n");
+    return;
+  }
+
+  Caminho caminho = { 0 };
+  const int total = resolver_consulta(preparado, escolhido, origem, penalidade, servidor->opcoes, &caminho);
+
+  if (total < 0) {
+    fprintf(saida, "erro sem caminho\n");
+  } else {
+    fprintf(saida, "ok %d %d ", total, caminho.tamanho);
+    escrever_direcoes(saida, &caminho);
+    fputc('\n', saida);
+  }
+
+  liberar_caminho(&caminho);
+}
+
+static void *trabalhador(void *argumento) {
+  Servidor *servidor = argumento;
+
+  for (;;) {
+    pthread_mutex_lock(&servidor->trava);
+    while (servidor->fila_inicio == NULL && !servidor->encerrando) {
+      pthread_cond_wait(&servidor->sinal, &servidor->trava);
+    }
+
+    if (servidor->encerrando) {
+      pthread_mutex_unlock(&servidor->trava);
+      return NULL;
+    }
+
+    Pedido *pedido        = servidor->fila_inicio;
+    servidor->fila_inicio = pedido->proximo_na_fila;
+    if (servidor->fila_inicio == NULL) {
+      servidor->fila_fim = NULL;
+    }
+    pthread_mutex_unlock(&servidor->trava);
+
+    const Trecho trecho = comecar_trecho("atender_pedido");
+    FILE *saida         = open_memstream(&pedido->resposta, &pedido->tamanho_resposta);
+
+    if (saida == NULL) {
+      erro(L"Falha ao alocar memória para a resposta.");
+    }
+
+    if (pedido->longo_demais) {
+      fprintf(saida, "erro pedido longo demais\n");
+    } else {
+      atender_pedido(servidor, pedido->texto, saida);
+    }
+    fclose(saida);
+    terminar_trecho(trecho);
+
+    atomic_store(&pedido->pronto, 1);
+    if (write(servidor->aviso[1], "", 1) < 0) {
+      // O cano cheio já vai acordar o poll
+    }
+  }
+}
+
+/**
+ * Separa a próxima linha do que chegou pela conexão e a entrega aos
+ * trabalhadores. Uma linha que não cabe em TAMANHO_LINHA_PEDIDO é descartada
+ * até a quebra de linha e respondida com um erro.
+ *
+ * @return 1 se um pedido foi entregue, 0 se a linha ainda não chegou inteira.
+ */
+static int despachar_pedido(Servidor *servidor, Conexao *conexao) {
+  char *quebra = memchr(conexao->recebido, '\n', conexao->lidos);
+
+  if (quebra == NULL && conexao->lidos == sizeof conexao->recebido) {
+    conexao->descartando = 1;
+    conexao->lidos       = 0;
+    return 0;
+  }
+
+  // Sem a quebra, só a última linha antes do fim da conexão é um pedido
+  if (quebra == NULL && (!conexao->terminou || (conexao->lidos == 0 && !conexao->descartando))) {
+    return 0;
+  }
+
+  const size_t tamanho = quebra ? (size_t)(quebra - conexao->recebido) + 1 : conexao->lidos;
+  Pedido *pedido       = calloc(1, sizeof(Pedido));
+
+  if (pedido == NULL) {
+    erro(L"Falha ao alocar memória para o pedido.");
+  }
+
+  memcpy(pedido->texto, conexao->recebido, tamanho);
+  pedido->longo_demais = conexao->descartando;
+  memmove(conexao->recebido, conexao->recebido + tamanho, conexao->lidos - tamanho);
+  conexao->lidos -= tamanho;
+  conexao->descartando = 0;
+
+  if (conexao->ultimo) {
+    conexao->ultimo->proximo = pedido;
+  } else {
+    conexao->primeiro = pedido;
+  }
+  conexao->ultimo = pedido;
+  conexao->pendentes++;
+
+  pthread_mutex_lock(&servidor->trava);
+  if (servidor->fila_fim) {
+    servidor->fila_fim->proximo_na_fila = pedido;
+  } else {
+    servidor->fila_inicio = pedido;
+  }
+  servidor->fila_fim = pedido;
+  pthread_cond_signal(&servidor->sinal);
+  pthread_mutex_unlock(&servidor->trava);
+
+  return 1;
+}
+
+static void receber(Conexao *conexao) {
+  const ssize_t lidos = read(conexao->descritor, conexao->recebido + conexao->lidos, sizeof conexao->recebido - conexao->lidos);
+
+  if (lidos > 0) {
+    conexao->lidos += lidos;
+  } else if (lidos == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+    conexao->terminou = 1;
+  }
+}
+
+static void liberar_pedido(Pedido *pedido) {
+  free(pedido->resposta);
+  free(pedido);
+}
+
+/**
+ * Envia as respostas prontas da conexão, na ordem dos pedidos, entrega os
+ * pedidos que já chegaram inteiros e fecha a conexão quando o cliente
+ * terminou e não falta responder nada. A escrita não bloqueia: o que não
+ * coube no socket espera o poll avisar que há espaço.
+ */
+static void avancar_conexao(Servidor *servidor, Conexao *conexao) {
+  while (conexao->primeiro && atomic_load(&conexao->primeiro->pronto)) {
+    Pedido *pedido = conexao->primeiro;
+
+    while (!conexao->falhou && conexao->enviados < pedido->tamanho_resposta) {
+      const char *resto      = pedido->resposta + conexao->enviados;
+      const ssize_t escritos = write(conexao->descritor, resto, pedido->tamanho_resposta - conexao->enviados);
+
+      if (escritos >= 0) {
+        conexao->enviados += escritos;
+      } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      } else if (errno != EINTR) {
+        // O cliente foi embora: o resto das respostas é descartado
+        conexao->falhou   = 1;
+        conexao->terminou = 1;
+      }
+    }
+
+    conexao->primeiro = pedido->proximo;
+    if (conexao->primeiro == NULL) {
+      conexao->ultimo = NULL;
+    }
+    conexao->pendentes--;
+    conexao->enviados = 0;
+    liberar_pedido(pedido);
+  }
+
+  while (!conexao->falhou && conexao->pendentes < PEDIDOS_POR_CONEXAO && despachar_pedido(servidor, conexao)) {
+  }
+
+  if (conexao->terminou && conexao->primeiro == NULL && (conexao->falhou || conexao->lidos == 0)) {
+    close(conexao->descritor);
+    conexao->descritor = -1;
+  }
+}
+
+/**
+ * Aceita uma conexão nova. Sem espaço livre, ela é recusada na hora, para o
+ * cliente não ficar esperando sem resposta.
+ */
+static void aceitar_conexao(Servidor *servidor, int ouvinte) {
+  const int descritor = accept(ouvinte, NULL, NULL);
+
+  if (descritor < 0) {
+    if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNABORTED) {
+      erro(L"Falha ao aceitar conexão.");
+    }
+    return;
+  }
+
+  for (int i = 0; i < MAXIMO_CONEXOES; ++i) {
+    if (servidor->conexoes[i].descritor < 0) {
+      servidor->conexoes[i] = (Conexao){ .descritor = descritor };
+      fcntl(descritor, F_SETFL, fcntl(descritor, F_GETFL) | O_NONBLOCK);
+      return;
+    }
+  }
+
+  const char resposta[] = "erro servidor ocupado\n";
+  if (write(descritor, resposta, sizeof resposta - 1) < 0) {
+    // O cliente já foi embora, não há a quem avisar
+  }
+  close(descritor);
+}
+
+static int abrir_socket(const char *caminho) {
+  struct sockaddr_un endereco = { 0 };
+
+  if (strlen(caminho) >= sizeof endereco.sun_path) {
+    erro(L"O caminho do socket é longo demais.");
+  }
+
+  endereco.sun_family = AF_UNIX;
+  strcpy(endereco.sun_path, caminho);
+
+  const int ouvinte = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (ouvinte < 0) {
+    erro(L"Falha ao criar o socket.");
+  }
+
+  // Um socket que sobrou de uma execução anterior impediria o bind
+  unlink(caminho);
+
+  if (bind(ouvinte, (struct sockaddr *)&endereco, sizeof endereco) < 0 || listen(ouvinte, SOMAXCONN) < 0) {
+    erro(L"Falha ao escutar no socket.");
+  }
+
+  return ouvinte;
+}
+
+void executar_servidor(const Opcoes *opcoes) {
+  if (opcoes->quantidade_arquivos == 0) {
+    erro(L"Informe ao menos um labirinto para o servidor.");
+  }
+
+  Servidor servidor   = { .opcoes = opcoes, .quantidade = opcoes->quantidade_arquivos };
+  servidor.labirintos = malloc(servidor.quantidade * sizeof(LabirintoPreparado));
+  servidor.conexoes   = calloc(MAXIMO_CONEXOES, sizeof(Conexao));
+  pthread_t *threads  = malloc(opcoes->threads * sizeof(pthread_t));
+
+  // O ouvinte, o aviso dos trabalhadores e as conexões
+  struct pollfd *eventos = malloc((MAXIMO_CONEXOES + 2) * sizeof(struct pollfd));
+
+  if (servidor.labirintos == NULL || servidor.conexoes == NULL || threads == NULL || eventos == NULL) {
+    erro(L"Falha ao alocar memória para o servidor.");
+  }
+
+  for (int i = 0; i < servidor.quantidade; ++i) {
+    preparar_labirinto(&servidor.labirintos[i], opcoes->arquivos[i]);
+  }
+  for (int i = 0; i < MAXIMO_CONEXOES; ++i) {
+    servidor.conexoes[i].descritor = -1;
+  }
+
+  // Sem SA_RESTART, para o poll retornar quando o sinal chegar
+  struct sigaction acao = { 0 };
+  acao.sa_handler       = pedir_parada;
+  sigemptyset(&acao.sa_mask);
+  sigaction(SIGINT, &acao, NULL);
+  sigaction(SIGTERM, &acao, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  const int ouvinte = abrir_socket(opcoes->servidor);
+
+  if (pipe(servidor.aviso) < 0) {
+    erro(L"Falha ao criar o aviso dos trabalhadores.");
+  }
+  for (int i = 0; i < 2; ++i) {
+    fcntl(servidor.aviso[i], F_SETFL, fcntl(servidor.aviso[i], F_GETFL) | O_NONBLOCK);
+  }
+  fcntl(ouvinte, F_SETFL, fcntl(ouvinte, F_GETFL) | O_NONBLOCK);
+
+  pthread_mutex_init(&servidor.trava, NULL);
+  pthread_cond_init(&servidor.sinal, NULL);
+  for (int i = 0; i < opcoes->threads; ++i) {
+    pthread_create(&threads[i], NULL, trabalhador, &servidor);
+  }
+
+  wprintf(L"Servidor escutando em %s com %d labirinto(s) e %d thread(s).\n", opcoes->servidor, servidor.quantidade, opcoes->threads);
+  fflush(stdout);
+
+  while (!parar_servidor) {
+    eventos[0] = (struct pollfd){ .fd = ouvinte, .events = POLLIN };
+    eventos[1] = (struct pollfd){ .fd = servidor.aviso[0], .events = POLLIN };
+
+    // Uma conexão só é lida enquanto tem espaço para mais pedidos, e só espera
+    // para escrever quando a resposta pronta não coube no socket. Fora isso ela
+    // fica de fora (-1), senão um cliente que desligou acordaria o poll sem parar
+    for (int i = 0; i < MAXIMO_CONEXOES; ++i) {
+      const Conexao *conexao = &servidor.conexoes[i];
+      short interesse        = 0;
+
+      if (conexao->descritor >= 0 && !conexao->terminou && conexao->pendentes < PEDIDOS_POR_CONEXAO) {
+        interesse |= POLLIN;
+      }
+      if (conexao->descritor >= 0 && conexao->primeiro && atomic_load(&conexao->primeiro->pronto)) {
+        interesse |= POLLOUT;
+      }
+
+      eventos[i + 2] = (struct pollfd){ .fd = interesse ? conexao->descritor : -1, .events = interesse };
+    }
+
+    if (poll(eventos, MAXIMO_CONEXOES + 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      erro(L"Falha ao esperar pelas conexões.");
+    }
+
+    char descarte[64];
+    while (read(servidor.aviso[0], descarte, sizeof descarte) > 0) {
+    }
+
+    for (int i = 0; i < MAXIMO_CONEXOES; ++i) {
+      Conexao *conexao = &servidor.conexoes[i];
+
+      if (conexao->descritor < 0) {
+        continue;
+      }
+      if (eventos[i + 2].revents & (POLLIN | POLLHUP | POLLERR)) {
+        receber(conexao);
+      }
+      avancar_conexao(&servidor, conexao);
+    }
+
+    if (eventos[0].revents & POLLIN) {
+      aceitar_conexao(&servidor, ouvinte);
+    }
+  }
+
+  close(ouvinte);
+  unlink(opcoes->servidor);
+
+  pthread_mutex_lock(&servidor.trava);
+  servidor.encerrando = 1;
+  pthread_cond_broadcast(&servidor.sinal);
+  pthread_mutex_unlock(&servidor.trava);
+
+  for (int i = 0; i < opcoes->threads; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+
+  // Pedidos que ainda não foram respondidos são só descartados
+  for (int i = 0; i < MAXIMO_CONEXOES; ++i) {
+    Conexao *conexao = &servidor.conexoes[i];
+
+    while (conexao->primeiro) {
+      Pedido *pedido    = conexao->primeiro;
+      conexao->primeiro = pedido->proximo;
+      liberar_pedido(pedido);
+    }
+    if (conexao->descritor >= 0) {
+      close(conexao->descritor);
+    }
+  }
+
+  for (int i = 0; i < servidor.quantidade; ++i) {
+    liberar_labirinto_preparado(&servidor.labirintos[i]);
+  }
+
+  close(servidor.aviso[0]);
+  close(servidor.aviso[1]);
+  pthread_cond_destroy(&servidor.sinal);
+  pthread_mutex_destroy(&servidor.trava);
+  free(servidor.labirintos);
+  free(servidor.conexoes);
+  free(threads);
+  free(eventos);
+}
+
+#endif
@@ -19,7 +19,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "include/cronologia.h"
+#include "include/estatisticas.h"
 #include "include/os.h"
+#include "include/rastro.h"
 #include "include/ui.h"
 #include "include/util.h"
 
@@ -41,16 +44,27 @@ void imprimir_titulo() {
 }
 
 void imprimir_labirinto(Labirinto *labirinto) {
+  TRECHO("imprimir_labirinto");
+  const Fase anterior = entrar_fase(FASE_DESENHO);
+  contar(quadros);
+  somar(celulas_desenhadas, linhas_na_tela(labirinto) * labirinto->tamanho[1]);
+
+  // Só o andar visível é desenhado, e ele começa logo depois da parede que o separa do anterior
+  const int primeira = labirinto->andares > 1 ? labirinto->andar_visivel * (labirinto->linhas_andar + 1) : 0;
+
+  gravar_quadro(labirinto->rastro);
   wprintf(ABAIXO_TITULO);
-  for (int i = 0; i < labirinto->tamanho[0]; i++)
+  for (int i = primeira; i < primeira + linhas_na_tela(labirinto); i++)
     for (int j = 0; j < labirinto->tamanho[1]; j++) {
       wchar_t caractere      = labirinto->matriz[i][j];
       wchar_t novo_caractere = mudar_caractere(labirinto, i, j);
       wchar_t lacuna         = preencher_lacuna(labirinto, i, j);
 
       colorir_caractere(caractere);
-      wprintf(L"%c%lc%lc" RESET, j % labirinto->tamanho[1] ? '\0' : '\n', novo_caractere, lacuna);
+      somar(caracteres_desenhados, wprintf(L"%c%lc%lc" RESET, j % labirinto->tamanho[1] ? '\0' : '\n', novo_caractere, lacuna));
     }
+
+  entrar_fase(anterior);
 }
 
 void imprimir_opcoes(Labirinto *labirinto) {
@@ -77,12 +91,19 @@ void imprimir_status(Labirinto *labirinto) {
   const int coluna              = labirinto->tamanho[1] * 2 + 5;
   const wchar_t *const status[] = { BLU L"\033[8;%dHTentativas: %d" RESET, BLU L"\033[9;%dHInimigos derrotados: %d" RESET };
 
-  wprintf(status[0], coluna, labirinto->jogador.tentativas);
-  wprintf(status[1], coluna, labirinto->jogador.inimigos_derrotados);
+  TRECHO("imprimir_status");
+  const Fase anterior = entrar_fase(FASE_DESENHO);
+  somar(caracteres_desenhados, wprintf(status[0], coluna, labirinto->jogador.tentativas));
+  somar(caracteres_desenhados, wprintf(status[1], coluna, labirinto->jogador.inimigos_derrotados));
+  if (labirinto->andares > 1) {
+    somar(caracteres_desenhados, wprintf(BLU L"\033[10;%dHAndar: %d de %d" RESET, coluna, labirinto->andar_visivel + 1, labirinto->andares));
+  }
   mover_cursor(11, labirinto->tamanho[1] * 2 + 5);
+  entrar_fase(anterior);
 }
 
 void atualizar_interface(Labirinto *labirinto) {
+  TRECHO("atualizar_interface");
   imprimir_labirinto(labirinto);
   imprimir_status(labirinto);
   fflush(stdout);
@@ -153,8 +174,10 @@ void imprimir_tela(Labirinto *labirinto) {
 
   imprimir_titulo();
   labirinto->menu = 1;
+  entrar_fase(FASE_CARGA);
   ler_arquivo(labirinto);
   preencher_matriz(labirinto);
+  entrar_fase(FASE_NENHUMA);
   configurar_terminal();
   imprimir_labirinto(labirinto);
   wprintf(L"\n\n\033[s");
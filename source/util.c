@@ -19,6 +19,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "include/cronologia.h"
+#include "include/estatisticas.h"
 #include "include/os.h"
 #include "include/util.h"
 #include <locale.h>
@@ -42,10 +44,14 @@ wchar_t mapa_binario_trilha[16] = {
   L'\x2502', L'\x2514', L'\x2518', L'\x2534', L'\x2502', L'\x251C', L'\x2524', L'\x253C',
 };
 
-wchar_t mapa_caracteres_estaticos[] = { CAMINHO_LIVRE, L'\x22C5', '/', L'\x22C5', '{', L'\x22C5', SAIDA, L'\x2691', 0, 0 };
+wchar_t mapa_caracteres_estaticos[] = { CAMINHO_LIVRE, L'\x22C5', '/', L'\x22C5', '{', L'\x22C5', SAIDA, L'\x2691', ESCADA, L'\x2261', 0, 0 };
 
 Mapa_Cores mapa_cores[] = { { PAREDE, L"\e[0;94m" }, { TRILHA, L"\e[0;32m" },  { INIMIGO, L"\e[38;5;196m" },
-                            { '}', L"\e[0;31m" },    { JOGADOR, L"\e[0;33m" }, { 0, 0 } };
+                            { '}', L"\e[0;31m" },    { JOGADOR, L"\e[0;33m" }, { ESCADA, L"\e[0;35m" },
+                            { 0, 0 } };
+
+const int deslocamento_linha[4]  = { -1, 1, 0, 0 };
+const int deslocamento_coluna[4] = { 0, 0, -1, 1 };
 
 void erro(const wchar_t *mensagem) {
   wprintf(RED L"\n[ERRO]: %ls\n\n" COLOR_RESET, mensagem);
@@ -53,15 +59,13 @@ void erro(const wchar_t *mensagem) {
 }
 
 int *nova_posicao(int linha, int coluna, Direcoes direcao) {
-  const int dx[] = { -1, 1, 0, 0 };
-  const int dy[] = { 0, 0, -1, 1 };
-
   int *pos = malloc(2 * sizeof(int));
+  contar(alocacoes);
   if (pos == NULL) {
     erro(L"Erro ao alocar memória");
   }
 
-  int temp[2] = { linha + dx[direcao], coluna + dy[direcao] };
+  int temp[2] = { linha + deslocamento_linha[direcao], coluna + deslocamento_coluna[direcao] };
   copiar_matriz(temp, pos, sizeof(int[2]));
   return pos;
 }
@@ -76,7 +80,7 @@ void limpar_tela() {
 
 void limpar_lateral(Labirinto *labirinto) {
   const int coluna = labirinto->tamanho[1] * 2 + 5;
-  for (int i = 6; i <= max(labirinto->tamanho[0], 15); ++i) {
+  for (int i = 6; i <= max(linhas_na_tela(labirinto), 15); ++i) {
     wprintf(L"\033[%d;%dH", i, coluna);
     limpar_cursor();
   }
@@ -85,7 +89,7 @@ void limpar_lateral(Labirinto *labirinto) {
 
 void mensagem(Labirinto *labirinto, wchar_t *mensagem) {
   const int coluna = labirinto->tamanho[1] * 2 + 5;
-  mover_cursor(max(14, labirinto->tamanho[0]), coluna);
+  mover_cursor(max(14, linhas_na_tela(labirinto)), coluna);
   wprintf(CLEAN_LINE);
   wprintf(HWHT L"%ls", mensagem);
   fflush(stdout);
@@ -98,6 +102,15 @@ int dist_manhattan(int ponto_atual[2], int destino[2]) {
 int gerar_index_binaria(Labirinto *labirinto, char *caracteres, int linha, int coluna) {
   int index         = 0;
   char *adjacencias = encontrar_adjacencias(labirinto->matriz, labirinto->tamanho, linha, coluna);
+
+  // A parede entre dois andares não aparece, então não liga com as do andar
+  if (labirinto->andares > 1 && linha % (labirinto->linhas_andar + 1) == 0) {
+    adjacencias[ACIMA] = 0;
+  }
+  if (labirinto->andares > 1 && linha % (labirinto->linhas_andar + 1) == labirinto->linhas_andar - 1) {
+    adjacencias[ABAIXO] = 0;
+  }
+
   for (int i = 0; i < 4; ++i) {
     index |= (adjacencias[i] && strchr(caracteres, adjacencias[i])) << (3 - i);
   }
@@ -161,11 +174,14 @@ wchar_t mudar_caractere(Labirinto *labirinto, int linha, int coluna) {
 }
 
 void pausar(float segundos) {
+  TRECHO("pausar");
+  const Fase anterior = entrar_fase(FASE_ESPERA);
 #ifdef _WIN32
   Sleep(segundos * 1000);
 #else
   usleep(segundos * 1000 * 1000);
 #endif
+  entrar_fase(anterior);
 }
 
 void mover_cursor(int linha, int coluna) {